@@ -5,8 +5,37 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t raised;        // INTC0 edges.
+    uint32_t missed;        // Edges while nobody waited, served by the next wait.
+    uint32_t coalesced;     // Edges served by the wakeup of an earlier edge.
+
+    // From the edge to the data read, see ad5940_intc0_lock_served.
+    uint32_t latency_count;
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+} AD5940_INTC0_LOCK_STATISTICS;
+
+/**
+ * @brief Waits until INTC0 is raised, returns at once if it was raised since the last wait.
+ * 
+ * Edges are counted, several edges before a wait wake it up once.
+ */
 int ad5940_intc0_lock_wait(void);
 
+/**
+ * @brief Marks the interrupts raised so far as served, their data is read.
+ * 
+ * The time since the first edge not served yet is added to the latency statistics.
+ */
+int ad5940_intc0_lock_served(void);
+
+int ad5940_intc0_lock_get_statistics(AD5940_INTC0_LOCK_STATISTICS *const statistics);
+
 #ifdef __cplusplus
 }
 #endif
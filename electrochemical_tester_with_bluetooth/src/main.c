@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <stdatomic.h>
+#include <math.h>
 #include <soc.h>
 
 #include <zephyr/device.h>
@@ -59,6 +60,29 @@ static float ad5940_lfoscFrequency;
 // Our circuit use it.
 #define MAIN_AD5940_HSTIARTIA HSTIARTIA_10K
 
+// On-chip averaging of every electrochemical data point, see CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES.
+#if CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 0
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_128
+#elif CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 8
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_8
+#elif CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 16
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_16
+#elif CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 32
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_32
+#elif CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 64
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_64
+#elif CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES == 128
+#define MAIN_AD5940_STATSAMPLE STATSAMPLE_128
+#else
+#error "CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES must be 0, 8, 16, 32, 64 or 128"
+#endif
+#define MAIN_AD5940_STATENABLE ((CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES > 0) ? bTRUE : bFALSE)
+
+// The statistics block would average the interleaved temperature into the ADC data.
+#if (CONFIG_AD5940_ELECTROCHEMICAL_TEMPERATURE_INTERVAL > 0) && (CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES > 0)
+#error "CONFIG_AD5940_ELECTROCHEMICAL_TEMPERATURE_INTERVAL must be 0 with CONFIG_AD5940_ELECTROCHEMICAL_STATISTICS_SAMPLES"
+#endif
+
 static AD5940_ELECTROCHEMICAL_CALIBRATION_PARAMETERS ad5940_electrochemical_calibration_parameters = {
 	.HstiaRtiaSel = MAIN_AD5940_HSTIARTIA,
 
@@ -117,9 +141,16 @@ int AD5940_TASK_ADC_wait_ad5940_intc_triggered(void)
 	return ad5940_intc0_lock_wait();
 }
 
+static void AD5940_TASK_ADC_end(void)
+{
+	ad5940_intc0_lock_served();
+	AD5940_TASK_ADC_add_heartbeat();
+	return;
+}
+
 static AD5940_TASK_ADC_CFG ad5940_task_adc_cfg = {
 	.callback = {
-		.end = AD5940_TASK_ADC_add_heartbeat,
+		.end = AD5940_TASK_ADC_end,
 		.start = AD5940_TASK_ADC_add_heartbeat,
 	},
 };
@@ -142,10 +173,25 @@ uint8_t AD5940_TASK_COMMAND_read_heartbeat(void)
     return atomic_load(&AD5940_TASK_COMMAND_heartbeat_count);
 }
 
+static void AD5940_TASK_COMMAND_measured(
+	uint32_t id,
+	AD5940_TASK_COMMAND_MEASUREMENT_STATUS status
+)
+{
+	static const char *const status_names[] = {
+		[AD5940_TASK_COMMAND_MEASUREMENT_STATUS_DONE] = "done",
+		[AD5940_TASK_COMMAND_MEASUREMENT_STATUS_CANCELED] = "canceled",
+		[AD5940_TASK_COMMAND_MEASUREMENT_STATUS_ERROR] = "failed",
+	};
+	LOG_DBG("Measurement %u %s", id, status_names[status]);
+	return;
+}
+
 AD5940_TASK_COMMAND_CFG ad5940_task_command_cfg = {
 	.callback = {
 		.end = AD5940_TASK_COMMAND_add_heartbeat,
 		.start = AD5940_TASK_COMMAND_add_heartbeat,
+		.measured = AD5940_TASK_COMMAND_measured,
 	},
 	.param = {
 		.common = {
@@ -174,8 +220,16 @@ AD5940_TASK_COMMAND_CFG ad5940_task_command_cfg = {
 			.LpTiaRf = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpTiaRf,
 			.LpTiaRload = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpTiaRload,
 
+			.StatEnable = MAIN_AD5940_STATENABLE,
+			.StatSample = MAIN_AD5940_STATSAMPLE,
+			.StatDev = STATDEV_25,
+
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+			.temperature_interval = CONFIG_AD5940_ELECTROCHEMICAL_TEMPERATURE_INTERVAL,
+#endif
+
 			.DataType = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DataType,
-			.FifoSrc = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_FifoSrc,
+			.FifoSrc = (MAIN_AD5940_STATENABLE == bTRUE) ? FIFOSRC_MEAN : UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_FifoSrc,
 		},
 		// UTL parameters
 		// You need to set the following parameters:
@@ -215,7 +269,6 @@ uint8_t COMMAND_RECEIVER_read_heartbeat(void)
     return atomic_load(&COMMAND_RECEIVER_heartbeat_count);
 }
 
-static atomic_uint_fast32_t entity_id = 0;
 int COMMAND_RECEIVER_wait_command_received(
     COMMAND_RECEIVER_START *const start
 ) 
@@ -240,19 +293,26 @@ int COMMAND_RECEIVER_wait_command_received(
 	{
 	case COMMAND_RECEIVER_START_TYPE_STOP:
 		break;
+	case COMMAND_RECEIVER_START_TYPE_CANCEL:
+		memcpy(&start->param.cancel.id, ble_packet_buffer + 2, sizeof(start->param.cancel.id));
+		break;
 	case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CA:
 	case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CV:
 	case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_DPV:
+	case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_SWV:
+	case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_LSV:
 		uint8_t *p0 = ble_packet_buffer + 2;
 		uint8_t *p1 = p0;
-		atomic_store(&entity_id, *((uint32_t *) p1));
-		p1 += sizeof(entity_id);
+		memcpy(&start->param.electrochemical.id, p1, sizeof(start->param.electrochemical.id));
+		p1 += sizeof(start->param.electrochemical.id);
 		memcpy(&start->param.electrochemical.parameters, p1, sizeof(start->param.electrochemical.parameters));
 		p1 += sizeof(start->param.electrochemical.parameters);
 		memcpy(&start->param.electrochemical.routing, p1, sizeof(start->param.electrochemical.routing));
 		p1 += sizeof(start->param.electrochemical.routing);
 		break;
 	default:
+		// Answered with an error, the ID tells the client which command.
+		memcpy(&start->param.electrochemical.id, ble_packet_buffer + 2, sizeof(start->param.electrochemical.id));
 		break;
 	}
 	return err;
@@ -294,66 +354,333 @@ uint8_t AD5940_ADC_SENDER_read_heartbeat(void)
     return atomic_load(&AD5940_ADC_SENDER_heartbeat_count);
 }
 
+#define AD5940_ADC_SENDER_CODE_MID 0x8000
+#define AD5940_ADC_SENDER_CODE_STEP 0x4000
+
+#ifdef CONFIG_AD5940_LIBRARY_FIXED_POINT_CONVERSION
+#include "ad5940_utility_adc.h"
+
+/**
+ * Scale of the batched library conversion, AD5940_UTILITY_convert_ADCs_fixed.
+ * It converts to nanoamperes and microdegrees Celsius, value = library value * unit
+ * in the unit of the float conversion the client takes.
+ */
+typedef struct
+{
+	AD5940_UTILITY_ADC_FIXED_SCALE fixed;
+	float unit;
+} AD5940_ADC_SENDER_FIXED_SCALE;
+
+// The library values are proportional to those of the float conversion, the unit is the ratio of their slopes.
+static void AD5940_ADC_SENDER_set_unit(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const float value_low,
+	const float value_high
+)
+{
+	const uint32_t codes[2] = {
+		AD5940_ADC_SENDER_CODE_MID - AD5940_ADC_SENDER_CODE_STEP,
+		AD5940_ADC_SENDER_CODE_MID + AD5940_ADC_SENDER_CODE_STEP,
+	};
+	int32_t values[2];
+	AD5940_UTILITY_convert_ADCs_fixed(values, codes, 2, &fixed_scale->fixed);
+	// Both values may be near the int32 limits, their difference is taken in float.
+	const float difference = (float) values[1] - (float) values[0];
+	fixed_scale->unit = (difference != 0) ? (value_high - value_low) / difference : 0;
+	if(!isfinite(fixed_scale->unit))
+	{
+		LOG_WRN("ADC conversion is not finite, samples are sent as 0");
+		fixed_scale->unit = 0;
+	}
+	return;
+}
+
+static void AD5940_ADC_SENDER_get_current_fixed_scale(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale
+)
+{
+	float values[2];
+	*fixed_scale = (AD5940_ADC_SENDER_FIXED_SCALE) {0};
+	if(AD5940_UTILITY_get_current_fixed_scale(
+		&fixed_scale->fixed,
+		&ad5940_task_command_cfg.param.electrochemical.hsrtia_calibration_result,
+		UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga,
+		UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCRefVolt
+	) != AD5940ERR_OK)
+	{
+		LOG_WRN("No current scale, samples are sent as 0");
+		return;
+	}
+	for(int i=0; i<2; i++)
+	{
+		AD5940_convert_adc_to_current(
+			AD5940_ADC_SENDER_CODE_MID + (2 * i - 1) * AD5940_ADC_SENDER_CODE_STEP,
+			&ad5940_task_command_cfg.param.electrochemical.hsrtia_calibration_result,
+			UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga,
+			UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCRefVolt,
+			&values[i]
+		);
+	}
+	AD5940_ADC_SENDER_set_unit(fixed_scale, values[0], values[1]);
+	return;
+}
+
+static void AD5940_ADC_SENDER_get_temperature_fixed_scale(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const uint32_t ADCPga
+)
+{
+	float values[2];
+	*fixed_scale = (AD5940_ADC_SENDER_FIXED_SCALE) {0};
+	if(AD5940_UTILITY_get_temperature_fixed_scale(&fixed_scale->fixed, ADCPga) != AD5940ERR_OK)
+	{
+		LOG_WRN("No temperature scale, samples are sent as 0");
+		return;
+	}
+	for(int i=0; i<2; i++)
+	{
+		AD5940_convert_adc_to_temperature(
+			AD5940_ADC_SENDER_CODE_MID + (2 * i - 1) * AD5940_ADC_SENDER_CODE_STEP,
+			ADCPga,
+			&values[i]
+		);
+	}
+	AD5940_ADC_SENDER_set_unit(fixed_scale, values[0], values[1]);
+	return;
+}
+
+// The batch of the sample is converted by AD5940_UTILITY_convert_ADCs_fixed already.
+static inline float AD5940_ADC_SENDER_convert(
+	const AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const uint32_t fifo_data
+)
+{
+	return (float) (int32_t) fifo_data * fixed_scale->unit;
+}
+#else
+/**
+ * Fixed-point line of a float ADC conversion, value = (code * scale + offset) * unit,
+ * with the 16-bit code centered at mid scale. Both terms stay below 2^30 so the sum fits in 32 bits.
+ */
+typedef struct
+{
+	int32_t scale;
+	int32_t offset;
+	float unit;		// 2^-shift
+} AD5940_ADC_SENDER_FIXED_SCALE;
+
+// Both conversions are linear in the code, the line is taken from the conversion itself.
+static void AD5940_ADC_SENDER_set_fixed_scale(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const float value_low,
+	const float value_mid,
+	const float value_high
+)
+{
+	const double slope = ((double) value_high - (double) value_low) / (2 * AD5940_ADC_SENDER_CODE_STEP);
+	const double offset = value_mid;
+	const double max = fmax(fabs(slope) * AD5940_ADC_SENDER_CODE_MID, fabs(offset));
+	*fixed_scale = (AD5940_ADC_SENDER_FIXED_SCALE) {0};
+	if(!isfinite(max))
+	{
+		LOG_WRN("ADC conversion is not finite, samples are sent as 0");
+		return;
+	}
+	int shift = 0;
+	while((shift < 30) && (max * ldexp(1, shift + 1) < (double) (1L << 30))) shift++;
+	fixed_scale->scale = (int32_t) lround(ldexp(slope, shift));
+	fixed_scale->offset = (int32_t) lround(ldexp(offset, shift));
+	fixed_scale->unit = ldexpf(1, -shift);
+	return;
+}
+
+static void AD5940_ADC_SENDER_get_current_fixed_scale(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale
+)
+{
+	float values[3];
+	for(int i=0; i<3; i++)
+	{
+		AD5940_convert_adc_to_current(
+			AD5940_ADC_SENDER_CODE_MID + (i - 1) * AD5940_ADC_SENDER_CODE_STEP,
+			&ad5940_task_command_cfg.param.electrochemical.hsrtia_calibration_result,
+			UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga,
+			UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCRefVolt,
+			&values[i]
+		);
+	}
+	AD5940_ADC_SENDER_set_fixed_scale(fixed_scale, values[0], values[1], values[2]);
+	return;
+}
+
+static void AD5940_ADC_SENDER_get_temperature_fixed_scale(
+	AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const uint32_t ADCPga
+)
+{
+	float values[3];
+	for(int i=0; i<3; i++)
+	{
+		AD5940_convert_adc_to_temperature(
+			AD5940_ADC_SENDER_CODE_MID + (i - 1) * AD5940_ADC_SENDER_CODE_STEP,
+			ADCPga,
+			&values[i]
+		);
+	}
+	AD5940_ADC_SENDER_set_fixed_scale(fixed_scale, values[0], values[1], values[2]);
+	return;
+}
+
+static inline float AD5940_ADC_SENDER_convert(
+	const AD5940_ADC_SENDER_FIXED_SCALE *const fixed_scale,
+	const uint32_t fifo_data
+)
+{
+	const int32_t code = (int32_t) (fifo_data & 0xFFFF) - AD5940_ADC_SENDER_CODE_MID;
+	return (float) (code * fixed_scale->scale + fixed_scale->offset) * fixed_scale->unit;
+}
+#endif
+
 int AD5940_ADC_SENDER_run(void)
 {
 	int err;
 	AD5940_TASK_ADC_RESULT result;
-	#define AD5940_ADC_SENDER_LENGTH (1 + sizeof(entity_id) + 1 + sizeof(result.adc_data_index) + sizeof(result.fifo_buffer[0]))
+	#define AD5940_ADC_SENDER_LENGTH (1 + sizeof(result.id) + 1 + sizeof(result.adc_data_index) + sizeof(result.fifo_buffer[0]))
 	uint8_t ble_packet[AD5940_ADC_SENDER_LENGTH];
 	ble_packet[0] = 0x02;
+	AD5940_TASK_ADC_QUENE_STATISTICS statistics;
+	uint32_t dropped_samples = 0;
+
+	// The calibration and the PGA gains are fixed once the thread runs, so is the scale of every measurement.
+	AD5940_ADC_SENDER_FIXED_SCALE current_scale, temperature_scale, scan_temperature_scale;
+	AD5940_ADC_SENDER_get_current_fixed_scale(&current_scale);
+	AD5940_ADC_SENDER_get_temperature_fixed_scale(&temperature_scale, UTL_AD5940_TEMPERATURE_PARAMETERS_ADCPga);
+	AD5940_ADC_SENDER_get_temperature_fixed_scale(&scan_temperature_scale, UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga);
 	for(;;)
 	{
 		err = AD5940_TASK_ADC_take_result_quene(
 			&result
 		);
-		if(!BLE_SIMPLE_is_connected()) continue;
-
-		uint8_t *p = ble_packet + 1;
-
-		uint_fast32_t id = atomic_load(&entity_id);
-		memcpy(p, &id, sizeof(id));
-		p += sizeof(id);
-
-		uint8_t flag = (uint8_t) result.flag;
-		memcpy(p, &flag, sizeof(flag));
-		p += sizeof(flag);
-
-		memcpy(p, &result.adc_data_index, sizeof(result.adc_data_index));
-		p += sizeof(result.adc_data_index);
-
+		uint16_t count = BLE_SIMPLE_is_connected() ? result.fifo_count : 0;
+		uint16_t first_index = result.adc_data_index;
+#ifdef CONFIG_AD5940_LIBRARY_FIXED_POINT_CONVERSION
+		// The whole batch in place with one library call, a packet only scales its value to the sent unit.
+		const AD5940_ADC_SENDER_FIXED_SCALE *batch_scale = NULL;
 		switch (result.flag)
 		{
 		case AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE:
+			batch_scale = &temperature_scale;
+			break;
+		case AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE:
+			batch_scale = &scan_temperature_scale;
+			break;
+		case AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT:
+			batch_scale = &current_scale;
+			break;
+		default:
+			break;
+		}
+		if(batch_scale != NULL)
 		{
-			AD5940_convert_adc_to_temperature(
-				result.fifo_buffer[0],
-				UTL_AD5940_TEMPERATURE_PARAMETERS_ADCPga,
-				(float*) p
+			AD5940_UTILITY_convert_ADCs_fixed(
+				(int32_t *) result.fifo_buffer,
+				result.fifo_buffer,
+				count,
+				&batch_scale->fixed
 			);
-			p += sizeof(int32_t);
-			break;
 		}
-		case AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT:
+#endif
+#ifdef AD5940_TASK_SWV_LSV
+		if(result.flag == AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT_DIFFERENCE && count > 0)
 		{
-			AD5940_convert_adc_to_current(
-				result.fifo_buffer[0],
+			// In place, one forward minus reverse current per period, the batch starts with a forward pulse.
+			if(AD5940_ELECTROCHEMICAL_SWV_convert_ADCs_to_currents(
+				(int32_t *) result.fifo_buffer,
+				&count,
+				result.fifo_count,
+				result.fifo_buffer,
+				result.fifo_count,
 				&ad5940_task_command_cfg.param.electrochemical.hsrtia_calibration_result,
 				UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga,
-				UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCRefVolt,
-				(float*) p
-			);
-			p += sizeof(int32_t);
-			break;
+				UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCRefVolt
+			) != AD5940ERR_OK) count = 0;
+			first_index = result.adc_data_index / 2;
 		}
-		default:
-			break;
+#endif
+
+		// One packet per sample of the batch.
+		for(uint16_t i=0; i<count; i++)
+		{
+			uint8_t *p = ble_packet + 1;
+
+			memcpy(p, &result.id, sizeof(result.id));
+			p += sizeof(result.id);
+
+			// The client takes the temperatures of a measurement like those of a temperature measurement.
+			uint8_t flag = (uint8_t) result.flag;
+			if(result.flag == AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE) flag = AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE;
+			memcpy(p, &flag, sizeof(flag));
+			p += sizeof(flag);
+
+			const uint16_t adc_data_index = first_index + i;
+			memcpy(p, &adc_data_index, sizeof(adc_data_index));
+			p += sizeof(adc_data_index);
+
+			switch (result.flag)
+			{
+			case AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE:
+			{
+				const float temperature = AD5940_ADC_SENDER_convert(&temperature_scale, result.fifo_buffer[i]);
+				memcpy(p, &temperature, sizeof(temperature));
+				p += sizeof(int32_t);
+				break;
+			}
+			case AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE:
+			{
+				const float temperature = AD5940_ADC_SENDER_convert(&scan_temperature_scale, result.fifo_buffer[i]);
+				memcpy(p, &temperature, sizeof(temperature));
+				p += sizeof(int32_t);
+				break;
+			}
+			case AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT:
+			{
+				const float current = AD5940_ADC_SENDER_convert(&current_scale, result.fifo_buffer[i]);
+				memcpy(p, &current, sizeof(current));
+				p += sizeof(int32_t);
+				break;
+			}
+#ifdef AD5940_TASK_SWV_LSV
+			case AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT_DIFFERENCE:
+			{
+				const float current = AD5940_ADC_SENDER_convert(&current_scale, result.fifo_buffer[i]);
+				memcpy(p, &current, sizeof(current));
+				p += sizeof(int32_t);
+				break;
+			}
+#endif
+			default:
+				break;
+			}
+
+			err = BLE_SIMPLE_send_packet(
+				ble_packet,
+				AD5940_ADC_SENDER_LENGTH
+			);
+			// if(err) return err;
 		}
 
-		err = BLE_SIMPLE_send_packet(
-			ble_packet,
-			AD5940_ADC_SENDER_LENGTH
+		// The samples are read in place from the ring, the ADC task can reuse their room now.
+		err = AD5940_TASK_ADC_release_result_quene(
+			&result
 		);
-		// if(err) return err;
+
+		AD5940_TASK_ADC_get_result_quene_statistics(&statistics);
+		if(statistics.dropped_samples != dropped_samples)
+		{
+			LOG_WRN("ADC ring full, %u samples dropped in %u batches",
+				statistics.dropped_samples, statistics.dropped_batches);
+			dropped_samples = statistics.dropped_samples;
+		}
 	}
 }
 
@@ -397,7 +724,10 @@ int main(void)
 		err = ad5940_intc0_lock_init_impl_zephyr();
 		if (err) return err;
 
-		err = AD5940_intc0_impl_zephyr_init(ad5940_intc0_lock_boardcast_impl_zephyr);
+		err = AD5940_intc0_impl_zephyr_init(
+			ad5940_intc0_lock_boardcast_impl_zephyr,
+			ad5940_intc0_lock_edge_impl_zephyr
+		);
 		if (err) return err;
 		err = AD5940_intc1_impl_zephyr_init();
 		if (err) return err;
@@ -412,6 +742,10 @@ int main(void)
 			2
 		);
 		if (err) return err;
+
+		err = AD5940_spi_impl_zephyr_select_frequency();
+		if (err) LOG_WRN("AD5940 SPI frequency is not raised: %d", err);
+		LOG_INF("AD5940 SPI frequency: %u Hz", AD5940_spi_impl_zephyr_get_frequency());
 	
 		// ==================================================
 		// AD5940 initialize parameters
@@ -575,8 +909,28 @@ int main(void)
 		.last_heartbeat = 0,
 		.error_count_allow_max = 3,
 	};
+	AD5940_INTC0_LOCK_STATISTICS intc0_statistics;
+	uint32_t intc0_raised = 0;
 	for(;;)
 	{
+		// ==================================================
+		// AD5940 INTC0
+		ad5940_intc0_lock_get_statistics(&intc0_statistics);
+		if(intc0_statistics.raised != intc0_raised)
+		{
+			LOG_DBG("AD5940 INTC0: %u raised, %u while busy, %u coalesced",
+				intc0_statistics.raised, intc0_statistics.missed, intc0_statistics.coalesced);
+			if(intc0_statistics.latency_count > 0)
+			{
+				LOG_DBG("AD5940 INTC0 %s latency: min %u us, avg %u us, max %u us",
+					IS_ENABLED(CONFIG_AD5940_INTC0_DEBOUNCE) ? "debounced" : "ISR",
+					intc0_statistics.latency_min_us,
+					(uint32_t) (intc0_statistics.latency_total_us / intc0_statistics.latency_count),
+					intc0_statistics.latency_max_us);
+			}
+			intc0_raised = intc0_statistics.raised;
+		}
+
 		// ==================================================
 		// AD5940 task
 		// ADC
@@ -1,33 +1,93 @@
 #include "ad5940_intc0_lock_impl_zephyr.h"
 #include "ad5940_intc0_lock.h"
 
+#include <stdint.h>
+
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+/**
+ * Pending edges are counted, the semaphore only wakes the waiter up,
+ * so an edge raised while the ADC task is busy isn't lost.
+ */
+static K_SEM_DEFINE(_sem, 0, 1);
+static atomic_t _pending;
+static atomic_t _waiting;
+
+static atomic_t _raised;
+static atomic_t _missed;
+static atomic_t _coalesced;
 
-static K_MUTEX_DEFINE(_mutex);
-static K_CONDVAR_DEFINE(_condvar);
+// Cycles of the first edge not served yet, valid while _edge_pending is set.
+static atomic_t _edge_pending;
+static uint32_t _edge_cycles;
+
+// Only written by the served thread.
+static uint32_t _latency_count;
+static uint32_t _latency_min_us = UINT32_MAX;
+static uint32_t _latency_max_us;
+static uint64_t _latency_total_us;
 
 int ad5940_intc0_lock_init_impl_zephyr(void)
 {
-    int err = 0;
-    err = k_mutex_init(&_mutex);
-    if(err) return err;
-    err = k_condvar_init(&_condvar);
-    if(err) return err;
-    return 0;
+    atomic_clear(&_pending);
+    atomic_clear(&_waiting);
+    return k_sem_init(&_sem, 0, 1);
 }
 
 int ad5940_intc0_lock_boardcast_impl_zephyr(void)
 {
-    k_mutex_lock(&_mutex, K_FOREVER);
-    k_condvar_broadcast(&_condvar);
-    k_mutex_unlock(&_mutex);
+    atomic_inc(&_raised);
+    if(!atomic_get(&_waiting)) atomic_inc(&_missed);
+    atomic_inc(&_pending);
+    k_sem_give(&_sem);
     return 0;
 }
 
 int ad5940_intc0_lock_wait(void)
 {
-    k_mutex_lock(&_mutex, K_FOREVER);
-    k_condvar_wait(&_condvar, &_mutex, K_FOREVER);
-    k_mutex_unlock(&_mutex);
+    atomic_set(&_waiting, 1);
+    k_sem_take(&_sem, K_FOREVER);
+    atomic_set(&_waiting, 0);
+
+    // 0 if the edges were already taken by the previous wait, its semaphore was given after.
+    const atomic_val_t pending = atomic_clear(&_pending);
+    if(pending > 1) atomic_add(&_coalesced, pending - 1);
+    return 0;
+}
+
+void ad5940_intc0_lock_edge_impl_zephyr(void)
+{
+    // Only called from the GPIO ISR, nothing else sets _edge_pending.
+    if(atomic_get(&_edge_pending)) return;
+    _edge_cycles = k_cycle_get_32();
+    atomic_set(&_edge_pending, 1);
+    return;
+}
+
+int ad5940_intc0_lock_served(void)
+{
+    if(!atomic_get(&_edge_pending)) return 0;
+
+    const uint32_t latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - _edge_cycles);
+    atomic_clear(&_edge_pending);
+
+    _latency_count++;
+    if(latency_us < _latency_min_us) _latency_min_us = latency_us;
+    if(latency_us > _latency_max_us) _latency_max_us = latency_us;
+    _latency_total_us += latency_us;
+    return 0;
+}
+
+int ad5940_intc0_lock_get_statistics(AD5940_INTC0_LOCK_STATISTICS *const statistics)
+{
+    statistics->raised = atomic_get(&_raised);
+    statistics->missed = atomic_get(&_missed);
+    statistics->coalesced = atomic_get(&_coalesced);
+
+    statistics->latency_count = _latency_count;
+    statistics->latency_min_us = (_latency_count > 0) ? _latency_min_us : 0;
+    statistics->latency_max_us = _latency_max_us;
+    statistics->latency_total_us = _latency_total_us;
     return 0;
 }
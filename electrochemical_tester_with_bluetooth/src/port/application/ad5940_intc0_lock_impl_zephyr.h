@@ -9,6 +9,9 @@ int ad5940_intc0_lock_init_impl_zephyr(void);
 
 int ad5940_intc0_lock_boardcast_impl_zephyr(void);
 
+// Stamps the edge from the GPIO ISR, the start of the latency.
+void ad5940_intc0_lock_edge_impl_zephyr(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,465 @@
+#include "ad5940.h"
+#include "ad5940_port_emulator_impl_zephyr.h"
+#include "ad5940_port_intc0_impl_zephyr.h"
+#include "ad5940_port_reset_impl_zephyr.h"
+#include "ad5940_port_spi_impl_zephyr.h"
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(ad5940_emulator, LOG_LEVEL_INF);
+
+/**
+ * Behavioral model of the AD5940 behind the SPI, reset and INTC0 port hooks.
+ *
+ * It only models what the firmware relies on:
+ * - Register file with ADIID/CHIPID, INTC flags and FIFO count.
+ * - Data FIFO with threshold interrupt routed to INTC0.
+ * - Sequencer SRAM, SEQxINFO, SEQ_WR/SEQ_WAIT commands, the custom interrupts
+ *   of SEQ_INT0 to SEQ_INT3 and the wakeup timer order.
+ * - Synthetic ADC samples following LPDACDAT0 for electrochemical sequences
+ *   and a fixed 25 degree Celsius reading for temperature sequences.
+ */
+
+#define EMULATOR_REGISTER_NUMBER 192
+#define EMULATOR_SRAM_SIZE 2048
+#define EMULATOR_FIFO_SIZE 1024
+#define EMULATOR_SEQUENCE_MAX_STEPS 4096
+#define EMULATOR_LFOSC_FREQUENCY 32000
+
+#define EMULATOR_CHIPID 0x5502
+
+typedef enum
+{
+    _SPI_STATE_COMMAND,
+    _SPI_STATE_SETADDR,
+    _SPI_STATE_WRITEREG,
+    _SPI_STATE_READREG,
+    _SPI_STATE_READFIFO,
+    _SPI_STATE_IGNORE,
+}
+_SPI_STATE;
+
+static struct
+{
+    struct
+    {
+        uint16_t address;
+        uint32_t value;
+    }
+    registers[EMULATOR_REGISTER_NUMBER];
+    uint16_t registers_length;
+
+    uint32_t sram[EMULATOR_SRAM_SIZE];
+    uint32_t sram_write_address;
+
+    uint32_t fifo[EMULATOR_FIFO_SIZE];
+    uint16_t fifo_head;
+    uint16_t fifo_count;
+
+    uint8_t wupt_slot;
+    uint32_t noise_seed;
+
+    struct
+    {
+        _SPI_STATE state;
+        uint16_t address;
+        uint32_t index;
+        uint32_t data;
+    }
+    spi;
+}
+_emulator;
+
+static K_MUTEX_DEFINE(_emulator_lock);
+
+static void (*_intc0_callback)(void);
+static void (*_intc0_edge_callback)(void);
+
+static void _wupt_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(_wupt_work, _wupt_work_handler);
+
+static bool _is_32bit_register(const uint16_t address)
+{
+    return (address >= 0x1000) && (address <= 0x3014);
+}
+
+static uint32_t *_find_register(const uint16_t address, const bool create)
+{
+    for(size_t i=0; i<_emulator.registers_length; i++)
+    {
+        if(_emulator.registers[i].address == address) return &_emulator.registers[i].value;
+    }
+    if(!create || _emulator.registers_length >= EMULATOR_REGISTER_NUMBER) return NULL;
+    _emulator.registers[_emulator.registers_length].address = address;
+    _emulator.registers[_emulator.registers_length].value = 0;
+    return &_emulator.registers[_emulator.registers_length++].value;
+}
+
+static uint32_t _get_register(const uint16_t address)
+{
+    uint32_t *value = _find_register(address, false);
+    return (value == NULL) ? 0 : *value;
+}
+
+static void _set_register(const uint16_t address, const uint32_t value)
+{
+    uint32_t *p = _find_register(address, true);
+    if(p != NULL) *p = value;
+}
+
+static void _reset(void)
+{
+    memset(&_emulator, 0, sizeof(_emulator));
+    _emulator.noise_seed = 1;
+    _set_register(REG_AFECON_ADIID, AD5940_ADIID);
+    _set_register(REG_AFECON_CHIPID, EMULATOR_CHIPID);
+    _set_register(REG_INTC_INTCSEL0, REG_INTC_INTCSEL0_RESET);
+    k_work_cancel_delayable(&_wupt_work);
+}
+
+/**
+ * @return true if INTC0 flag is raised by this call.
+ */
+static bool _raise_interrupt(const uint32_t AFEIntSrc)
+{
+    const uint32_t flag0 = _get_register(REG_INTC_INTCFLAG0);
+    const uint32_t new_flag0 = flag0 | (AFEIntSrc & _get_register(REG_INTC_INTCSEL0));
+    _set_register(REG_INTC_INTCFLAG0, new_flag0);
+    _set_register(REG_INTC_INTCFLAG1, _get_register(REG_INTC_INTCFLAG1) | (AFEIntSrc & _get_register(REG_INTC_INTCSEL1)));
+    return (flag0 == 0) && (new_flag0 != 0);
+}
+
+// Called with the emulator unlocked, like the GPIO7 edge of the AFE.
+static void _call_intc0_callbacks(void)
+{
+    if(_intc0_edge_callback != NULL) _intc0_edge_callback();
+    if(_intc0_callback != NULL) _intc0_callback();
+}
+
+static int32_t _get_noise(void)
+{
+    _emulator.noise_seed = _emulator.noise_seed * 1103515245 + 12345;
+    return ((int32_t) ((_emulator.noise_seed >> 16) & 0x0F)) - 8;
+}
+
+static bool _push_fifo(const uint32_t data)
+{
+    if(!(_get_register(REG_AFE_FIFOCON) & BITM_AFE_FIFOCON_DATAFIFOEN)) return false;
+    if(_emulator.fifo_count >= EMULATOR_FIFO_SIZE) return _raise_interrupt(AFEINTSRC_DATAFIFOOF);
+    _emulator.fifo[(_emulator.fifo_head + _emulator.fifo_count) % EMULATOR_FIFO_SIZE] = data;
+    _emulator.fifo_count++;
+    const uint32_t thresh = (_get_register(REG_AFE_DATAFIFOTHRES) >> BITP_AFE_DATAFIFOTHRES_HIGHTHRES) & 0x7FF;
+    if(_emulator.fifo_count >= thresh) return _raise_interrupt(AFEINTSRC_DATAFIFOTHRESH);
+    return false;
+}
+
+static uint32_t _pop_fifo(void)
+{
+    if(_emulator.fifo_count == 0) return 0;
+    const uint32_t data = _emulator.fifo[_emulator.fifo_head];
+    _emulator.fifo_head = (_emulator.fifo_head + 1) % EMULATOR_FIFO_SIZE;
+    _emulator.fifo_count--;
+    return data;
+}
+
+static bool _convert_adc(const uint8_t SeqId, const bool temperature)
+{
+    int32_t code;
+    if(temperature)
+    {
+        // 25 degree Celsius with PGA 1.5, refer to AD5940_convert_adc_to_temperature.
+        code = 0x8000 + (int32_t) ((25.0f + 273.15f) * 8.13f * 1.5f);
+    }
+    else
+    {
+        // Current follows the 12-bit LPDAC output, centered at mid scale.
+        code = 0x8000 + (((int32_t) (_get_register(REG_AFE_LPDACDAT0) & 0xFFF)) - 0x800) * 4;
+    }
+    code += _get_noise();
+    if(code < 0) code = 0;
+    if(code > 0xFFFF) code = 0xFFFF;
+    return _push_fifo(((uint32_t) SeqId << 23) | (uint32_t) code);
+}
+
+static bool _write_register(const uint16_t address, uint32_t value, const uint8_t SeqId);
+
+static bool _run_sequence(const uint8_t SeqId)
+{
+    static const uint16_t seqinfo[] = {REG_AFE_SEQ0INFO, REG_AFE_SEQ1INFO, REG_AFE_SEQ2INFO, REG_AFE_SEQ3INFO};
+    bool triggered = false;
+
+    if(!(_get_register(REG_AFE_SEQCON) & BITM_AFE_SEQCON_SEQEN)) return false;
+
+    const uint32_t info = _get_register(seqinfo[SeqId & 0x03]);
+    uint32_t address = (info & BITM_AFE_SEQ0INFO_ADDR) >> BITP_AFE_SEQ0INFO_ADDR;
+    uint32_t length = (info & BITM_AFE_SEQ0INFO_LEN) >> BITP_AFE_SEQ0INFO_LEN;
+    for(size_t step=0; (step<length) && (step<EMULATOR_SEQUENCE_MAX_STEPS); step++)
+    {
+        const uint32_t command = _emulator.sram[(address + step) % EMULATOR_SRAM_SIZE];
+        // SEQ_WAIT and SEQ_TOUT take no time here.
+        if(!(command & 0x80000000)) continue;
+        const uint16_t reg = 0x2000 | (((command >> 24) & 0x7F) << 2);
+        triggered |= _write_register(reg, command & 0xFFFFFF, SeqId);
+        if(!(_get_register(REG_AFE_SEQCON) & BITM_AFE_SEQCON_SEQEN)) break;
+        // SEQxINFO may be rewritten by the sequence itself, it takes effect on the next run.
+    }
+    return triggered;
+}
+
+/**
+ * @return true if INTC0 flag is raised by this write.
+ */
+static bool _write_register(const uint16_t address, uint32_t value, const uint8_t SeqId)
+{
+    if(!_is_32bit_register(address)) value &= 0xFFFF;
+    switch (address)
+    {
+    case REG_INTC_INTCCLR:
+        _set_register(REG_INTC_INTCFLAG0, _get_register(REG_INTC_INTCFLAG0) & ~value);
+        _set_register(REG_INTC_INTCFLAG1, _get_register(REG_INTC_INTCFLAG1) & ~value);
+        return false;
+    case REG_AFE_CMDFIFOWADDR:
+        _emulator.sram_write_address = value & BITM_AFE_CMDFIFOWADDR_WADDR;
+        return false;
+    case REG_AFE_CMDFIFOWRITE:
+        // Address increases after every write. This is an assumption, not verified on a real
+        // AD5940; the SEQ_CMDWRITE_BURST upload of AD5940_SEQCmdWrite depends on it.
+        _emulator.sram[_emulator.sram_write_address++ % EMULATOR_SRAM_SIZE] = value;
+        return false;
+    case REG_AFECON_SWRSTCON:
+        if(value == AD5940_SWRST) _reset();
+        return false;
+    case REG_AFECON_TRIGSEQ:
+        for(uint8_t i=0; i<4; i++)
+        {
+            if(value & (1L << i)) return _run_sequence(i);
+        }
+        return false;
+    case REG_AFE_SEQCON:
+        _set_register(address, value);
+        if(!(value & BITM_AFE_SEQCON_SEQEN) && (SeqId != 0xFF)) return _raise_interrupt(AFEINTSRC_ENDSEQ);
+        return false;
+    case REG_AFE_AFEGENINTSTA:
+        // Only the sequencer raises the custom interrupts, bit 0 to 3 are CUSTOMINT0 to CUSTOMINT3.
+        if(SeqId == 0xFF) return false;
+        return _raise_interrupt((value & 0x0F) * AFEINTSRC_CUSTOMINT0);
+    case REG_AFE_FIFOCON:
+        _set_register(address, value);
+        if(!(value & BITM_AFE_FIFOCON_DATAFIFOEN)) _emulator.fifo_count = 0;
+        return false;
+    case REG_WUPTMR_CON:
+        _set_register(address, value);
+        if(value & BITM_WUPTMR_CON_EN)
+        {
+            _emulator.wupt_slot = 0;
+            k_work_reschedule(&_wupt_work, K_NO_WAIT);
+        }
+        else
+        {
+            k_work_cancel_delayable(&_wupt_work);
+        }
+        return false;
+    case REG_AFE_AFECON:
+        _set_register(address, value);
+        if(value & (BITM_AFE_AFECON_ADCCONVEN | BITM_AFE_AFECON_TEMPCONVEN))
+        {
+            return _convert_adc(SeqId, (value & BITM_AFE_AFECON_TEMPCONVEN) != 0);
+        }
+        return false;
+    default:
+        _set_register(address, value);
+        return false;
+    }
+}
+
+static uint32_t _read_register(const uint16_t address)
+{
+    switch (address)
+    {
+    case REG_AFE_DATAFIFORD:
+        return _pop_fifo();
+    case REG_AFE_FIFOCNTSTA:
+        return (uint32_t) _emulator.fifo_count << BITP_AFE_FIFOCNTSTA_DATAFIFOCNTSTA;
+    default:
+        return _get_register(address);
+    }
+}
+
+static void _wupt_work_handler(struct k_work *work)
+{
+    static const uint16_t wakeup_low[] = {REG_WUPTMR_SEQ0WUPL, REG_WUPTMR_SEQ1WUPL, REG_WUPTMR_SEQ2WUPL, REG_WUPTMR_SEQ3WUPL};
+    static const uint16_t wakeup_high[] = {REG_WUPTMR_SEQ0WUPH, REG_WUPTMR_SEQ1WUPH, REG_WUPTMR_SEQ2WUPH, REG_WUPTMR_SEQ3WUPH};
+    static const uint16_t sleep_low[] = {REG_WUPTMR_SEQ0SLEEPL, REG_WUPTMR_SEQ1SLEEPL, REG_WUPTMR_SEQ2SLEEPL, REG_WUPTMR_SEQ3SLEEPL};
+    static const uint16_t sleep_high[] = {REG_WUPTMR_SEQ0SLEEPH, REG_WUPTMR_SEQ1SLEEPH, REG_WUPTMR_SEQ2SLEEPH, REG_WUPTMR_SEQ3SLEEPH};
+
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+
+    const uint32_t con = _get_register(REG_WUPTMR_CON);
+    if(!(con & BITM_WUPTMR_CON_EN))
+    {
+        k_mutex_unlock(&_emulator_lock);
+        return;
+    }
+    const uint8_t slot_number = ((con & BITM_WUPTMR_CON_ENDSEQ) >> BITP_WUPTMR_CON_ENDSEQ) + 1;
+    const uint8_t SeqId = (_get_register(REG_WUPTMR_SEQORDER) >> (2 * _emulator.wupt_slot)) & 0x03;
+    const bool triggered = _run_sequence(SeqId);
+    _emulator.wupt_slot = (_emulator.wupt_slot + 1) % slot_number;
+
+    const uint32_t clocks =
+        (_get_register(sleep_low[SeqId]) | (_get_register(sleep_high[SeqId]) << 16))
+        + (_get_register(wakeup_low[SeqId]) | (_get_register(wakeup_high[SeqId]) << 16))
+        + 2;
+    k_work_reschedule(&_wupt_work, K_USEC((uint64_t) clocks * 1000000 / EMULATOR_LFOSC_FREQUENCY));
+
+    k_mutex_unlock(&_emulator_lock);
+
+    if(triggered) _call_intc0_callbacks();
+}
+
+/**
+ * @return true if INTC0 flag is raised when the frame is completed.
+ */
+static bool _spi_byte(const uint8_t tx, uint8_t *const rx)
+{
+    bool triggered = false;
+    *rx = 0;
+    switch (_emulator.spi.state)
+    {
+    case _SPI_STATE_COMMAND:
+        _emulator.spi.index = 0;
+        _emulator.spi.data = 0;
+        switch (tx)
+        {
+        case SPICMD_SETADDR: _emulator.spi.state = _SPI_STATE_SETADDR; break;
+        case SPICMD_WRITEREG: _emulator.spi.state = _SPI_STATE_WRITEREG; break;
+        case SPICMD_READREG: _emulator.spi.state = _SPI_STATE_READREG; break;
+        case SPICMD_READFIFO: _emulator.spi.state = _SPI_STATE_READFIFO; break;
+        default: _emulator.spi.state = _SPI_STATE_IGNORE; break;
+        }
+        break;
+    case _SPI_STATE_SETADDR:
+        _emulator.spi.address = (_emulator.spi.address << 8) | tx;
+        if(++_emulator.spi.index == 2) _emulator.spi.state = _SPI_STATE_IGNORE;
+        break;
+    case _SPI_STATE_WRITEREG:
+        _emulator.spi.data = (_emulator.spi.data << 8) | tx;
+        if(++_emulator.spi.index == (_is_32bit_register(_emulator.spi.address) ? 4 : 2))
+        {
+            triggered = _write_register(_emulator.spi.address, _emulator.spi.data, 0xFF);
+            _emulator.spi.state = _SPI_STATE_IGNORE;
+        }
+        break;
+    case _SPI_STATE_READREG:
+    {
+        // One dummy byte, then the register data.
+        const uint32_t width = _is_32bit_register(_emulator.spi.address) ? 4 : 2;
+        if(_emulator.spi.index == 1) _emulator.spi.data = _read_register(_emulator.spi.address);
+        if(_emulator.spi.index >= 1 && _emulator.spi.index <= width)
+        {
+            *rx = (_emulator.spi.data >> (8 * (width - _emulator.spi.index))) & 0xFF;
+        }
+        _emulator.spi.index++;
+        break;
+    }
+    case _SPI_STATE_READFIFO:
+        // Six dummy bytes, then continuous FIFO words.
+        if(_emulator.spi.index >= 6)
+        {
+            const uint32_t byte = (_emulator.spi.index - 6) % 4;
+            if(byte == 0) _emulator.spi.data = _pop_fifo();
+            *rx = (_emulator.spi.data >> (8 * (3 - byte))) & 0xFF;
+        }
+        _emulator.spi.index++;
+        break;
+    default:
+        break;
+    }
+    return triggered;
+}
+
+int AD5940_spi_impl_zephyr_init(void)
+{
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    _reset();
+    k_mutex_unlock(&_emulator_lock);
+    LOG_INF("AD5940 emulator is used instead of SPI device");
+    return 0;
+}
+
+int AD5940_spi_impl_zephyr_select_frequency(void)
+{
+    return 0;
+}
+
+uint32_t AD5940_spi_impl_zephyr_get_frequency(void)
+{
+    return 0;
+}
+
+int AD5940_intc0_impl_zephyr_init(
+    void (*callback)(void),
+    void (*edge_callback)(void)
+)
+{
+    _intc0_callback = callback;
+    _intc0_edge_callback = edge_callback;
+    return 0;
+}
+
+int AD5940_Rst_impl_zephyr_init(void)
+{
+    return 0;
+}
+
+void AD5940_RstSet(void)
+{
+    return;
+}
+
+void AD5940_RstClr(void)
+{
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    _reset();
+    k_mutex_unlock(&_emulator_lock);
+    return;
+}
+
+void AD5940_CsSet(void)
+{
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    _emulator.spi.state = _SPI_STATE_COMMAND;
+    k_mutex_unlock(&_emulator_lock);
+    return;
+}
+
+void AD5940_CsClr(void)
+{
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    _emulator.spi.state = _SPI_STATE_COMMAND;
+    k_mutex_unlock(&_emulator_lock);
+    return;
+}
+
+void AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length)
+{
+    bool triggered = false;
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    for(unsigned long i=0; i<length; i++)
+    {
+        triggered |= _spi_byte(pSendBuffer[i], &pRecvBuff[i]);
+    }
+    k_mutex_unlock(&_emulator_lock);
+    if(triggered) _call_intc0_callbacks();
+    return;
+}
+
+uint16_t AD5940_emulator_impl_zephyr_get_fifo_count(void)
+{
+    k_mutex_lock(&_emulator_lock, K_FOREVER);
+    const uint16_t count = _emulator.fifo_count;
+    k_mutex_unlock(&_emulator_lock);
+    return count;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Number of words waiting in the emulated data FIFO.
+ * 
+ * Only available with CONFIG_AD5940_PORT_EMULATOR. The emulator replaces 
+ * the SPI, reset and INTC0 port implementations, so it's initialized by
+ * AD5940_spi_impl_zephyr_init() and AD5940_intc0_impl_zephyr_init().
+ */
+uint16_t AD5940_emulator_impl_zephyr_get_fifo_count(void);
+
+#ifdef __cplusplus
+}
+#endif
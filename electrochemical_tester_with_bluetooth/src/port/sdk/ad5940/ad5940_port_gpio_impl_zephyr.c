@@ -8,3 +8,4 @@ const struct gpio_dt_spec ad5940_gpio7 = GPIO_DT_SPEC_GET(
 );
 
 gpio_debounce_ctx_t ad5940_gpio7_ctx;
+gpio_edge_ctx_t ad5940_gpio7_edge_ctx;
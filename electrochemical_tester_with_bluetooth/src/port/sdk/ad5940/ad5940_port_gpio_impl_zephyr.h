@@ -6,10 +6,12 @@ extern "C"
 #endif
 
 #include "gpio_debounce.h"
+#include "gpio_edge.h"
 
 extern const struct gpio_dt_spec ad5940_gpio7;
 
 extern gpio_debounce_ctx_t ad5940_gpio7_ctx;
+extern gpio_edge_ctx_t ad5940_gpio7_edge_ctx;
 
 #ifdef __cplusplus
 }
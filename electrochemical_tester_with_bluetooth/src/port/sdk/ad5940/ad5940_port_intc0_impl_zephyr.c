@@ -1,21 +1,42 @@
 #include "ad5940_port_intc0_impl_zephyr.h"
 
 #include "gpio_debounce.h"
+#include "gpio_edge.h"
 #include "ad5940_port_gpio_impl_zephyr.h"
 
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(ad5940_intc0, LOG_LEVEL_INF);
 
-int AD5940_intc0_impl_zephyr_init(void (*callback)(void))
+static void (*_callback)(void);
+static void (*_edge_callback)(void);
+
+#ifdef CONFIG_AD5940_INTC0_DEBOUNCE
+
+// Only stamps the edge, the debounce work calls the callback later.
+static struct gpio_callback _edge_cb;
+
+static void _edge_isr(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+    // The AD5940 pulls GPIO7 low for an interrupt, the debounce also enables the rising edge.
+    if(gpio_pin_get_dt(&ad5940_gpio7) == 0) _edge_callback();
+}
+
+int AD5940_intc0_impl_zephyr_init(
+    void (*callback)(void),
+    void (*edge_callback)(void)
+)
 {
     int ret;
 
+    _callback = callback;
+    _edge_callback = edge_callback;
+
     ret = z_impl_gpio_debounce_init(
         &ad5940_gpio7_ctx,
         &ad5940_gpio7,
         GPIO_INPUT,
-        K_MSEC(20),
+        K_MSEC(CONFIG_AD5940_INTC0_DEBOUNCE_MS),
         NULL,
         callback
     );
@@ -24,5 +45,46 @@ int AD5940_intc0_impl_zephyr_init(void (*callback)(void))
         return -ENODEV;
     }
 
+    if (_edge_callback != NULL) {
+        gpio_init_callback(&_edge_cb, _edge_isr, BIT(ad5940_gpio7.pin));
+        ret = gpio_add_callback(ad5940_gpio7.port, &_edge_cb);
+    }
+
     return ret;
 }
+
+#else
+
+static void _isr(void)
+{
+    if (_edge_callback != NULL) _edge_callback();
+    _callback();
+}
+
+int AD5940_intc0_impl_zephyr_init(
+    void (*callback)(void),
+    void (*edge_callback)(void)
+)
+{
+    int ret;
+
+    _callback = callback;
+    _edge_callback = edge_callback;
+
+    // The AD5940 pulls GPIO7 low for an interrupt, it doesn't bounce.
+    ret = z_impl_gpio_edge_init(
+        &ad5940_gpio7_edge_ctx,
+        &ad5940_gpio7,
+        GPIO_INPUT,
+        GPIO_INT_EDGE_TO_INACTIVE,
+        _isr
+    );
+    if (ret) {
+        LOG_ERR("GPIO device not ready");
+        return -ENODEV;
+    }
+
+    return ret;
+}
+
+#endif
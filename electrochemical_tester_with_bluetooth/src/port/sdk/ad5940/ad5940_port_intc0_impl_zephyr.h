@@ -5,7 +5,18 @@ extern "C"
 {
 #endif
 
-int AD5940_intc0_impl_zephyr_init(void (*callback)(void));
+/**
+ * @brief Routes the AD5940 interrupt line (GPIO7) to the callbacks.
+ *
+ * @param callback      Called for every interrupt, from the GPIO ISR or,
+ *                      with CONFIG_AD5940_INTC0_DEBOUNCE, from the system workqueue after the debounce.
+ * @param edge_callback Called from the GPIO ISR at the edge in both modes, can be NULL.
+ *                      It marks the start of the interrupt-to-data latency.
+ */
+int AD5940_intc0_impl_zephyr_init(
+    void (*callback)(void),
+    void (*edge_callback)(void)
+);
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,8 @@
 #include "ad5940.h"
 #include "ad5940_port_spi_impl_zephyr.h"
+#include "ad5940_port_spi_trace_impl_zephyr.h"
+
+#include <errno.h>
 
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/spi.h>
@@ -7,14 +10,49 @@
 
 #include "spi.h"
 
-static const struct spi_config spi_1_cfg = {
-	.operation = 
-		SPI_OP_MODE_MASTER
-		| SPI_WORD_SET(8)
-		| SPI_TRANSFER_MSB,
-	.frequency = 6400000,
-	.slave = SPI_OP_MODE_MASTER,
+#define AD5940_SPI_CHIPID 0x5502
+#define AD5940_SPI_VERIFY_REPEAT 8
+#define AD5940_SPI_DEFAULT_FREQUENCY 6400000
+
+#ifdef CONFIG_AD5940_SPI_HARDWARE_CS
+/**
+ * CS is asserted by the controller on the first transfer of a frame and 
+ * kept until AD5940_CsSet() releases the bus, 
+ * the lock keeps other SPI users out of the frame.
+ */
+#define SPI_1_CFG(_frequency) { \
+	.operation = \
+		SPI_OP_MODE_MASTER \
+		| SPI_WORD_SET(8) \
+		| SPI_TRANSFER_MSB \
+		| SPI_HOLD_ON_CS \
+		| SPI_LOCK_ON, \
+	.frequency = _frequency, \
+	.slave = SPI_OP_MODE_MASTER, \
+	.cs = { \
+		.gpio = GPIO_DT_SPEC_GET(ZEPHYR_USER_PATH, ad5940_cs_gpios), \
+		.delay = 0, \
+	}, \
+}
+#else
+#define SPI_1_CFG(_frequency) { \
+	.operation = \
+		SPI_OP_MODE_MASTER \
+		| SPI_WORD_SET(8) \
+		| SPI_TRANSFER_MSB, \
+	.frequency = _frequency, \
+	.slave = SPI_OP_MODE_MASTER, \
+}
+#endif
+/**
+ * The SPI driver only reconfigures the bus when the config pointer changes,
+ * so a new frequency is written to the unused slot and the pointer is swapped.
+ */
+static struct spi_config spi_1_cfg_slots[2] = {
+	SPI_1_CFG(AD5940_SPI_DEFAULT_FREQUENCY),
+	SPI_1_CFG(AD5940_SPI_DEFAULT_FREQUENCY),
 };
+static const struct spi_config *spi_1_cfg = &spi_1_cfg_slots[0];
 static struct k_poll_signal spi_1_done_sig = K_POLL_SIGNAL_INITIALIZER(spi_1_done_sig);
 
 static const struct device *const spi_1_device = DEVICE_DT_GET(
@@ -40,31 +78,157 @@ int AD5940_spi_impl_zephyr_init(void)
 	{
 		return err;
 	}
+#ifdef CONFIG_AD5940_SPI_HARDWARE_CS
+	// The controller only drives the pin during frames, park it deasserted.
+	z_impl_spi_cs_select(&spi_1_cs, true);
+#endif
 
     return err;
 }
 
+#ifdef CONFIG_AD5940_SPI_HARDWARE_CS
+/**
+ * A transfer of the frame holds CS and the bus lock. 
+ * The library also calls AD5940_CsSet() outside of frames, e.g. in AD5940_Initialize(), 
+ * there is nothing to release then.
+ */
+static bool spi_1_locked = false;
+
+void AD5940_CsSet(void)
+{
+	// Drops the CS held since the first transfer of the frame and the bus lock.
+	if(spi_1_locked)
+	{
+		z_impl_spi_release(spi_1_device, spi_1_cfg);
+		spi_1_locked = false;
+	}
+	AD5940_SPI_TRACE_FRAME_END();
+	return;
+}
+
+void AD5940_CsClr(void)
+{
+	// CS is asserted by the controller on the first transfer of the frame.
+	AD5940_SPI_TRACE_FRAME_BEGIN();
+	return;
+}
+#else
 void AD5940_CsSet(void)
 {
     z_impl_spi_cs_select(&spi_1_cs, true);
+	AD5940_SPI_TRACE_FRAME_END();
 	return;
 }
 
 void AD5940_CsClr(void)
 {
+	AD5940_SPI_TRACE_FRAME_BEGIN();
     z_impl_spi_cs_select(&spi_1_cs, false);
 	return;
 }
+#endif
 
 void AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length)
 {
-	z_impl_spi_transfer(
+	const struct spi_buf tx_spi_buf = {
+		.buf = pSendBuffer,
+		.len = length,
+	};
+	const struct spi_buf_set tx = {
+		.buffers = &tx_spi_buf,
+		.count = 1,
+	};
+	const struct spi_buf rx_spi_buf = {
+		.buf = pRecvBuff,
+		.len = length,
+	};
+	const struct spi_buf_set rx = {
+		.buffers = &rx_spi_buf,
+		.count = 1,
+	};
+
+#ifdef CONFIG_AD5940_SPI_TRACE
+	const uint32_t start = k_cycle_get_32();
+#endif
+	if(z_impl_spi_transfer_submit(
 		spi_1_device,
-		&spi_1_cfg, 
+		spi_1_cfg, 
 		&spi_1_done_sig, 
-		pSendBuffer,
-		pRecvBuff,
-		length
-	);
+		&tx,
+		&rx
+	) != 0) return;
+#ifdef CONFIG_AD5940_SPI_HARDWARE_CS
+	spi_1_locked = true;
+#endif
+	/* Sleep instead of spinning, BLE and command threads run while the bytes are clocked. */
+	z_impl_spi_transfer_wait(&spi_1_done_sig, K_FOREVER);
+	AD5940_SPI_TRACE_TRANSFER(pSendBuffer, pRecvBuff, length, k_cycle_get_32() - start);
+	return;
+}
+
+static void _set_frequency(const uint32_t frequency)
+{
+	struct spi_config *next = (spi_1_cfg == &spi_1_cfg_slots[0]) ? &spi_1_cfg_slots[1] : &spi_1_cfg_slots[0];
+	next->frequency = frequency;
+	spi_1_cfg = next;
 	return;
 }
+
+/**
+ * Readback checks of one frequency step: 
+ * fixed ID registers and data patterns through a register with no side effect while LPDAC is off.
+ */
+static bool _verify_frequency(void)
+{
+	static const uint32_t patterns[] = {0x3FFFF, 0x00000, 0x2AAAA, 0x15555, 0x3C3C3, 0x03C3C};
+	for(size_t i=0; i<AD5940_SPI_VERIFY_REPEAT; i++)
+	{
+		if(AD5940_GetADIID() != AD5940_ADIID) return false;
+		if(AD5940_GetChipID() != AD5940_SPI_CHIPID) return false;
+		for(size_t j=0; j<sizeof(patterns)/sizeof(patterns[0]); j++)
+		{
+			AD5940_WriteReg(REG_AFE_LPDACDAT0, patterns[j]);
+			if((AD5940_ReadReg(REG_AFE_LPDACDAT0) & 0x3FFFF) != patterns[j]) return false;
+		}
+	}
+	AD5940_WriteReg(REG_AFE_LPDACDAT0, 0);
+	return true;
+}
+
+int AD5940_spi_impl_zephyr_select_frequency(void)
+{
+	static const uint32_t frequencies[] = {1000000, 2000000, 4000000, 8000000, 16000000, 32000000};
+	uint32_t locked = 0;
+	int err = 0;
+
+	/* Wakeup AFE by read register, read 10 times at most */
+	if(AD5940_WakeUp(10) > 10) err = -EIO;
+	else
+	{
+		for(size_t i=0; i<sizeof(frequencies)/sizeof(frequencies[0]); i++)
+		{
+			if(frequencies[i] > CONFIG_AD5940_SPI_MAX_FREQUENCY) break;
+			_set_frequency(frequencies[i]);
+			if(!_verify_frequency()) break;
+			locked = frequencies[i];
+		}
+		if(locked == 0)
+		{
+			_set_frequency(AD5940_SPI_DEFAULT_FREQUENCY);
+			err = -EIO;
+		}
+		else _set_frequency(locked);
+		// The failed step may leave a corrupted pattern behind.
+		AD5940_WriteReg(REG_AFE_LPDACDAT0, 0);
+	}
+
+	// Back to sleep whether a frequency is locked or not.
+	AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK);
+	AD5940_EnterSleepS();
+	return err;
+}
+
+uint32_t AD5940_spi_impl_zephyr_get_frequency(void)
+{
+	return spi_1_cfg->frequency;
+}
@@ -5,8 +5,24 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
 int AD5940_spi_impl_zephyr_init(void);
 
+/**
+ * @brief Steps the SPI clock up and locks in the fastest reliable one.
+ * 
+ * Every step is verified by repeated ADIID/CHIPID readbacks and data 
+ * pattern write/readback. Stepping stops at the first failure or at 
+ * CONFIG_AD5940_SPI_MAX_FREQUENCY. Call it after AD5940_MAIN_init(), 
+ * the AFE is put back to hibernate when it returns.
+ * 
+ * @return 0 on success, -EIO if no step passed and the default frequency is kept.
+ */
+int AD5940_spi_impl_zephyr_select_frequency(void);
+
+uint32_t AD5940_spi_impl_zephyr_get_frequency(void);
+
 #ifdef __cplusplus
 }
 #endif
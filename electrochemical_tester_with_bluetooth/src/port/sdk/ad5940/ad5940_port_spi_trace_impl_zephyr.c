@@ -0,0 +1,157 @@
+#include "ad5940.h"
+#include "ad5940_port_spi_trace_impl_zephyr.h"
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#define TRACE_DEPTH CONFIG_AD5940_SPI_TRACE_DEPTH
+
+BUILD_ASSERT((TRACE_DEPTH & (TRACE_DEPTH - 1)) == 0, "CONFIG_AD5940_SPI_TRACE_DEPTH must be a power of 2");
+
+/**
+ * Frames are serialized by the CS window, so there is one writer at a time.
+ * The head is atomic so the reader never needs to stop the writer.
+ */
+static AD5940_SPI_TRACE_RECORD _records[TRACE_DEPTH];
+static atomic_t _head;
+static atomic_t _tail;
+
+/* Frame being recorded, between AD5940_CsClr and AD5940_CsSet */
+static AD5940_SPI_TRACE_RECORD _frame;
+static uint16_t _address;
+
+static bool _is_32bit_register(const uint16_t address)
+{
+    return (address >= 0x1000) && (address <= 0x3014);
+}
+
+static uint32_t _get_data(const uint8_t *const buffer, const uint32_t length)
+{
+    const uint32_t size = _is_32bit_register(_address) ? 4 : 2;
+    uint32_t data = 0;
+    for(uint32_t i=0; (i<size) && (i<length); i++)
+    {
+        data = (data << 8) | buffer[i];
+    }
+    return data;
+}
+
+void AD5940_spi_trace_impl_zephyr_frame_begin(void)
+{
+    memset(&_frame, 0, sizeof(_frame));
+    _frame.timestamp = k_cycle_get_32();
+    return;
+}
+
+void AD5940_spi_trace_impl_zephyr_transfer(
+    const uint8_t *const tx,
+    const uint8_t *const rx,
+    const uint32_t length,
+    const uint32_t cycles
+)
+{
+    _frame.transfer_cycles += cycles;
+
+    // Only the first transfer of a frame carries the command header
+    if(_frame.length == 0 && length > 0)
+    {
+        _frame.command = tx[0];
+        switch (tx[0])
+        {
+        case SPICMD_SETADDR:
+            if(length >= 3) _address = ((uint16_t) tx[1] << 8) | tx[2];
+            break;
+        case SPICMD_WRITEREG:
+            _frame.data = _get_data(&tx[1], length - 1);
+            break;
+        case SPICMD_READREG:
+            // Command byte and one dummy byte before the data
+            if(length > 2) _frame.data = _get_data(&rx[2], length - 2);
+            break;
+        default:
+            break;
+        }
+    }
+    _frame.address = _address;
+
+    const uint32_t total = _frame.length + length;
+    _frame.length = (total > UINT8_MAX) ? UINT8_MAX : total;
+    return;
+}
+
+void AD5940_spi_trace_impl_zephyr_frame_end(void)
+{
+    _frame.cs_hold_cycles = k_cycle_get_32() - _frame.timestamp;
+    const atomic_val_t head = atomic_get(&_head);
+    _records[head & (TRACE_DEPTH - 1)] = _frame;
+    atomic_set(&_head, head + 1);
+    return;
+}
+
+size_t AD5940_spi_trace_impl_zephyr_read(
+    AD5940_SPI_TRACE_RECORD *const records,
+    const size_t max,
+    uint32_t *const dropped
+)
+{
+    const atomic_val_t head = atomic_get(&_head);
+    atomic_val_t tail = atomic_get(&_tail);
+    if(head - tail > TRACE_DEPTH)
+    {
+        if(dropped != NULL) *dropped = head - tail - TRACE_DEPTH;
+        tail = head - TRACE_DEPTH;
+    }
+    else if(dropped != NULL) *dropped = 0;
+
+    size_t count = 0;
+    for(atomic_val_t i=tail; (i!=head) && (count<max); i++)
+    {
+        records[count++] = _records[i & (TRACE_DEPTH - 1)];
+    }
+    return count;
+}
+
+void AD5940_spi_trace_impl_zephyr_dump(void)
+{
+    AD5940_SPI_TRACE_RECORD records[16];
+    uint32_t dropped;
+    size_t count;
+    atomic_val_t tail = atomic_get(&_tail);
+
+    printk("ad5940_spi_trace begin %u\n", sys_clock_hw_cycles_per_sec());
+    const atomic_val_t head = atomic_get(&_head);
+    if(head - tail > TRACE_DEPTH)
+    {
+        printk("ad5940_spi_trace dropped %u\n", (uint32_t) (head - tail - TRACE_DEPTH));
+        tail = head - TRACE_DEPTH;
+    }
+    while(tail != head)
+    {
+        // Read in small chunks to keep the stack usage low
+        atomic_set(&_tail, tail);
+        count = AD5940_spi_trace_impl_zephyr_read(records, MIN(ARRAY_SIZE(records), head - tail), &dropped);
+        if(count == 0) break;
+        for(size_t i=0; i<count; i++)
+        {
+            const uint8_t *p = (const uint8_t *) &records[i];
+            printk("ad5940_spi_trace ");
+            for(size_t j=0; j<sizeof(AD5940_SPI_TRACE_RECORD); j++)
+            {
+                printk("%02x", p[j]);
+            }
+            printk("\n");
+        }
+        tail += count;
+    }
+    atomic_set(&_tail, head);
+    printk("ad5940_spi_trace end\n");
+    return;
+}
+
+void AD5940_spi_trace_impl_zephyr_clear(void)
+{
+    atomic_set(&_tail, atomic_get(&_head));
+    return;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * One AD5940 SPI frame (one CS window), 20 bytes little endian.
+ *
+ * Keep the layout in sync with tools/ad5940_spi_trace_decode.py.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp;         /**< Cycle counter when CS is asserted. */
+    uint32_t transfer_cycles;   /**< Cycles spent in the transfers of the frame. */
+    uint32_t cs_hold_cycles;    /**< Cycles between CS assert and deassert. */
+    uint32_t data;              /**< Register data written or read, 0 for FIFO reads. */
+    uint16_t address;           /**< Last address set by SPICMD_SETADDR. */
+    uint8_t command;            /**< First byte of the frame (SPICMD_xxx). */
+    uint8_t length;             /**< Bytes in the frame, saturated at 255. */
+}
+AD5940_SPI_TRACE_RECORD;
+
+#ifdef CONFIG_AD5940_SPI_TRACE
+
+void AD5940_spi_trace_impl_zephyr_frame_begin(void);
+void AD5940_spi_trace_impl_zephyr_transfer(
+    const uint8_t *const tx,
+    const uint8_t *const rx,
+    const uint32_t length,
+    const uint32_t cycles
+);
+void AD5940_spi_trace_impl_zephyr_frame_end(void);
+
+/**
+ * @brief Copies the newest records, oldest first.
+ *
+ * The ring is written without locks, records overwritten while copying
+ * may be mixed, which is fine for latency statistics.
+ *
+ * @param dropped Number of records lost since the last clear, can be NULL.
+ * @return Number of records copied.
+ */
+size_t AD5940_spi_trace_impl_zephyr_read(
+    AD5940_SPI_TRACE_RECORD *const records,
+    const size_t max,
+    uint32_t *const dropped
+);
+
+/**
+ * @brief Prints the ring with printk as hex lines (RTT or UART console),
+ * decoded by tools/ad5940_spi_trace_decode.py.
+ */
+void AD5940_spi_trace_impl_zephyr_dump(void);
+
+void AD5940_spi_trace_impl_zephyr_clear(void);
+
+#define AD5940_SPI_TRACE_FRAME_BEGIN() AD5940_spi_trace_impl_zephyr_frame_begin()
+#define AD5940_SPI_TRACE_TRANSFER(tx, rx, length, cycles) AD5940_spi_trace_impl_zephyr_transfer(tx, rx, length, cycles)
+#define AD5940_SPI_TRACE_FRAME_END() AD5940_spi_trace_impl_zephyr_frame_end()
+
+#else
+
+#define AD5940_SPI_TRACE_FRAME_BEGIN() do {} while(0)
+#define AD5940_SPI_TRACE_TRANSFER(tx, rx, length, cycles) do {} while(0)
+#define AD5940_SPI_TRACE_FRAME_END() do {} while(0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,19 +1,63 @@
 #include "ad5940_task_impl_zephyr.h"
 
+#include <errno.h>
+#include <stdbool.h>
+
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 
 // ==================================================
 // ADC
 static K_MUTEX_DEFINE(_mutex_adc_length);
-#define MAX_QUEUE 8
-K_MSGQ_DEFINE(_quene_adc, sizeof(AD5940_TASK_ADC_RESULT), MAX_QUEUE, 4);
+
+#define RING_DEPTH CONFIG_AD5940_TASK_ADC_RING_DEPTH
+// Batches come at about ADC_INTERRUPT_RATE, the samples run out long before the records.
+#define RECORD_DEPTH 64
+
+BUILD_ASSERT((RING_DEPTH & (RING_DEPTH - 1)) == 0, "CONFIG_AD5940_TASK_ADC_RING_DEPTH must be a power of 2");
+BUILD_ASSERT(RING_DEPTH >= FIFO_BUFFER_SIZE, "CONFIG_AD5940_TASK_ADC_RING_DEPTH must hold a whole FIFO read");
+
+/**
+ * Single producer, the ADC task, and single consumer, the ADC sender.
+ * Only the producer writes the heads and only the consumer the tails, so no lock is needed,
+ * the semaphores only wake the other side up.
+ * 
+ * Every batch takes contiguous samples so the FIFO is read directly into the ring,
+ * the samples left at the end of the ring are skipped if a batch doesn't fit there.
+ */
+typedef struct
+{
+    AD5940_TASK_ADC_RESULT result;
+    atomic_val_t sample_end;    // Sample head after the batch, the sample tail after it's released.
+} RECORD;
+
+static uint32_t _samples[RING_DEPTH];
+static atomic_t _sample_head;
+static atomic_t _sample_tail;
+
+static RECORD _records[RECORD_DEPTH];
+static atomic_t _record_head;
+static atomic_t _record_tail;
+
+static K_SEM_DEFINE(_sem_adc_records, 0, RECORD_DEPTH);
+static K_SEM_DEFINE(_sem_adc_room, 0, 1);
+
+// The FIFO still has to be read when the ring is full.
+static uint32_t _discard[FIFO_BUFFER_SIZE];
+static atomic_val_t _reserved_position;
+
+static atomic_t _dropped_batches;
+static atomic_t _dropped_samples;
+static atomic_t _max_used_samples;
+
+static K_SEM_DEFINE(_sem_adc_measurement_done, 0, 1);
 
 // ==================================================
 // Command
 static K_MUTEX_DEFINE(_mutex_command_measurement_param);
 
-static K_MUTEX_DEFINE(_mutex_command_measurement_triggered);
-static K_CONDVAR_DEFINE(_condvar_command_measurement_triggered);
+// One count per queued measurement, a count left by a canceled one finds the queue empty.
+static K_SEM_DEFINE(_sem_command_measurement_triggered, 0, AD5940_TASK_COMMAND_QUENE_LENGTH);
 
 int AD5940_TASK_init_impl_zephyr(void)
 {
@@ -26,10 +70,6 @@ int AD5940_TASK_init_impl_zephyr(void)
     // Command
     err = k_mutex_init(&_mutex_command_measurement_param);
     if(err) return err;
-    err = k_mutex_init(&_mutex_command_measurement_triggered);
-    if(err) return err;
-    err = k_condvar_init(&_condvar_command_measurement_triggered);
-    if(err) return err;
 
     return 0;
 }
@@ -49,14 +89,91 @@ int AD5940_TASK_ADC_release_access_length_lock(void)
     return 0;
 }
 
+static bool _reserve(const uint16_t length, atomic_val_t *const position)
+{
+    if((atomic_get(&_record_head) - atomic_get(&_record_tail)) >= RECORD_DEPTH) return false;
+
+    atomic_val_t head = atomic_get(&_sample_head);
+    if(((head & (RING_DEPTH - 1)) + length) > RING_DEPTH) head = (head | (RING_DEPTH - 1)) + 1;
+    if((head + length - atomic_get(&_sample_tail)) > RING_DEPTH) return false;
+
+    *position = head;
+    return true;
+}
+
+uint32_t *AD5940_TASK_ADC_reserve_quene(const uint16_t length)
+{
+    const int64_t deadline = k_uptime_get() + CONFIG_AD5940_TASK_ADC_RING_WAIT_MS;
+    while(!_reserve(length, &_reserved_position))
+    {
+        const int64_t wait = deadline - k_uptime_get();
+        if(wait <= 0 || k_sem_take(&_sem_adc_room, K_MSEC(wait)) != 0)
+        {
+            return _discard;
+        }
+    }
+    return &_samples[_reserved_position & (RING_DEPTH - 1)];
+}
+
 int AD5940_TASK_ADC_put_quene(const AD5940_TASK_ADC_RESULT *const adc_result)
 {
-    return k_msgq_put(&_quene_adc, adc_result, K_NO_WAIT);
+    if(adc_result->fifo_buffer == _discard)
+    {
+        atomic_inc(&_dropped_batches);
+        atomic_add(&_dropped_samples, adc_result->fifo_count);
+        return -ENOMEM;
+    }
+
+    const atomic_val_t record_head = atomic_get(&_record_head);
+    RECORD *const record = &_records[record_head & (RECORD_DEPTH - 1)];
+    record->result = *adc_result;
+    record->sample_end = _reserved_position + adc_result->fifo_count;
+
+    const atomic_val_t used = record->sample_end - atomic_get(&_sample_tail);
+    if(used > atomic_get(&_max_used_samples)) atomic_set(&_max_used_samples, used);
+
+    atomic_set(&_sample_head, record->sample_end);
+    atomic_set(&_record_head, record_head + 1);
+    k_sem_give(&_sem_adc_records);
+    return 0;
 }
 
 int AD5940_TASK_ADC_take_quene(AD5940_TASK_ADC_RESULT *const adc_result)
 {
-    return k_msgq_get(&_quene_adc, adc_result, K_FOREVER);
+    k_sem_take(&_sem_adc_records, K_FOREVER);
+    *adc_result = _records[atomic_get(&_record_tail) & (RECORD_DEPTH - 1)].result;
+    return 0;
+}
+
+int AD5940_TASK_ADC_release_quene(const AD5940_TASK_ADC_RESULT *const adc_result)
+{
+    const atomic_val_t record_tail = atomic_get(&_record_tail);
+    const RECORD *const record = &_records[record_tail & (RECORD_DEPTH - 1)];
+    if(record->result.fifo_buffer != adc_result->fifo_buffer) return -EINVAL;
+
+    atomic_set(&_sample_tail, record->sample_end);
+    atomic_set(&_record_tail, record_tail + 1);
+    k_sem_give(&_sem_adc_room);
+    return 0;
+}
+
+int AD5940_TASK_ADC_get_quene_statistics(AD5940_TASK_ADC_QUENE_STATISTICS *const statistics)
+{
+    statistics->dropped_batches = atomic_get(&_dropped_batches);
+    statistics->dropped_samples = atomic_get(&_dropped_samples);
+    statistics->max_used_samples = atomic_get(&_max_used_samples);
+    return 0;
+}
+
+int AD5940_TASK_ADC_wait_measurement_done(void)
+{
+    return k_sem_take(&_sem_adc_measurement_done, K_FOREVER);
+}
+
+int AD5940_TASK_ADC_trigger_measurement_done(void)
+{
+    k_sem_give(&_sem_adc_measurement_done);
+    return 0;
 }
 
 // ==================================================
@@ -76,16 +193,11 @@ int AD5940_TASK_COMMAND_release_access_measurement_param_lock(void)
 
 int AD5940_TASK_COMMAND_wait_measurement(void)
 {
-    k_mutex_lock(&_mutex_command_measurement_triggered, K_FOREVER);
-    k_condvar_wait(&_condvar_command_measurement_triggered, &_mutex_command_measurement_triggered, K_FOREVER);
-    k_mutex_unlock(&_mutex_command_measurement_triggered);
-    return 0;
+    return k_sem_take(&_sem_command_measurement_triggered, K_FOREVER);
 }
 
 int AD5940_TASK_COMMAND_trigger_measurement(void)
 {
-    k_mutex_lock(&_mutex_command_measurement_triggered, K_FOREVER);
-    k_condvar_broadcast(&_condvar_command_measurement_triggered);
-    k_mutex_unlock(&_mutex_command_measurement_triggered);
+    k_sem_give(&_sem_command_measurement_triggered);
     return 0;
 }
@@ -6,6 +6,7 @@ extern "C"
 #endif
 
 #include "ad5940_task_adc.h"
+#include "ad5940_task_command.h"
 
 int AD5940_TASK_init_impl_zephyr(void);
 
@@ -1,10 +1,15 @@
 #include "ad5940_task_adc.h"
 
 #include <stdatomic.h>
+#include <string.h>
 
 #include "ad5940_task_private.h"
 
 #include "AD5940_irq_handler.h"
+#include "ad5940_utils.h"
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+#include "ad5940_electrochemical_utility_temperature.h"
+#endif
 
 static const AD5940_TASK_ADC_CFG *_cfg;
 static volatile _Atomic AD5940_TASK_ADC_STATE _state = AD5940_TASK_ADC_STATE_UNINITIALIZED;
@@ -15,20 +20,219 @@ AD5940_TASK_ADC_STATE AD5940_TASK_ADC_get_state(void)
 }
 
 static AD5940_TASK_ADC_RESULT _result = {};
+// FIFO data of the measurement, the ADC data and the temperature data interleaved among them.
+static uint16_t _fifo_data_length = 0;
+static uint16_t _fifo_data_index = 0;
+static uint16_t _fifo_thresh = 1;
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+static uint16_t _temperature_index = 0;
+// Every FIFO read holds at most one temperature data per ADC data.
+static uint32_t _temperature_data[FIFO_BUFFER_SIZE];
+#endif
+// Until the measurement done is triggered.
+static BoolFlag _is_measuring = bFALSE;
+// First FIFO read that failed, the measurement is stopped at it.
+static AD5940Err _measurement_err = AD5940ERR_OK;
+// NULL while the FIFO is read by AD5940_irq_handler.
+static const AD5940_TASK_ADC_FIFO_HANDLER *_handler = NULL;
+// Data read by the stop of the FIFO handler, the measurement is over by then.
+static uint32_t _stopped_data[FIFO_BUFFER_SIZE];
+
+uint16_t AD5940_TASK_ADC_get_FIFO_thresh(
+    float sample_interval,
+    uint16_t length
+)
+{
+    uint16_t fifo_thresh = ADC_SAMPLE_UNIT_MAX;
+    if(sample_interval > 0)
+    {
+        const float samples = 1.0F / (sample_interval * ADC_INTERRUPT_RATE);
+        if(samples < ADC_SAMPLE_UNIT_MAX) fifo_thresh = (uint16_t) samples;
+    }
+    if(fifo_thresh > length) fifo_thresh = length;
+    if(fifo_thresh < 1) fifo_thresh = 1;
+    return fifo_thresh;
+}
 
 int AD5940_TASK_ADC_reset(
+    uint32_t id,
     uint8_t flag,
-    uint16_t length
+    uint16_t length,
+    uint16_t fifo_thresh,
+    const AD5940_TASK_ADC_FIFO_HANDLER *const handler
 )
 {
     AD5940_TASK_ADC_get_access_length_lock();
+    _result.id = id;
     _result.flag = flag;
     _result.adc_data_index = 0;
-    _result.adc_data_length = length;
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+    const uint32_t fifo_data_length = AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(length);
+    _fifo_data_length = (fifo_data_length > UINT16_MAX) ? UINT16_MAX : fifo_data_length;
+    _temperature_index = 0;
+#else
+    _fifo_data_length = length;
+#endif
+    _fifo_data_index = 0;
+    _fifo_thresh = fifo_thresh;
+    _handler = handler;
+    _is_measuring = (length > 0) ? bTRUE : bFALSE;
+    _measurement_err = AD5940ERR_OK;
     AD5940_TASK_ADC_release_access_length_lock();
     return 0;
 }
 
+/**
+ * @brief Shuts the AFE down, the length lock is held.
+ * 
+ * The FIFO handler also stops what the technique runs beside the sequencer, e.g. a DAC stream.
+ */
+static void _shutdown(void)
+{
+    uint16_t count;
+    if(
+        _handler == NULL
+        || _handler->stop(_stopped_data, FIFO_BUFFER_SIZE, &count) != AD5940ERR_OK
+    )
+    {
+        AD5940_shutdown_afe_lploop_hsloop_dsp();
+    }
+    _handler = NULL;
+    return;
+}
+
+int AD5940_TASK_ADC_stop(void)
+{
+    AD5940_TASK_ADC_get_access_length_lock();
+    if(_is_measuring == bTRUE) _shutdown();
+    else AD5940_shutdown_afe_lploop_hsloop_dsp();
+    // The interrupts still pending find the measurement complete.
+    _fifo_data_length = _fifo_data_index;
+    const BoolFlag was_measuring = _is_measuring;
+    _is_measuring = bFALSE;
+    AD5940_TASK_ADC_release_access_length_lock();
+
+    if(was_measuring == bTRUE) AD5940_TASK_ADC_trigger_measurement_done();
+    return 0;
+}
+
+AD5940Err AD5940_TASK_ADC_get_measurement_err(void)
+{
+    AD5940_TASK_ADC_get_access_length_lock();
+    const AD5940Err err = _measurement_err;
+    AD5940_TASK_ADC_release_access_length_lock();
+    return err;
+}
+
+// Passed to AD5940_irq_handler to keep the FIFO threshold, as the measurements always did.
+#define FIFO_THRESH_KEEP -1
+
+/**
+ * @brief Chooses the FIFO threshold passed to AD5940_irq_handler.
+ * 
+ * The threshold is lowered to the samples still to come for the last batch, so its interrupt still comes.
+ * 
+ * @param fifo_count    Data in the AD5940 FIFO before it's read.
+ * 
+ * @return 0 to stop after the last batch, FIFO_THRESH_KEEP to keep the threshold, otherwise the new threshold.
+ */
+static int32_t _get_new_FIFO_thresh(const uint16_t fifo_count)
+{
+    const uint16_t remaining = _fifo_data_length - _fifo_data_index;
+    if(fifo_count >= remaining) return 0;
+    const uint16_t left = remaining - fifo_count;
+    if(left < _fifo_thresh) return left;
+    return FIFO_THRESH_KEEP;
+}
+
+/**
+ * @brief Reads the number of samples in the AD5940 FIFO, the AD5940 is left awake.
+ * 
+ * @return The number of samples, 0 if the AD5940 doesn't wake up.
+ */
+static uint16_t _get_FIFO_count(void)
+{
+    if(AD5940_WakeUp(10) > 10) return 0;
+    return AD5940_FIFOGetCnt();
+}
+
+/**
+ * @brief Stops the measurement at a FIFO read that failed, see AD5940_TASK_ADC_get_measurement_err.
+ */
+static void _stop_at_read_err(const AD5940Err read_err)
+{
+    _shutdown();
+    _measurement_err = read_err;
+    _fifo_data_length = _fifo_data_index;
+    return;
+}
+
+/**
+ * @brief Queues the batch read into _result.fifo_buffer, its temperature data as a batch of their own.
+ * 
+ * The whole batch is queued once, the receiver splits it into samples.
+ */
+static void _put_results(void)
+{
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+    uint16_t temperature_count = 0;
+    if(_result.flag != AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE)
+    {
+        // Called with every read, even a dropped one, a temperature may be split from its ADC data.
+        AD5940_ELECTROCHEMICAL_UTILITY_temperature_split(
+            _result.fifo_buffer,
+            &_result.fifo_count,
+            _temperature_data,
+            &temperature_count,
+            sizeof(_temperature_data) / sizeof(_temperature_data[0])
+        );
+    }
+#endif
+    if(_result.fifo_count > 0) AD5940_TASK_ADC_put_quene(&_result);
+    _result.adc_data_index += _result.fifo_count;
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+    if(temperature_count == 0) return;
+
+    AD5940_TASK_ADC_RESULT temperature = {
+        .flag = AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE,
+        .id = _result.id,
+        .fifo_count = temperature_count,
+        .adc_data_index = _temperature_index,
+        .fifo_buffer = AD5940_TASK_ADC_reserve_quene(temperature_count),
+    };
+    memcpy(temperature.fifo_buffer, _temperature_data, temperature_count * sizeof(_temperature_data[0]));
+    AD5940_TASK_ADC_put_quene(&temperature);
+    _temperature_index += temperature_count;
+#endif
+    return;
+}
+
+/**
+ * @brief Reads the FIFO with the handler of the measurement, the technique keeps its FIFO threshold.
+ * 
+ * Called once per interrupt, the technique reads whole levels and shuts the AFE down after the last one.
+ */
+static void _read_handler_FIFO(void)
+{
+    _result.fifo_buffer = AD5940_TASK_ADC_reserve_quene(FIFO_BUFFER_SIZE);
+    const AD5940Err read_err = _handler->interrupt(
+        _result.fifo_buffer,
+        FIFO_BUFFER_SIZE,
+        &_result.fifo_count
+    );
+    if(read_err != AD5940ERR_OK)
+    {
+        _stop_at_read_err(read_err);
+        return;
+    }
+
+    const uint16_t remaining = _fifo_data_length - _fifo_data_index;
+    if(_result.fifo_count > remaining) _result.fifo_count = remaining;
+    _fifo_data_index += _result.fifo_count;
+    _put_results();
+    return;
+}
+
 int AD5940_TASK_ADC_take_result_quene(
     AD5940_TASK_ADC_RESULT *const result
 )
@@ -36,6 +240,20 @@ int AD5940_TASK_ADC_take_result_quene(
     return AD5940_TASK_ADC_take_quene(result);
 }
 
+int AD5940_TASK_ADC_release_result_quene(
+    const AD5940_TASK_ADC_RESULT *const result
+)
+{
+    return AD5940_TASK_ADC_release_quene(result);
+}
+
+int AD5940_TASK_ADC_get_result_quene_statistics(
+    AD5940_TASK_ADC_QUENE_STATISTICS *const statistics
+)
+{
+    return AD5940_TASK_ADC_get_quene_statistics(statistics);
+}
+
 AD5940Err AD5940_TASK_ADC_run(AD5940_TASK_ADC_CFG *const cfg)
 {
     int err = 0;
@@ -57,29 +275,86 @@ AD5940Err AD5940_TASK_ADC_run(AD5940_TASK_ADC_CFG *const cfg)
             _cfg->callback.start();
         }
 
+        BoolFlag is_done = bFALSE;
         AD5940_TASK_ADC_get_access_length_lock();
-        if(_result.adc_data_index < _result.adc_data_length)
+        if(_fifo_data_index < _fifo_data_length)
         {
-            err = AD5940_irq_handler(
-                ((_result.adc_data_index + 1) < _result.adc_data_length) ? -1 : 0,
-                FIFO_BUFFER_SIZE,
-                _result.fifo_buffer, 
-                &_result.fifo_count
-            );
-            if (err) {
-                atomic_store(&_state, AD5940_TASK_ADC_STATE_ERROR);
-                for(;;) {}
+            /**
+             * The threshold flag is cleared after the FIFO is read, samples arriving in between
+             * don't raise it again, so drain until the FIFO is below the threshold.
+             * One interrupt may also have been served by the drain of the previous one already.
+             * A FIFO handler reads once instead, the technique re-arms its own threshold.
+             */
+            BoolFlag is_interrupted = bTRUE;
+            int32_t new_thresh = FIFO_THRESH_KEEP;
+            if(_handler != NULL)
+            {
+                _read_handler_FIFO();
+                new_thresh = 0;
+            }
+            while(new_thresh != 0)
+            {
+                const uint16_t fifo_count = _get_FIFO_count();
+                new_thresh = _get_new_FIFO_thresh(fifo_count);
+                if(is_interrupted == bFALSE && new_thresh == FIFO_THRESH_KEEP && fifo_count < _fifo_thresh)
+                {
+                    AD5940_EnterSleepS();
+                    break;
+                }
+                is_interrupted = bFALSE;
+
+                // The FIFO is read directly into the sample ring.
+                _result.fifo_buffer = AD5940_TASK_ADC_reserve_quene(FIFO_BUFFER_SIZE);
+                if(fifo_count > FIFO_BUFFER_SIZE)
+                {
+                    /**
+                     * More data than the buffer holds, e.g. after waiting for room in the ring.
+                     * A buffer of it is read here, the handler is left the rest and re-arms the
+                     * interrupt after it, so the next pass reads again whatever the count.
+                     */
+                    AD5940_FIFORd(_result.fifo_buffer, FIFO_BUFFER_SIZE);
+                    _result.fifo_count = FIFO_BUFFER_SIZE;
+                    new_thresh = FIFO_THRESH_KEEP;
+                    is_interrupted = bTRUE;
+                }
+                else
+                {
+                    const AD5940Err read_err = AD5940_irq_handler(
+                        new_thresh,
+                        FIFO_BUFFER_SIZE,
+                        _result.fifo_buffer, 
+                        &_result.fifo_count
+                    );
+                    if(read_err != AD5940ERR_OK)
+                    {
+                        _stop_at_read_err(read_err);
+                        break;
+                    }
+                    if(new_thresh > 0) _fifo_thresh = new_thresh;
+                }
+
+                const uint16_t remaining = _fifo_data_length - _fifo_data_index;
+                if(_result.fifo_count > remaining) _result.fifo_count = remaining;
+                _fifo_data_index += _result.fifo_count;
+                _put_results();
+            }
+            if(_fifo_data_index >= _fifo_data_length && _is_measuring == bTRUE)
+            {
+                _is_measuring = bFALSE;
+                is_done = bTRUE;
             }
-            AD5940_TASK_ADC_put_quene(&_result);
-            _result.adc_data_index++;
         }
         else
         {
             _result.adc_data_index = 0;
-            _result.adc_data_length = 0;
+            _fifo_data_index = 0;
+            _fifo_data_length = 0;
         }
         AD5940_TASK_ADC_release_access_length_lock();
 
+        // The command task starts the next queued measurement.
+        if(is_done == bTRUE) AD5940_TASK_ADC_trigger_measurement_done();
+
         atomic_store(&_state, AD5940_TASK_ADC_STATE_IDLE);
 
         // callback
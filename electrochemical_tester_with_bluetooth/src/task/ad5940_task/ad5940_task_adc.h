@@ -8,33 +8,63 @@ extern "C"
 #include "ad5940.h"
 #include "ad5940_electrochemical_utils.h"
 
-// Define the number of ADC samples handled per callback trigger.
-#define ADC_SAMPLE_UNIT 1
+// Target rate of the AD5940 FIFO threshold interrupts, in interrupts per second.
+// The FIFO threshold batches as many samples as the sample interval allows, see AD5940_TASK_ADC_get_FIFO_thresh.
+#define ADC_INTERRUPT_RATE 10.0F
 
-// Allocate sufficient buffer size to prevent FIFO overflow.
-#define FIFO_BUFFER_SIZE (ADC_SAMPLE_UNIT * 5)
+// Define the maximum number of ADC samples handled per callback trigger.
+#define ADC_SAMPLE_UNIT_MAX 32
+
+// Room reserved in the sample ring for every FIFO read to prevent FIFO overflow,
+// samples still arrive while a batch waits for the MCU.
+#define FIFO_BUFFER_SIZE (ADC_SAMPLE_UNIT_MAX * 2)
 
 typedef struct
 {
     enum {
         AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE,
         AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
+        // Interleaved into an electrochemical measurement, converted with its ADC PGA gain.
+        AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE,
+        // Even data minus the next odd data, SWV forward minus reverse. A batch holds whole periods.
+        AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT_DIFFERENCE,
     } flag;
-    uint16_t fifo_count;
-    uint16_t adc_data_index;
-    uint16_t adc_data_length;
-    uint32_t fifo_buffer[FIFO_BUFFER_SIZE];
+    uint32_t id;                // ID of the measurement, see AD5940_TASK_COMMAND_queue_measurement.
+    uint16_t fifo_count;        // Samples in fifo_buffer, a batch drained by one interrupt.
+    uint16_t adc_data_index;    // Index of fifo_buffer[0] among the samples of its flag in the measurement.
+    uint32_t *fifo_buffer;      // Points into the sample ring, valid until the result is released.
 } AD5940_TASK_ADC_RESULT;
 
+typedef struct
+{
+    uint32_t dropped_batches;   // Batches read from the AD5940 but lost because the ring was full.
+    uint32_t dropped_samples;
+    uint32_t max_used_samples;  // Highest fill of the ring.
+} AD5940_TASK_ADC_QUENE_STATISTICS;
+
 // ==================================================
 // PORT
 int AD5940_TASK_ADC_get_access_length_lock(void);
 int AD5940_TASK_ADC_release_access_length_lock(void);
 
+// Producer, the ADC task.
+// Returns room for `length` samples in the ring, or a scratch buffer if the ring stays full, never NULL.
+uint32_t *AD5940_TASK_ADC_reserve_quene(const uint16_t length);
+// Publishes the reserved samples, adc_result->fifo_buffer must be the reservation.
+// Returns non-zero if the reservation was the scratch buffer and the batch is dropped.
 int AD5940_TASK_ADC_put_quene(const AD5940_TASK_ADC_RESULT *const adc_result);
+
+// Consumer, one thread only.
 int AD5940_TASK_ADC_take_quene(AD5940_TASK_ADC_RESULT *const adc_result);
+int AD5940_TASK_ADC_release_quene(const AD5940_TASK_ADC_RESULT *const adc_result);
+
+int AD5940_TASK_ADC_get_quene_statistics(AD5940_TASK_ADC_QUENE_STATISTICS *const statistics);
 
 int AD5940_TASK_ADC_wait_ad5940_intc_triggered(void);
+
+// Given once per measurement by the ADC task, after the last sample is queued or the measurement is stopped.
+int AD5940_TASK_ADC_wait_measurement_done(void);
+int AD5940_TASK_ADC_trigger_measurement_done(void);
 // ==================================================
 
 typedef struct
@@ -62,10 +92,24 @@ typedef enum {
 
 AD5940_TASK_ADC_STATE AD5940_TASK_ADC_get_state(void);
 
+/**
+ * @brief Waits for the next batch of samples.
+ * 
+ * The samples are read in place, AD5940_TASK_ADC_release_result_quene must be called
+ * before the next take so the ADC task can reuse their room.
+ */
 int AD5940_TASK_ADC_take_result_quene(
     AD5940_TASK_ADC_RESULT *const result
 );
 
+int AD5940_TASK_ADC_release_result_quene(
+    const AD5940_TASK_ADC_RESULT *const result
+);
+
+int AD5940_TASK_ADC_get_result_quene_statistics(
+    AD5940_TASK_ADC_QUENE_STATISTICS *const statistics
+);
+
 #ifdef __cplusplus
 }
 #endif
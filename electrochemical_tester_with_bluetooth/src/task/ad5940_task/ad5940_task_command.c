@@ -1,34 +1,168 @@
 #include "ad5940_task_command.h"
 
+#include <errno.h>
 #include <stdatomic.h>
+#include <string.h>
 #include <math.h>
 
 #include "ad5940_task_private.h"
 
 #include "ad5940_temperature.h"
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+#include "ad5940_electrochemical_utility_temperature.h"
+#endif
 
 #include "ad5940_electrochemical_ca.h"
 #include "ad5940_electrochemical_cv.h"
 #include "ad5940_electrochemical_dpv.h"
+#ifdef AD5940_TASK_SWV_LSV
+#include "ad5940_electrochemical_swv.h"
+#include "ad5940_electrochemical_lsv.h"
+#endif
 
 static const AD5940_TASK_COMMAND_CFG *_cfg;
 static volatile _Atomic AD5940_TASK_COMMAND_STATE _state = AD5940_TASK_COMMAND_STATE_UNINITIALIZED;
 
+typedef struct
+{
+    uint32_t id;
+    uint8_t priority;
+    AD5940_TASK_MEASUREMENT_PARAM param;
+} _QUENE_ENTRY;
+
+/**
+ * Protected by the measurement param lock, the running measurement too.
+ * Sorted by priority, the first entry runs next.
+ */
+static _QUENE_ENTRY _quene[AD5940_TASK_COMMAND_QUENE_LENGTH];
+static uint8_t _quene_length = 0;
+
 static AD5940_TASK_MEASUREMENT_PARAM measurement_param;
+static uint32_t _running_id;
+static BoolFlag _is_running = bFALSE;
+static BoolFlag _is_running_canceled = bFALSE;
 
 AD5940_TASK_COMMAND_STATE AD5940_TASK_COMMAND_get_state(void)
 {
     return atomic_load(&_state);
 }
 
+static void _notify_measured(
+    const uint32_t id,
+    const AD5940_TASK_COMMAND_MEASUREMENT_STATUS status
+)
+{
+    if(_cfg != NULL && _cfg->callback.measured != NULL)
+    {
+        _cfg->callback.measured(id, status);
+    }
+}
+
+static void _remove_quene_entry(const uint8_t index)
+{
+    memmove(
+        &_quene[index],
+        &_quene[index + 1],
+        (_quene_length - index - 1) * sizeof(_QUENE_ENTRY)
+    );
+    _quene_length--;
+}
+
+int AD5940_TASK_COMMAND_queue_measurement(
+    const AD5940_TASK_MEASUREMENT_PARAM *const param,
+    const uint32_t id,
+    const uint8_t priority
+)
+{
+    AD5940_TASK_COMMAND_get_access_measurement_param_lock();
+    if(_quene_length >= AD5940_TASK_COMMAND_QUENE_LENGTH)
+    {
+        AD5940_TASK_COMMAND_release_access_measurement_param_lock();
+        return -ENOMEM;
+    }
+    // Behind every entry of the same or a higher priority.
+    uint8_t index = _quene_length;
+    while(index > 0 && _quene[index - 1].priority < priority) index--;
+    memmove(
+        &_quene[index + 1],
+        &_quene[index],
+        (_quene_length - index) * sizeof(_QUENE_ENTRY)
+    );
+    _quene[index] = (_QUENE_ENTRY) {
+        .id = id,
+        .priority = priority,
+        .param = *param,
+    };
+    _quene_length++;
+    AD5940_TASK_COMMAND_release_access_measurement_param_lock();
+
+    AD5940_TASK_COMMAND_trigger_measurement();
+    return 0;
+}
+
 int AD5940_TASK_COMMAND_measure(
     const AD5940_TASK_MEASUREMENT_PARAM *const param
 )
 {
+    return AD5940_TASK_COMMAND_queue_measurement(
+        param,
+        0,
+        AD5940_TASK_COMMAND_PRIORITY_DEFAULT
+    );
+}
+
+int AD5940_TASK_COMMAND_cancel(
+    const uint32_t id
+)
+{
+    uint8_t canceled = 0;
+
     AD5940_TASK_COMMAND_get_access_measurement_param_lock();
-    measurement_param = *param;
+    for(uint8_t i=0; i<_quene_length;)
+    {
+        if(_quene[i].id != id)
+        {
+            i++;
+            continue;
+        }
+        _remove_quene_entry(i);
+        canceled++;
+    }
+    const BoolFlag is_running_canceled = (_is_running == bTRUE && _running_id == id) ? bTRUE : bFALSE;
+    if(is_running_canceled == bTRUE)
+    {
+        // Notified by the command thread once the ADC task lets the measurement go.
+        _is_running_canceled = bTRUE;
+        AD5940_TASK_ADC_stop();
+    }
     AD5940_TASK_COMMAND_release_access_measurement_param_lock();
-    AD5940_TASK_COMMAND_trigger_measurement();
+
+    for(uint8_t i=0; i<canceled; i++)
+    {
+        _notify_measured(id, AD5940_TASK_COMMAND_MEASUREMENT_STATUS_CANCELED);
+    }
+    return (canceled > 0 || is_running_canceled == bTRUE) ? 0 : -ENOENT;
+}
+
+int AD5940_TASK_COMMAND_cancel_all(void)
+{
+    uint32_t ids[AD5940_TASK_COMMAND_QUENE_LENGTH];
+
+    AD5940_TASK_COMMAND_get_access_measurement_param_lock();
+    const uint8_t canceled = _quene_length;
+    for(uint8_t i=0; i<canceled; i++)
+    {
+        ids[i] = _quene[i].id;
+    }
+    _quene_length = 0;
+    if(_is_running == bTRUE) _is_running_canceled = bTRUE;
+    AD5940_TASK_ADC_stop();
+    AD5940_TASK_COMMAND_release_access_measurement_param_lock();
+
+    for(uint8_t i=0; i<canceled; i++)
+    {
+        _notify_measured(ids[i], AD5940_TASK_COMMAND_MEASUREMENT_STATUS_CANCELED);
+    }
     return 0;
 }
 
@@ -61,6 +195,258 @@ typedef struct
 
 static _PARAM _param = {};
 
+#ifdef AD5940_TASK_SWV_LSV
+// The waveform engine refills the streamed DAC steps in its interrupt and stops the stream.
+static const AD5940_TASK_ADC_FIFO_HANDLER _swv_fifo_handler = {
+    .interrupt = AD5940_ELECTROCHEMICAL_SWV_interrupt,
+    .stop = AD5940_ELECTROCHEMICAL_SWV_stop,
+};
+
+static const AD5940_TASK_ADC_FIFO_HANDLER _lsv_fifo_handler = {
+    .interrupt = AD5940_ELECTROCHEMICAL_LSV_interrupt,
+    .stop = AD5940_ELECTROCHEMICAL_LSV_stop,
+};
+#endif
+
+/**
+ * @brief Starts measurement_param on the AD5940 and resets the ADC task for it.
+ * 
+ * @param adc_length    Retrieves the number of samples of the measurement.
+ */
+static AD5940Err _start_measurement(
+    uint16_t *const adc_length
+)
+{
+    AD5940Err err = AD5940ERR_OK;
+    *adc_length = 0;
+    uint16_t fifo_thresh;
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+    // Read back by the ADC task for the FIFO data of the measurement, a temperature measurement has none interleaved.
+    AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(
+        (measurement_param.type == AD5940_TASK_TYPE_TEMPERATURE) ? 0 : _cfg->param.electrochemical.temperature_interval
+    );
+#endif
+    switch (measurement_param.type)
+    {
+    case AD5940_TASK_TYPE_TEMPERATURE:
+    {
+        _param.temperature.parameters.sampling_interval = measurement_param.param.temperature.sampling_interval;
+        _param.temperature.parameters.TEMPSENS = measurement_param.param.temperature.TEMPSENS;
+        *adc_length = (uint16_t) round(measurement_param.param.temperature.sampling_time / measurement_param.param.temperature.sampling_interval);
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            measurement_param.param.temperature.sampling_interval,
+            *adc_length
+        );
+        _param.temperature.run_cfg.FIFO_thresh = fifo_thresh;
+        AD5940_TEMPERATURE_START_CONFIG _config = {
+            .analog_cfg = &_param.temperature.analog_cfg,
+            .parameters = &_param.temperature.parameters,
+            .run_cfg = &_param.temperature.run_cfg,
+        };
+        err = AD5940_TEMPERATURE_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE,
+            *adc_length,
+            fifo_thresh,
+            NULL
+        );
+        break;
+    }
+    case AD5940_TASK_TYPE_ELECTROCHEMICAL_CA: 
+    {
+        // ADC length
+        #define CA_FIFO_THRESH(t_interval, t_run) (round(t_run / t_interval) + 1)
+        *adc_length = CA_FIFO_THRESH(
+            measurement_param.param.electrochemical.parameters.ca.ad5940_parameters.t_interval, 
+            measurement_param.param.electrochemical.parameters.ca.t_run
+        );
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            measurement_param.param.electrochemical.parameters.ca.ad5940_parameters.t_interval,
+            *adc_length
+        );
+        _param.electrochemical.run_config.FifoThresh = fifo_thresh;
+
+        AD5940_ELECTROCHEMICAL_CA_CONFIG _config = {
+            .parameters = &measurement_param.param.electrochemical.parameters.ca.ad5940_parameters,
+            .run = &_param.electrochemical.run_config,
+            .path_type = 1,
+            .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
+        };
+
+        err = AD5940_ELECTROCHEMICAL_CA_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
+            *adc_length,
+            fifo_thresh,
+            NULL
+        );
+        break;
+    }
+    case AD5940_TASK_TYPE_ELECTROCHEMICAL_CV: 
+    {
+        // ADC length
+        err = AD5940_ELECTROCHEMICAL_CV_get_fifo_count(
+            &measurement_param.param.electrochemical.parameters.cv.ad5940_parameters,
+            adc_length
+        );
+        if(err != AD5940ERR_OK) break;
+        *adc_length *= measurement_param.param.electrochemical.parameters.cv.number_of_scans;
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            measurement_param.param.electrochemical.parameters.cv.ad5940_parameters.E_step
+                / (float) measurement_param.param.electrochemical.parameters.cv.ad5940_parameters.scan_rate,
+            *adc_length
+        );
+        _param.electrochemical.run_config.FifoThresh = fifo_thresh;
+
+        AD5940_ELECTROCHEMICAL_CV_CONFIG _config = {
+            .parameters = &measurement_param.param.electrochemical.parameters.cv.ad5940_parameters,
+            .run = &_param.electrochemical.run_config,
+            .path_type = 1,
+            .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
+        };
+
+        err = AD5940_ELECTROCHEMICAL_CV_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
+            *adc_length,
+            fifo_thresh,
+            NULL
+        );
+        break;
+    }
+    case AD5940_TASK_TYPE_ELECTROCHEMICAL_DPV: 
+    {
+        // ADC length
+        err = AD5940_ELECTROCHEMICAL_DPV_get_fifo_count(
+            &measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters,
+            adc_length
+        );
+        if(err != AD5940ERR_OK) break;
+        // Two data per step, the base and the pulse.
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters.E_step
+                / (float) measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters.scan_rate / 2,
+            *adc_length
+        );
+        _param.electrochemical.run_config.FifoThresh = fifo_thresh;
+
+        AD5940_ELECTROCHEMICAL_DPV_CONFIG _config = {
+            .parameters = &measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters,
+            .run = &_param.electrochemical.run_config,
+            .path_type = 1,
+            .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
+        };
+
+        err = AD5940_ELECTROCHEMICAL_DPV_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
+            *adc_length,
+            fifo_thresh,
+            NULL
+        );
+        break;
+    }
+#ifdef AD5940_TASK_SWV_LSV
+    case AD5940_TASK_TYPE_ELECTROCHEMICAL_SWV: 
+    {
+        // ADC length, a forward and a reverse sample per period
+        err = AD5940_ELECTROCHEMICAL_SWV_get_fifo_count(
+            &measurement_param.param.electrochemical.parameters.swv.ad5940_parameters,
+            adc_length
+        );
+        if(err != AD5940ERR_OK) break;
+        // Two data per period, the forward and the reverse pulse.
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            0.5F / measurement_param.param.electrochemical.parameters.swv.ad5940_parameters.frequency,
+            *adc_length
+        );
+        _param.electrochemical.run_config.FifoThresh = fifo_thresh;
+
+        AD5940_ELECTROCHEMICAL_SWV_CONFIG _config = {
+            .parameters = &measurement_param.param.electrochemical.parameters.swv.ad5940_parameters,
+            .run = &_param.electrochemical.run_config,
+            .path_type = 1,
+            .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
+        };
+
+        err = AD5940_ELECTROCHEMICAL_SWV_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT_DIFFERENCE,
+            *adc_length,
+            fifo_thresh,
+            &_swv_fifo_handler
+        );
+        break;
+    }
+    case AD5940_TASK_TYPE_ELECTROCHEMICAL_LSV: 
+    {
+        // ADC length
+        err = AD5940_ELECTROCHEMICAL_LSV_get_fifo_count(
+            &measurement_param.param.electrochemical.parameters.lsv.ad5940_parameters,
+            adc_length
+        );
+        if(err != AD5940ERR_OK) break;
+        fifo_thresh = AD5940_TASK_ADC_get_FIFO_thresh(
+            measurement_param.param.electrochemical.parameters.lsv.ad5940_parameters.E_step
+                / (float) measurement_param.param.electrochemical.parameters.lsv.ad5940_parameters.scan_rate,
+            *adc_length
+        );
+        _param.electrochemical.run_config.FifoThresh = fifo_thresh;
+
+        AD5940_ELECTROCHEMICAL_LSV_CONFIG _config = {
+            .parameters = &measurement_param.param.electrochemical.parameters.lsv.ad5940_parameters,
+            .run = &_param.electrochemical.run_config,
+            .path_type = 1,
+            .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
+        };
+
+        err = AD5940_ELECTROCHEMICAL_LSV_start(
+            &_config
+        );
+        if(err != AD5940ERR_OK) return err;
+
+        AD5940_TASK_ADC_reset(
+            _running_id,
+            AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
+            *adc_length,
+            fifo_thresh,
+            &_lsv_fifo_handler
+        );
+        break;
+    }
+#endif
+    default:
+        break;
+    }
+
+    return err;
+}
+
 AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
 {
     int err = 0;
@@ -110,7 +496,11 @@ AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
             .DftSrc = _cfg->param.electrochemical.DftSrc,
             .HanWinEn = _cfg->param.electrochemical.HanWinEn,
         },
-        .StatCfg = {0},
+        .StatCfg = {
+            .StatDev = _cfg->param.electrochemical.StatDev,
+            .StatEnable = _cfg->param.electrochemical.StatEnable,
+            .StatSample = _cfg->param.electrochemical.StatSample,
+        },
     };
 
     _param.electrochemical.run_config = (AD5940_ELECTROCHEMICAL_RUN_CONFIG) {
@@ -119,7 +509,7 @@ AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
         .LFOSCClkFreq = _cfg->param.electrochemical.lfoscFrequency,
         .DataType = _cfg->param.electrochemical.DataType,
         .FifoSrc = _cfg->param.electrochemical.FifoSrc,
-        .FifoThresh = ADC_SAMPLE_UNIT,
+        .FifoThresh = 1,    // Set for every measurement by AD5940_TASK_ADC_get_FIFO_thresh.
     };
 
     _param.electrochemical.lpdac_to_lptia_config = (AD5940_ELECTROCHEMICAL_LPDAC_TO_LPTIA_CONFIG) {
@@ -164,7 +554,7 @@ AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
         .run_cfg = {
             .agpio_cfg = &_cfg->param.common.agpio_cfg,
             .clock_cfg = &_cfg->param.electrochemical.clockConfig,
-            .FIFO_thresh = ADC_SAMPLE_UNIT,
+            .FIFO_thresh = 1,   // Set for every measurement by AD5940_TASK_ADC_get_FIFO_thresh.
             .LFOSC_frequency = _cfg->param.electrochemical.lfoscFrequency,
         },
     };
@@ -187,113 +577,22 @@ AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
             _cfg->callback.start();
         }
 
+        // Empty if the measurements were canceled.
+        uint32_t id = 0;
+        uint16_t adc_length = 0;
+        AD5940Err start_err = AD5940ERR_OK;
         AD5940_TASK_COMMAND_get_access_measurement_param_lock();
-
-        uint16_t adc_length;
-        switch (measurement_param.type)
+        if(_quene_length > 0)
         {
-        case AD5940_TASK_TYPE_TEMPERATURE:
-        {
-            _param.temperature.parameters.sampling_interval = measurement_param.param.temperature.sampling_interval;
-            _param.temperature.parameters.TEMPSENS = measurement_param.param.temperature.TEMPSENS;
-            AD5940_TEMPERATURE_START_CONFIG _config = {
-                .analog_cfg = &_param.temperature.analog_cfg,
-                .parameters = &_param.temperature.parameters,
-                .run_cfg = &_param.temperature.run_cfg,
-            };
-            err = AD5940_TEMPERATURE_start(
-                &_config
-            );
-            if(err != AD5940ERR_OK) return err;
-            AD5940_TASK_ADC_reset(
-                AD5940_TASK_ADC_RESULT_FLAG_TEMPERATURE,
-                (uint16_t) round(measurement_param.param.temperature.sampling_time / measurement_param.param.temperature.sampling_interval)
-            );
-            break;
+            id = _quene[0].id;
+            measurement_param = _quene[0].param;
+            _remove_quene_entry(0);
+            _running_id = id;
+            _is_running = bTRUE;
+            _is_running_canceled = bFALSE;
+            start_err = _start_measurement(&adc_length);
         }
-        case AD5940_TASK_TYPE_ELECTROCHEMICAL_CA: 
-        {
-            AD5940_ELECTROCHEMICAL_CA_CONFIG _config = {
-                .parameters = &measurement_param.param.electrochemical.parameters.ca.ad5940_parameters,
-                .run = &_param.electrochemical.run_config,
-                .path_type = 1,
-                .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
-            };
-
-            err = AD5940_ELECTROCHEMICAL_CA_start(
-                &_config
-            );
-            if(err != AD5940ERR_OK) return err;
-
-            // ADC length
-            #define CA_FIFO_THRESH(t_interval, t_run) (round(t_run / t_interval) + 1)
-            adc_length = CA_FIFO_THRESH(
-                measurement_param.param.electrochemical.parameters.ca.ad5940_parameters.t_interval, 
-                measurement_param.param.electrochemical.parameters.ca.t_run
-            );
-            AD5940_TASK_ADC_reset(
-                AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
-                adc_length
-            );
-            break;
-        }
-        case AD5940_TASK_TYPE_ELECTROCHEMICAL_CV: 
-        {
-            AD5940_ELECTROCHEMICAL_CV_CONFIG _config = {
-                .parameters = &measurement_param.param.electrochemical.parameters.cv.ad5940_parameters,
-                .run = &_param.electrochemical.run_config,
-                .path_type = 1,
-                .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
-            };
-
-            err = AD5940_ELECTROCHEMICAL_CV_start(
-                &_config
-            );
-            if(err != AD5940ERR_OK) return err;
-
-            // ADC length
-            err = AD5940_ELECTROCHEMICAL_CV_get_fifo_count(
-                &measurement_param.param.electrochemical.parameters.cv.ad5940_parameters,
-                &adc_length
-            );
-            if(err != AD5940ERR_OK) break;
-            adc_length *= measurement_param.param.electrochemical.parameters.cv.number_of_scans;
-            AD5940_TASK_ADC_reset(
-                AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
-                adc_length
-            );
-            break;
-        }
-        case AD5940_TASK_TYPE_ELECTROCHEMICAL_DPV: 
-        {
-            AD5940_ELECTROCHEMICAL_DPV_CONFIG _config = {
-                .parameters = &measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters,
-                .run = &_param.electrochemical.run_config,
-                .path_type = 1,
-                .path.lpdac_to_hstia = &_param.electrochemical.lpdac_to_hstia_config,
-            };
-
-            err = AD5940_ELECTROCHEMICAL_DPV_start(
-                &_config
-            );
-            if(err != AD5940ERR_OK) return err;
-
-            // ADC length
-            err = AD5940_ELECTROCHEMICAL_DPV_get_fifo_count(
-                &measurement_param.param.electrochemical.parameters.dpv.ad5940_parameters,
-                &adc_length
-            );
-            if(err != AD5940ERR_OK) break;
-            AD5940_TASK_ADC_reset(
-                AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT,
-                adc_length
-            );
-            break;
-        }
-        default:
-            break;
-        }
-        
+        const BoolFlag is_running = _is_running;
         AD5940_TASK_COMMAND_release_access_measurement_param_lock();
 
         atomic_store(&_state, AD5940_TASK_COMMAND_STATE_IDLE);
@@ -303,6 +602,32 @@ AD5940Err AD5940_TASK_COMMAND_run(AD5940_TASK_COMMAND_CFG *const cfg)
         {
             _cfg->callback.end();
         }
+
+        if(is_running == bFALSE) continue;
+
+        /**
+         * Waits for the ADC task to read the last sample, the next queued measurement
+         * is started right after. The thread is idle meanwhile, it only blocks.
+         */
+        AD5940Err adc_err = AD5940ERR_OK;
+        if(start_err == AD5940ERR_OK && adc_length > 0)
+        {
+            err = AD5940_TASK_ADC_wait_measurement_done();
+            if (err) {
+                atomic_store(&_state, AD5940_TASK_COMMAND_STATE_ERROR);
+                for(;;) {}
+            }
+            adc_err = AD5940_TASK_ADC_get_measurement_err();
+        }
+
+        AD5940_TASK_COMMAND_get_access_measurement_param_lock();
+        AD5940_TASK_COMMAND_MEASUREMENT_STATUS status = AD5940_TASK_COMMAND_MEASUREMENT_STATUS_DONE;
+        if(_is_running_canceled == bTRUE) status = AD5940_TASK_COMMAND_MEASUREMENT_STATUS_CANCELED;
+        else if(start_err != AD5940ERR_OK || adc_err != AD5940ERR_OK) status = AD5940_TASK_COMMAND_MEASUREMENT_STATUS_ERROR;
+        _is_running = bFALSE;
+        AD5940_TASK_COMMAND_release_access_measurement_param_lock();
+
+        _notify_measured(id, status);
 	}
 
     return err;
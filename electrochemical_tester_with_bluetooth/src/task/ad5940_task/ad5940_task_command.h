@@ -13,6 +13,7 @@ extern "C"
 int AD5940_TASK_COMMAND_get_access_measurement_param_lock(void);
 int AD5940_TASK_COMMAND_release_access_measurement_param_lock(void);
 
+// Counted, given once per queued measurement.
 int AD5940_TASK_COMMAND_wait_measurement(void);
 int AD5940_TASK_COMMAND_trigger_measurement(void);
 
@@ -24,6 +25,10 @@ typedef enum {
     AD5940_TASK_TYPE_ELECTROCHEMICAL_CA,
     AD5940_TASK_TYPE_ELECTROCHEMICAL_CV,
     AD5940_TASK_TYPE_ELECTROCHEMICAL_DPV,
+#ifdef AD5940_TASK_SWV_LSV
+    AD5940_TASK_TYPE_ELECTROCHEMICAL_SWV,
+    AD5940_TASK_TYPE_ELECTROCHEMICAL_LSV,
+#endif
 } AD5940_TASK_TYPE;
 
 // ==================================================
@@ -32,6 +37,10 @@ typedef enum {
 #include "ad5940_electrochemical_ca.h"
 #include "ad5940_electrochemical_cv.h"
 #include "ad5940_electrochemical_dpv.h"
+#ifdef AD5940_TASK_SWV_LSV
+#include "ad5940_electrochemical_swv.h"
+#include "ad5940_electrochemical_lsv.h"
+#endif
 #include "ad5940_electrochemical_eis.h"
 
 typedef struct 
@@ -54,10 +63,35 @@ typedef struct
 } 
 AD5940_TASK_ELECTROCHEMICAL_DPV;
 
+#ifdef AD5940_TASK_SWV_LSV
+/**
+ * The forward minus reverse currents are sent, see AD5940_TASK_ADC_RESULT_FLAG_HSTIA_VOLT_TO_CURRENT_DIFFERENCE.
+ */
+typedef struct 
+{
+    AD5940_ELECTROCHEMICAL_SWV_PARAMETERS ad5940_parameters;
+} 
+AD5940_TASK_ELECTROCHEMICAL_SWV;
+
+typedef struct 
+{
+    AD5940_ELECTROCHEMICAL_LSV_PARAMETERS ad5940_parameters;
+} 
+AD5940_TASK_ELECTROCHEMICAL_LSV;
+#endif
+
+/**
+ * Received as is from BLE, the SWV and LSV parameters are smaller than the DPV ones
+ * so the size of the union and the packet layout don't depend on AD5940_TASK_SWV_LSV.
+ */
 typedef union {
     AD5940_TASK_ELECTROCHEMICAL_CA ca;
     AD5940_TASK_ELECTROCHEMICAL_CV cv;
     AD5940_TASK_ELECTROCHEMICAL_DPV dpv;
+#ifdef AD5940_TASK_SWV_LSV
+    AD5940_TASK_ELECTROCHEMICAL_SWV swv;
+    AD5940_TASK_ELECTROCHEMICAL_LSV lsv;
+#endif
 } AD5940_TASK_ELECTROCHEMICAL_PARAMETERS_UNION;
 
 // ==================================================
@@ -96,6 +130,24 @@ typedef struct
 
         BoolFlag HanWinEn;
 
+        /**
+         * Statistics block, refer to @ref STATSAMPLE_Const and @ref STATDEV_Const.
+         * If enabled, FifoSrc has to be FIFOSRC_MEAN and DataType DATATYPE_SINC2,
+         * one mean of StatSample conversions per DAC step.
+         */
+        BoolFlag StatEnable;
+        uint32_t StatSample;
+        uint32_t StatDev;
+
+#ifdef AD5940_TASK_TEMPERATURE_INTERLEAVE
+        /**
+         * ADC data per temperature data, 0 disables it, see AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval.
+         * The temperatures come as AD5940_TASK_ADC_RESULT_FLAG_SCAN_TEMPERATURE results of the measurement.
+         * Defined by the build when the linked AD5940 library has the temperature utility.
+         */
+        uint8_t temperature_interval;
+#endif
+
         uint32_t LpAmpPwrMod;
 
         BoolFlag BpNotch;
@@ -126,10 +178,21 @@ typedef struct
     } temperature;
 } AD5940_TASK_COMMAND_PARAM;
 
+typedef enum {
+    AD5940_TASK_COMMAND_MEASUREMENT_STATUS_DONE,        // The last sample is queued by the ADC task.
+    AD5940_TASK_COMMAND_MEASUREMENT_STATUS_CANCELED,
+    AD5940_TASK_COMMAND_MEASUREMENT_STATUS_ERROR,       // The measurement couldn't be started or its FIFO couldn't be read.
+} AD5940_TASK_COMMAND_MEASUREMENT_STATUS;
+
 typedef struct
 {
     void (*start)(void);
     void (*end)(void);
+    /**
+     * Called once per queued measurement from the command thread,
+     * or from the thread cancelling a measurement still in the queue.
+     */
+    void (*measured)(uint32_t id, AD5940_TASK_COMMAND_MEASUREMENT_STATUS status);
 } AD5940_TASK_COMMAND_CALLBACK;
 
 typedef struct
@@ -164,10 +227,51 @@ typedef struct {
     } param;
 } AD5940_TASK_MEASUREMENT_PARAM;
 
+// Measurements waiting for the running one.
+#define AD5940_TASK_COMMAND_QUENE_LENGTH 8
+
+#define AD5940_TASK_COMMAND_PRIORITY_DEFAULT 0
+
+/**
+ * @brief Queues a measurement.
+ * 
+ * Measurements of a higher priority run first, the same priority in the order they are queued.
+ * A measurement starts as soon as the ADC task has read the last sample of the previous one.
+ * 
+ * @param id        Tags the samples of the measurement, see AD5940_TASK_ADC_RESULT, it doesn't have to be unique.
+ * @param priority  Higher runs first.
+ * 
+ * @return 0, or -ENOMEM if AD5940_TASK_COMMAND_QUENE_LENGTH measurements are waiting already.
+ */
+int AD5940_TASK_COMMAND_queue_measurement(
+    const AD5940_TASK_MEASUREMENT_PARAM *const param,
+    const uint32_t id,
+    const uint8_t priority
+);
+
+/**
+ * @brief Queues a measurement with the ID 0 and the default priority.
+ */
 int AD5940_TASK_COMMAND_measure(
     const AD5940_TASK_MEASUREMENT_PARAM *const param
 );
 
+/**
+ * @brief Cancels the queued and the running measurements of an ID.
+ * 
+ * The running one is stopped and the AFE shut down, its samples read so far are kept in the ADC queue.
+ * 
+ * @return 0, or -ENOENT if no measurement has the ID.
+ */
+int AD5940_TASK_COMMAND_cancel(
+    const uint32_t id
+);
+
+/**
+ * @brief Cancels every measurement and shuts the AFE down, even if no measurement runs.
+ */
+int AD5940_TASK_COMMAND_cancel_all(void);
+
 #ifdef __cplusplus
 }
 #endif
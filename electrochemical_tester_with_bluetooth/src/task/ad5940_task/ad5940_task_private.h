@@ -8,11 +8,73 @@ extern "C"
 #include "ad5940_task_adc.h"
 #include "ad5940_task_command.h"
 
+/**
+ * @brief Chooses the FIFO threshold of a measurement.
+ * 
+ * As many samples as arrive in 1 / ADC_INTERRUPT_RATE seconds, at least 1 and
+ * at most ADC_SAMPLE_UNIT_MAX or the length of the measurement.
+ * 
+ * @param sample_interval   Seconds between two samples.
+ * @param length            Number of samples of the measurement.
+ */
+uint16_t AD5940_TASK_ADC_get_FIFO_thresh(
+    float sample_interval,
+    uint16_t length
+);
+
+/**
+ * FIFO reads of a technique that serves its own interrupts, e.g. AD5940_ELECTROCHEMICAL_SWV_interrupt
+ * and AD5940_ELECTROCHEMICAL_SWV_stop. Both read the FIFO into the buffer and retrieve the number of data.
+ */
+typedef struct
+{
+    // Called once per interrupt, it keeps the FIFO threshold and shuts the AFE down after the last data.
+    AD5940Err (*interrupt)(
+        uint32_t *const MCU_FIFO_buffer,
+        const uint16_t MCU_FIFO_buffer_max_length,
+        uint16_t *const AD5940_FIFO_count
+    );
+    // Reads the data left and shuts the AFE down.
+    AD5940Err (*stop)(
+        uint32_t *const MCU_FIFO_buffer,
+        const uint16_t MCU_FIFO_buffer_max_length,
+        uint16_t *const AD5940_FIFO_count
+    );
+} AD5940_TASK_ADC_FIFO_HANDLER;
+
+/**
+ * @param id            Copied into every result of the measurement.
+ * @param length        Number of ADC data of the measurement. With AD5940_TASK_TEMPERATURE_INTERLEAVE, the temperature
+ *                      data interleaved by AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval come on top.
+ * @param fifo_thresh   FIFO threshold the measurement is started with, see AD5940_TASK_ADC_get_FIFO_thresh.
+ * @param handler       Reads the FIFO of the measurement, NULL for AD5940_irq_handler and the FIFO threshold.
+ */
 int AD5940_TASK_ADC_reset(
+    uint32_t id,
     uint8_t flag,
-    uint16_t length
+    uint16_t length,
+    uint16_t fifo_thresh,
+    const AD5940_TASK_ADC_FIFO_HANDLER *const handler
 );
 
+/**
+ * @brief Stops the measurement and shuts the AFE down, through the stop of its FIFO handler if it has one.
+ * 
+ * The data still in the FIFO are discarded.
+ * 
+ * AD5940_TASK_ADC_trigger_measurement_done is called if a measurement was running.
+ */
+int AD5940_TASK_ADC_stop(void);
+
+/**
+ * @brief Error of the last measurement's FIFO reads.
+ * 
+ * The ADC task stops a measurement at the first read that fails and triggers its measurement done.
+ * 
+ * @return AD5940ERR_OK if every read succeeded, otherwise the error of the failed one.
+ */
+AD5940Err AD5940_TASK_ADC_get_measurement_err(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,13 +1,11 @@
 #include "command_receiver.h"
 
+#include <errno.h>
 #include <stdatomic.h>
+#include <string.h>
 
 #include "ad5940_task_command.h"
 
-#include "kernel_sleep.h"
-
-#include "ad5940_utils.h"
-
 static const COMMAND_RECEIVER_CFG *_cfg;
 static volatile _Atomic COMMAND_RECEIVER_STATE _state = COMMAND_RECEIVER_STATE_UNINITIALIZED;
 
@@ -16,13 +14,57 @@ COMMAND_RECEIVER_STATE COMMAND_RECEIVER_get_state(void)
     return atomic_load(&_state);
 }
 
+/**
+ * @return 0, or -ENOTSUP if the AD5940 task has no such measurement.
+ */
 static int _map_type_from_receiver_to_ad5940_task(
     const COMMAND_RECEIVER_START_TYPE origin,
     AD5940_TASK_TYPE *const new
 )
 {
-    *new = (AD5940_TASK_TYPE) origin;
-    return 0;
+    switch (origin)
+    {
+    case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CA:
+        *new = AD5940_TASK_TYPE_ELECTROCHEMICAL_CA;
+        return 0;
+    case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CV:
+        *new = AD5940_TASK_TYPE_ELECTROCHEMICAL_CV;
+        return 0;
+    case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_DPV:
+        *new = AD5940_TASK_TYPE_ELECTROCHEMICAL_DPV;
+        return 0;
+#ifdef AD5940_TASK_SWV_LSV
+    case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_SWV:
+        *new = AD5940_TASK_TYPE_ELECTROCHEMICAL_SWV;
+        return 0;
+    case COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_LSV:
+        *new = AD5940_TASK_TYPE_ELECTROCHEMICAL_LSV;
+        return 0;
+#endif
+    default:
+        return -ENOTSUP;
+    }
+}
+
+/**
+ * @brief Tells the client that a command failed, none of its measurements run.
+ */
+static int _send_error(
+    const COMMAND_RECEIVER_START *const start,
+    const int error
+)
+{
+    const int32_t error_code = error;
+    uint8_t response[1 + 1 + sizeof(start->param.electrochemical.id) + sizeof(error_code)];
+    uint8_t *p = response;
+
+    *p++ = COMMAND_RECEIVER_RESPONSE_ERROR;
+    *p++ = (uint8_t) start->type;
+    memcpy(p, &start->param.electrochemical.id, sizeof(start->param.electrochemical.id));
+    p += sizeof(start->param.electrochemical.id);
+    memcpy(p, &error_code, sizeof(error_code));
+
+    return COMMAND_RECEIVER_send_response(response, sizeof(response));
 }
 
 int COMMAND_RECEIVER_run(
@@ -55,12 +97,24 @@ int COMMAND_RECEIVER_run(
 
         if(start.type == COMMAND_RECEIVER_START_TYPE_STOP)
         {
-            AD5940_shutdown_afe_lploop_hsloop_dsp();
+            AD5940_TASK_COMMAND_cancel_all();
+        }
+        else if(start.type == COMMAND_RECEIVER_START_TYPE_CANCEL)
+        {
+            AD5940_TASK_COMMAND_cancel(start.param.cancel.id);
         }
         else
         {
+            AD5940_TASK_MEASUREMENT_PARAM param = {};
+            int queue_err = _map_type_from_receiver_to_ad5940_task(
+                start.type,
+                &param.type
+            );
+#ifndef AD5940_TASK_TEMPERATURE_INTERLEAVE
+            // Not interleaved with the measurement, the temperature is measured right before it.
+            if(queue_err == 0)
             {
-                AD5940_TASK_MEASUREMENT_PARAM param = {
+                AD5940_TASK_MEASUREMENT_PARAM temperature = {
                     .type = AD5940_TASK_TYPE_TEMPERATURE,
                     .param.temperature = {
                         .sampling_interval = 0.01,
@@ -68,19 +122,28 @@ int COMMAND_RECEIVER_run(
                         .TEMPSENS = 0,
                     },
                 };
-                AD5940_TASK_COMMAND_measure(&param);
+                queue_err = AD5940_TASK_COMMAND_queue_measurement(
+                    &temperature,
+                    start.param.electrochemical.id,
+                    AD5940_TASK_COMMAND_PRIORITY_DEFAULT
+                );
             }
-            KERNEL_SLEEP_ms(100);
+#endif
+            if(queue_err == 0)
             {
-                AD5940_TASK_MEASUREMENT_PARAM param = {};
-                _map_type_from_receiver_to_ad5940_task(
-                    start.type,
-                    &param.type
-                );
                 param.param.electrochemical.parameters = start.param.electrochemical.parameters;
                 param.param.electrochemical.routing = start.param.electrochemical.routing;
-                AD5940_TASK_COMMAND_measure(&param);
+                queue_err = AD5940_TASK_COMMAND_queue_measurement(
+                    &param,
+                    start.param.electrochemical.id,
+                    AD5940_TASK_COMMAND_PRIORITY_DEFAULT
+                );
+#ifndef AD5940_TASK_TEMPERATURE_INTERLEAVE
+                // The temperature alone is no result for the client, it may be running already.
+                if(queue_err) AD5940_TASK_COMMAND_cancel(start.param.electrochemical.id);
+#endif
             }
+            if(queue_err) _send_error(&start, queue_err);
         }
 
         atomic_store(&_state, COMMAND_RECEIVER_STATE_IDLE);
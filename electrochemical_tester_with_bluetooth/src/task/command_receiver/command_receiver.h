@@ -15,6 +15,10 @@ typedef enum {
     COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CA,
     COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_CV,
     COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_DPV,
+    // Answered with -ENOTSUP unless the build has AD5940_TASK_SWV_LSV.
+    COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_SWV,
+    COMMAND_RECEIVER_START_TYPE_ELECTROCHEMICAL_LSV,
+    COMMAND_RECEIVER_START_TYPE_CANCEL,
 } COMMAND_RECEIVER_START_TYPE;
 
 typedef struct
@@ -24,6 +28,10 @@ typedef struct
         struct {
         } stop;
         struct {
+            uint32_t id;    // The measurements queued with it.
+        } cancel;
+        struct {
+            uint32_t id;    // Entity ID of the host, tags the samples.
             AD5940_TASK_ELECTROCHEMICAL_PARAMETERS_UNION parameters;
             AD5940_ELECTROCHEMICAL_ELECTRODE_ROUTING routing;
         } electrochemical;
@@ -33,8 +41,17 @@ typedef struct
 int COMMAND_RECEIVER_wait_command_received(
     COMMAND_RECEIVER_START *const start
 );
+
+// Sends a packet to the client.
+int COMMAND_RECEIVER_send_response(
+    uint8_t *const command,
+    const uint16_t command_length
+);
 // ==================================================
 
+// First byte of the response sent when a command fails, followed by the command type, its ID and the error.
+#define COMMAND_RECEIVER_RESPONSE_ERROR 0x03
+
 typedef struct
 {
     void (*start)(void);
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Decode the AD5940 SPI trace printed by AD5940_spi_trace_impl_zephyr_dump().
+
+Reads a console log (RTT or UART) and prints per register latency
+histograms of the transfer time and the CS hold time.
+
+    python3 ad5940_spi_trace_decode.py rtt.log
+    python3 ad5940_spi_trace_decode.py --frames rtt.log
+"""
+
+import argparse
+import struct
+import sys
+from collections import defaultdict
+
+PREFIX = "ad5940_spi_trace"
+
+# Keep in sync with AD5940_SPI_TRACE_RECORD
+RECORD = struct.Struct("<IIIIHBB")
+
+COMMANDS = {
+    0x20: "SETADDR",
+    0x6D: "READREG",
+    0x2D: "WRITEREG",
+    0x5F: "READFIFO",
+}
+
+# Upper bounds of the histogram buckets in microseconds
+BUCKETS_US = [5, 10, 20, 50, 100, 200, 500, 1000, 5000]
+
+
+def parse(lines):
+    cycles_per_sec = None
+    dropped = 0
+    records = []
+    for line in lines:
+        line = line.strip()
+        index = line.find(PREFIX)
+        if index < 0:
+            continue
+        fields = line[index + len(PREFIX):].split()
+        if not fields:
+            continue
+        if fields[0] == "begin":
+            cycles_per_sec = int(fields[1])
+        elif fields[0] == "dropped":
+            dropped += int(fields[1])
+        elif fields[0] == "end":
+            continue
+        else:
+            raw = bytes.fromhex(fields[0])
+            if len(raw) != RECORD.size:
+                continue
+            records.append(RECORD.unpack(raw))
+    return cycles_per_sec, dropped, records
+
+
+def histogram(values_us):
+    counts = [0] * (len(BUCKETS_US) + 1)
+    for value in values_us:
+        for i, bound in enumerate(BUCKETS_US):
+            if value <= bound:
+                counts[i] += 1
+                break
+        else:
+            counts[-1] += 1
+    return counts
+
+
+def percentile(values, p):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * p / 100))]
+
+
+def print_summary(cycles_per_sec, records):
+    to_us = 1e6 / cycles_per_sec
+    groups = defaultdict(lambda: ([], []))
+    for _, transfer, hold, _, address, command, _ in records:
+        # SETADDR frames carry the address of the next access, group them with it
+        key = (COMMANDS.get(command, "0x%02X" % command), address)
+        groups[key][0].append(transfer * to_us)
+        groups[key][1].append(hold * to_us)
+
+    header = "<=" + " <=".join(str(b) for b in BUCKETS_US) + " >%d" % BUCKETS_US[-1]
+    print("%-9s %-6s %6s %9s %9s %9s %9s  %s" % (
+        "command", "addr", "count", "avg_us", "p50_us", "p99_us", "max_us", "transfer histogram (us) " + header))
+    for (command, address), (transfer, hold) in sorted(groups.items(), key=lambda item: (item[0][1], item[0][0])):
+        print("%-9s 0x%04X %6d %9.1f %9.1f %9.1f %9.1f  %s" % (
+            command, address, len(transfer),
+            sum(transfer) / len(transfer), percentile(transfer, 50), percentile(transfer, 99), max(transfer),
+            " ".join(str(c) for c in histogram(transfer))))
+        print("%-9s %-6s %6s %9.1f %9.1f %9.1f %9.1f  cs hold %s" % (
+            "", "", "",
+            sum(hold) / len(hold), percentile(hold, 50), percentile(hold, 99), max(hold),
+            " ".join(str(c) for c in histogram(hold))))
+
+
+def print_frames(cycles_per_sec, records):
+    to_us = 1e6 / cycles_per_sec
+    first = records[0][0] if records else 0
+    for timestamp, transfer, hold, data, address, command, length in records:
+        print("%12.1f %-9s 0x%04X 0x%08X len=%3d transfer=%8.1fus hold=%8.1fus" % (
+            ((timestamp - first) & 0xFFFFFFFF) * to_us,
+            COMMANDS.get(command, "0x%02X" % command), address, data, length,
+            transfer * to_us, hold * to_us))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="console log, stdin if omitted")
+    parser.add_argument("--frames", action="store_true", help="print every frame instead of the summary")
+    parser.add_argument("--cycles-per-sec", type=int, help="override the cycle rate of the dump header")
+    args = parser.parse_args()
+
+    stream = open(args.log) if args.log else sys.stdin
+    with stream:
+        cycles_per_sec, dropped, records = parse(stream)
+    cycles_per_sec = args.cycles_per_sec or cycles_per_sec
+    if not cycles_per_sec:
+        sys.exit("no '%s begin' line, pass --cycles-per-sec" % PREFIX)
+    if not records:
+        sys.exit("no trace records found")
+
+    print("%d frames, %d dropped, %d Hz cycle counter" % (len(records), dropped, cycles_per_sec))
+    if args.frames:
+        print_frames(cycles_per_sec, records)
+    else:
+        print_summary(cycles_per_sec, records)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,72 @@
+/* Generated by tools/ad5940_sequence_compiler/generate.sh, do not edit. */
+
+#include "ad5940_compiled_sequences.h"
+
+static const AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER _temperature_0_registers[] = {
+    {0x2000, 0x00091000},
+};
+
+static const uint32_t _temperature_0_commands[] = {
+    0x80091080,
+    0x00000320,
+    0x80093180,
+    0x00000ED3,
+    0x80091100,
+    0x00000014,
+    0xC7000000,
+    0xC7000001,
+};
+
+const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_temperature[] = {
+    {
+        .WaitClks = 3795,
+        .registers = _temperature_0_registers,
+        .registers_length = sizeof(_temperature_0_registers) / sizeof(_temperature_0_registers[0]),
+        .commands = _temperature_0_commands,
+        .commands_length = sizeof(_temperature_0_commands) / sizeof(_temperature_0_commands[0]),
+    },
+};
+const uint16_t AD5940_COMPILED_SEQUENCES_temperature_length = sizeof(AD5940_COMPILED_SEQUENCES_temperature) / sizeof(AD5940_COMPILED_SEQUENCES_temperature[0]);
+
+static const AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER _electrochemical_ADC_0_registers[] = {
+    {0x2000, 0x00080800},
+};
+
+static const uint32_t _electrochemical_ADC_0_commands[] = {
+    0x80090880,
+    0x00000FA0,
+    0x80090980,
+    0x00000ED3,
+    0x80080800,
+};
+
+static const AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER _electrochemical_ADC_1_registers[] = {
+    {0x2000, 0x00080000},
+};
+
+static const uint32_t _electrochemical_ADC_1_commands[] = {
+    0x80090080,
+    0x00000FA0,
+    0x80090180,
+    0x00000ED3,
+    0x80080000,
+};
+
+const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_electrochemical_ADC[] = {
+    {
+        .WaitClks = 3795,
+        .registers = _electrochemical_ADC_0_registers,
+        .registers_length = sizeof(_electrochemical_ADC_0_registers) / sizeof(_electrochemical_ADC_0_registers[0]),
+        .commands = _electrochemical_ADC_0_commands,
+        .commands_length = sizeof(_electrochemical_ADC_0_commands) / sizeof(_electrochemical_ADC_0_commands[0]),
+    },
+    {
+        .WaitClks = 3795,
+        .registers = _electrochemical_ADC_1_registers,
+        .registers_length = sizeof(_electrochemical_ADC_1_registers) / sizeof(_electrochemical_ADC_1_registers[0]),
+        .commands = _electrochemical_ADC_1_commands,
+        .commands_length = sizeof(_electrochemical_ADC_1_commands) / sizeof(_electrochemical_ADC_1_commands[0]),
+    },
+};
+const uint16_t AD5940_COMPILED_SEQUENCES_electrochemical_ADC_length = sizeof(AD5940_COMPILED_SEQUENCES_electrochemical_ADC) / sizeof(AD5940_COMPILED_SEQUENCES_electrochemical_ADC[0]);
+
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+/**
+ * Sequences compiled offline for the fixed `UTL_AD5940_*` parameter sets.
+ * 
+ * @note
+ * `ad5940_compiled_sequences.c` is generated by
+ * `tools/ad5940_sequence_compiler/generate.sh`, regenerate it after changing
+ * the parameter sets or the sequence generators. Parameters without a compiled
+ * sequence still work, their sequences are generated at runtime.
+ */
+
+/**
+ * Temperature sensor sequence, see `ad5940_temperature.c`.
+ */
+extern const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_temperature[];
+extern const uint16_t AD5940_COMPILED_SEQUENCES_temperature_length;
+
+/**
+ * ADC sequence shared by CA, CV and DPV, see `ad5940_electrochemical_utility_sop.c`.
+ */
+extern const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_electrochemical_ADC[];
+extern const uint16_t AD5940_COMPILED_SEQUENCES_electrochemical_ADC_length;
+
+#ifdef __cplusplus
+}
+#endif
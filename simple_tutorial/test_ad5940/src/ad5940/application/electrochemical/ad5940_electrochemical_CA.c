@@ -56,6 +56,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_CA_get_voltages(
 static AD5940Err _write_sequence_commands(
     const ADCFilterCfg_Type *const adc_filter,
     const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
     const AD5940_UTILITY_ClockConfig *const clock,
     uint32_t DataType
 )
@@ -68,6 +69,7 @@ static AD5940Err _write_sequence_commands(
         &sequence_address,
         adc_filter,
         dft,
+        stat,
         clock,
         DataType
     );
@@ -82,8 +84,10 @@ static AD5940Err _start_wakeup_timer_sequence(
     const float LFOSC_frequency
 )
 {
+    AD5940Err error = AD5940ERR_OK;
+
     /* Configure FIFO and Sequencer for normal Amperometric Measurement */
-    AD5940_FIFOThrshSet(parameters->t_run / parameters->t_interval);
+    AD5940_FIFOThrshSet(AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(parameters->t_run / parameters->t_interval));
     AD5940_FIFOCtrlS(FifoSrc, bTRUE);
 
     AD5940_SEQCtrlS(bTRUE);
@@ -100,6 +104,8 @@ static AD5940Err _start_wakeup_timer_sequence(
     wupt_cfg.WuptOrder[0] = ADC_seq_info->SeqId;
     wupt_cfg.SeqxSleepTime[ADC_seq_info->SeqId] = 1; /* The minimum value is 1. Do not set it to zero. Set it to 1 will spend 2 32kHz clock. */
     wupt_cfg.SeqxWakeupTime[ADC_seq_info->SeqId] = (uint32_t)(LFOSC_frequency * parameters->t_interval * 1E-3F) - 1;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&wupt_cfg);
+    if(error != AD5940ERR_OK) return error;
     AD5940_WUPTCfg(&wupt_cfg);
 
     return AD5940ERR_OK;
@@ -137,6 +143,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_CA_start_with_LPTIA(
     error = _write_sequence_commands(
         &(config->utility_DSPCfg_Type->ADCFilterCfg),
         &(config->utility_DSPCfg_Type->DftCfg),
+        &(config->utility_DSPCfg_Type->StatCfg),
         config->clock,
         config->DataType
     );
@@ -204,6 +211,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_CA_start(
     error = _write_sequence_commands(
         &(config->utility_DSPCfg_Type->ADCFilterCfg),
         &(config->utility_DSPCfg_Type->DftCfg),
+        &(config->utility_DSPCfg_Type->StatCfg),
         config->clock,
         config->DataType
     );
@@ -269,10 +277,9 @@ AD5940Err AD5940_ELECTROCHEMICAL_CA_interrupt(
     if(*AD5940_FIFO_count > MCU_FIFO_buffer_max_length) return AD5940ERR_BUFF;
     AD5940_FIFORd(MCU_FIFO_buffer, *AD5940_FIFO_count);
 
-    AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK); /* Unlock so sequencer can put AD5940 to sleep */
-
     if(AD5940_FIFO_new_thresh > 0)
     {
+        AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK); /* Unlock so sequencer can put AD5940 to sleep */
         AD5940_FIFOThrshSet(AD5940_FIFO_new_thresh);
         AD5940_INTCClrFlag(AFEINTSRC_DATAFIFOTHRESH);
         AD5940_EnterSleepS();
@@ -280,6 +287,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_CA_interrupt(
     else
     {
         AD5940_INTCClrFlag(AFEINTSRC_DATAFIFOTHRESH);
+        /* Still locked, so AD5940_UTILITY_shutdown needn't wake AFE up again. It unlocks the key by itself. */
         AD5940_UTILITY_shutdown();
     }
     
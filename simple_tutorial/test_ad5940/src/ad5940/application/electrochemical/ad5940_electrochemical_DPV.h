@@ -191,6 +191,10 @@ AD5940Err AD5940_ELECTROCHEMICAL_DPV_stop(
 /**
  * @brief Handles FIFO interrupts during Differential Pulse Voltammetry (DPV) operation.
  * 
+ * Scans longer than the sequencer SRAM are streamed, the interrupts of the block
+ * refills only return the data read so far. The data always hold whole pulses, starting with
+ * the sample of the pulse, see @ref AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt.
+ * 
  * @param MCU_FIFO_buffer            Pointer to the buffer to store FIFO data.
  * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
  * @param AD5940_FIFO_count          Pointer to retrieve the current FIFO count.
@@ -211,7 +215,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_DPV_interrupt(
  * values based on the provided calibration and configuration parameters. It is used in 
  * Differential Pulse Voltammetry (DPV) experiments.
  * 
- * @param currents              Pointer to an array where the calculated current values (in microamperes) will be stored.
+ * @param currents              Pointer to an array where the calculated current values (in nanoamperes) will be stored.
  * @param currents_length       Pointer to a variable where the number of calculated current values will be stored.
  * @param currents_max_length   Maximum allowable length of the `currents` array..
  * @param adc_data              Pointer to the array of ADC data retrieved from the FIFO.
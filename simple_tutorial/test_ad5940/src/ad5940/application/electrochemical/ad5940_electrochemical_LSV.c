@@ -0,0 +1,194 @@
+#include "ad5940_electrochemical_LSV.h"
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+#include "ad5940_electrochemical_utility.h"
+
+#include <stdlib.h>
+
+#define T_INTERVAL(E_step, scan_rate) (1E3F * ((float) (E_step)) / ((float) scan_rate))
+
+/**
+ * @brief Gets the waveform of the scan, the staircase from E_begin to E_end.
+ */
+static void _get_waveform(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform
+)
+{
+    *waveform = (AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM) {
+        .E_vertices = {
+            parameters->E_begin,
+            parameters->E_end,
+        },
+        .segments_length = 1,
+        .E_step = parameters->E_step,
+        .include_end = bTRUE,
+        .repeat = bFALSE,
+        .E_phases = {0},
+        .phases_length = 1,
+    };
+    return;
+}
+
+static AD5940Err _check_parameters(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters
+)
+{
+    if(parameters->E_step == 0) return AD5940ERR_PARA;
+    if(parameters->scan_rate == 0) return AD5940ERR_PARA;
+    if(T_INTERVAL(parameters->E_step, parameters->scan_rate) <= AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY) return AD5940ERR_PARA;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_times(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    uint32_t *const times,
+    uint16_t *const times_length,
+    const uint16_t times_max_length
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    uint32_t step_number;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+        &waveform,
+        &step_number
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    *times_length = step_number;
+    if(times_max_length < *times_length) return AD5940ERR_PARA;
+    const float t_interval = T_INTERVAL(parameters->E_step, parameters->scan_rate);
+    for(size_t i=0; i<*times_length; i++)
+    {
+        times[i] = (uint32_t) (t_interval * i);
+    }
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_voltages(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    int32_t *const voltages,
+    uint16_t *const voltages_length,
+    const uint16_t voltages_max_length
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_levels(
+        &waveform,
+        voltages,
+        voltages_length,
+        voltages_max_length
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_fifo_count(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    uint16_t *const fifo_count
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    uint32_t step_number;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+        &waveform,
+        &step_number
+    );
+    if(error != AD5940ERR_OK) return error;
+    if(step_number > UINT16_MAX) return AD5940ERR_PARA;
+
+    *fifo_count = step_number;
+    return AD5940ERR_OK;
+}
+
+/**
+ * @brief Gets the scan, every step lasts the step potential at the scan rate.
+ */
+static AD5940Err _get_scan(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan
+)
+{
+    AD5940Err error = AD5940_ELECTROCHEMICAL_LSV_get_fifo_count(
+        parameters,
+        &(scan->fifo_count)
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    _get_waveform(parameters, &(scan->waveform));
+    scan->t_steps[0] = T_INTERVAL(parameters->E_step, parameters->scan_rate);
+    scan->t_steps[1] = T_INTERVAL(parameters->E_step, parameters->scan_rate);
+    scan->fifo_count_first = scan->fifo_count;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_LSV_LPTIA_CONFIG *const config
+)
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN scan;
+    AD5940Err error = _get_scan(config->parameters, &scan);
+    if(error != AD5940ERR_OK) return error;
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG waveform_config = AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG_OF(config);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_start_with_LPTIA(
+        &scan,
+        &waveform_config,
+        config->utility_LPTIACfg_Type
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_start(
+    const AD5940_ELECTROCHEMICAL_LSV_CONFIG *const config
+)
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN scan;
+    AD5940Err error = _get_scan(config->parameters, &scan);
+    if(error != AD5940ERR_OK) return error;
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG waveform_config = AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG_OF(config);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_start(
+        &scan,
+        &waveform_config,
+        config->working_electrode,
+        config->utility_HSTIACfg_Type
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_stop(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count
+    );
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+#include "ad5940_electrochemical_utility.h"
+
+/**
+ * @brief Parameters for the AD5940 Electrochemical Linear Sweep Voltammetry (LSV) operation.
+ *
+ * The staircase from E_begin to E_end is applied once, the current is sampled
+ * at the end of every step.
+ */
+typedef struct
+{
+    int16_t E_begin;    /**< Starting potential of the scan, in millivolts (mV). */
+    int16_t E_end;      /**< Ending potential of the scan, in millivolts (mV). */
+    uint16_t E_step;    /**< Step potential between measurements, in millivolts (mV). */
+    uint16_t scan_rate; /**< Rate of potential change during the scan, in millivolts per second (mV/s).
+                             A step must last longer than the ADC sample delay of 25 ms. */
+}
+AD5940_ELECTROCHEMICAL_LSV_PARAMETERS;
+
+/**
+ * @brief Generates time values for Linear Sweep Voltammetry (LSV) measurements.
+ *
+ * One time value per step, in milliseconds (ms).
+ *
+ * @param parameters            Pointer to the structure containing LSV parameters.
+ * @param times                 Pointer to an array where the calculated time values will be stored.
+ * @param times_length          Pointer to a variable to store the actual number of generated time values.
+ * @param times_max_length      The maximum capacity of the `times` array.
+ *
+ * @return AD5940Err            Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_times(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    uint32_t *const times,
+    uint16_t *const times_length,
+    const uint16_t times_max_length
+);
+
+/**
+ * @brief Generates voltage values for Linear Sweep Voltammetry (LSV) measurements.
+ *
+ * @param parameters            Pointer to the structure containing LSV parameters.
+ * @param voltages              Pointer to an array where the calculated voltage values will be stored.
+ * @param voltages_length       Pointer to a variable to store the actual number of generated voltage values.
+ * @param voltages_max_length   The maximum capacity of the `voltages` array.
+ *
+ * @return AD5940Err            Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_voltages(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    int32_t *const voltages,
+    uint16_t *const voltages_length,
+    const uint16_t voltages_max_length
+);
+
+/**
+ * @brief Retrieves the number of ADC data of a scan, one per step.
+ *
+ * @param parameters    Pointer to the structure containing LSV parameters.
+ * @param fifo_count    Pointer to retrieve the number of ADC data.
+ *
+ * @return AD5940Err    Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_get_fifo_count(
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *const parameters,
+    uint16_t *const fifo_count
+);
+
+/**
+ * @brief Configuration for Linear Sweep Voltammetry (LSV) using LPTIA.
+ */
+typedef struct
+{
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *parameters;     /**< Pointer to the LSV parameters. */
+
+    float LFOSC_frequency;  /**< Low-frequency oscillator frequency, used for internal timing.
+                                 Obtainable via @ref AD5940_LFOSCMeasure in library/ad5940.h.*/
+
+    const AD5940_UTILITY_ClockConfig *clock;    /**< Pointer to clock configuration.
+                                                     Obtainable via
+                                                     @ref AD5940_UTILITY_set_active_power
+                                                     in utility/ad5940_utility_power.h. */
+
+    const AGPIOCfg_Type *agpio_cfg;     /**< Pointer to GPIO configuration.
+                                             - Refer to datasheet pages 112 and 122.
+                                             - Configure GPIO for interrupts based on PCB design. */
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type *utility_AFERefCfg_Type;    /**< Pointer to AFE reference configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type *utility_LPPACfg_Type;        /**< Pointer to LPPA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type *utility_LPTIACfg_Type;      /**< Pointer to LPTIA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type *utility_DSPCfg_Type;      /**< Pointer to DSP configuration. */
+
+    uint32_t DataType; /**< Data type configuration. @ref DATATYPE_Const. */
+    uint32_t FifoSrc;  /**< FIFO source configuration. @ref FIFOSRC_Const*/
+}
+AD5940_ELECTROCHEMICAL_LSV_LPTIA_CONFIG;
+
+/**
+ * @brief Starts the Linear Sweep Voltammetry (LSV) operation using LPTIA configuration.
+ *
+ * @param config Pointer to the LPTIA LSV configuration structure.
+ *
+ * @return AD5940Err Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_LSV_LPTIA_CONFIG *const config
+);
+
+/**
+ * @brief Configuration for Linear Sweep Voltammetry (LSV) with a specified working electrode.
+ */
+typedef struct
+{
+    AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE working_electrode; /**< Type of working electrode. See @ref AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE. */
+    const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS *parameters;     /**< Pointer to the LSV parameters. */
+
+    float LFOSC_frequency;  /**< Low-frequency oscillator frequency, used for internal timing.
+                                 Obtainable via @ref AD5940_LFOSCMeasure in library/ad5940.h.*/
+
+    const AD5940_UTILITY_ClockConfig *clock;    /**< Pointer to clock configuration.
+                                                     Obtainable via
+                                                     @ref AD5940_UTILITY_set_active_power
+                                                     in utility/ad5940_utility_power.h. */
+
+    const AGPIOCfg_Type *agpio_cfg;     /**< Pointer to GPIO configuration.
+                                             - Refer to datasheet pages 112 and 122.
+                                             - Configure GPIO for interrupts based on PCB design. */
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type *utility_AFERefCfg_Type;    /**< Pointer to AFE reference configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type *utility_LPPACfg_Type;        /**< Pointer to LPPA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type *utility_HSTIACfg_Type;      /**< Pointer to HSTIA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type *utility_DSPCfg_Type;      /**< Pointer to DSP configuration. */
+
+    uint32_t DataType; /**< Data type configuration. @ref DATATYPE_Const. */
+    uint32_t FifoSrc;  /**< FIFO source configuration. @ref FIFOSRC_Const*/
+}
+AD5940_ELECTROCHEMICAL_LSV_CONFIG;
+
+/**
+ * @brief Starts the Linear Sweep Voltammetry (LSV) operation.
+ *
+ * @param config Pointer to the LSV configuration structure.
+ *
+ * @return AD5940Err Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_start(
+    const AD5940_ELECTROCHEMICAL_LSV_CONFIG *const config
+);
+
+/**
+ * @brief Stops the Linear Sweep Voltammetry (LSV) operation and shuts down the AD5940.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer where remaining FIFO data will be stored.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to a variable to retrieve the remaining FIFO count.
+ *
+ * @return AD5940Err                 Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+/**
+ * @brief Handles FIFO interrupts during Linear Sweep Voltammetry (LSV) operation.
+ *
+ * Scans longer than the sequencer SRAM are streamed, the interrupts of the block
+ * refills only return the data read so far, the AFE is shut down after the last data,
+ * see @ref AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer to store FIFO data.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to retrieve the current FIFO count.
+ *
+ * @return AD5940Err                 Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_LSV_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+#ifdef __cplusplus
+}
+#endif
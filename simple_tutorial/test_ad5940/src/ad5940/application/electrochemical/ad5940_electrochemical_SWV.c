@@ -0,0 +1,234 @@
+#include "ad5940_electrochemical_SWV.h"
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+#include "ad5940_electrochemical_utility.h"
+
+#include <stdlib.h>
+
+#define T_PERIOD(frequency) (1E3F / ((float) (frequency)))
+#define T_HALF_PERIOD(frequency) (T_PERIOD(frequency) / 2)
+
+/**
+ * @brief Gets the waveform of the scan, every level of the staircase from E_begin to E_end
+ *        is applied with the forward pulse, then with the reverse pulse.
+ */
+static void _get_waveform(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform
+)
+{
+    /* The forward pulse goes in the direction of the scan. */
+    const int16_t E_forward = (parameters->E_end > parameters->E_begin) ? parameters->E_amplitude : -(parameters->E_amplitude);
+    *waveform = (AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM) {
+        .E_vertices = {
+            parameters->E_begin,
+            parameters->E_end,
+        },
+        .segments_length = 1,
+        .E_step = parameters->E_step,
+        .include_end = bTRUE,
+        .repeat = bFALSE,
+        .E_phases = {
+            E_forward,
+            -E_forward,
+        },
+        .phases_length = 2,
+    };
+    return;
+}
+
+static AD5940Err _check_parameters(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters
+)
+{
+    if(parameters->E_step == 0) return AD5940ERR_PARA;
+    if(parameters->frequency == 0) return AD5940ERR_PARA;
+    if(T_HALF_PERIOD(parameters->frequency) <= AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY) return AD5940ERR_PARA;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_times(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    uint32_t *const times,
+    uint16_t *const times_length,
+    const uint16_t times_max_length
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    uint32_t step_number;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+        &waveform,
+        &step_number
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    *times_length = step_number / 2;
+    if(times_max_length < *times_length) return AD5940ERR_PARA;
+    const float t_period = T_PERIOD(parameters->frequency);
+    for(size_t i=0; i<*times_length; i++)
+    {
+        times[i] = (uint32_t) (t_period * i);
+    }
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_voltages(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    int32_t *const voltages,
+    uint16_t *const voltages_length,
+    const uint16_t voltages_max_length
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_levels(
+        &waveform,
+        voltages,
+        voltages_length,
+        voltages_max_length
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_fifo_count(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    uint16_t *const fifo_count
+)
+{
+    AD5940Err error = _check_parameters(parameters);
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    _get_waveform(parameters, &waveform);
+    uint32_t step_number;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+        &waveform,
+        &step_number
+    );
+    if(error != AD5940ERR_OK) return error;
+    if(step_number > UINT16_MAX) return AD5940ERR_PARA;
+
+    *fifo_count = step_number;
+    return AD5940ERR_OK;
+}
+
+/**
+ * @brief Gets the scan, both pulses last half a period.
+ */
+static AD5940Err _get_scan(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan
+)
+{
+    AD5940Err error = AD5940_ELECTROCHEMICAL_SWV_get_fifo_count(
+        parameters,
+        &(scan->fifo_count)
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    _get_waveform(parameters, &(scan->waveform));
+    scan->t_steps[0] = T_HALF_PERIOD(parameters->frequency);
+    scan->t_steps[1] = T_HALF_PERIOD(parameters->frequency);
+    scan->fifo_count_first = scan->fifo_count;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_SWV_LPTIA_CONFIG *const config
+)
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN scan;
+    AD5940Err error = _get_scan(config->parameters, &scan);
+    if(error != AD5940ERR_OK) return error;
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG waveform_config = AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG_OF(config);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_start_with_LPTIA(
+        &scan,
+        &waveform_config,
+        config->utility_LPTIACfg_Type
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_start(
+    const AD5940_ELECTROCHEMICAL_SWV_CONFIG *const config
+)
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN scan;
+    AD5940Err error = _get_scan(config->parameters, &scan);
+    if(error != AD5940ERR_OK) return error;
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG waveform_config = AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG_OF(config);
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_start(
+        &scan,
+        &waveform_config,
+        config->working_electrode,
+        config->utility_HSTIACfg_Type
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_stop(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    return AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_convert_ADCs_to_currents(
+    int32_t *const currents,
+    uint16_t *const currents_length,
+    const uint16_t currents_max_length,
+    const uint32_t *const adc_data,
+    const uint16_t adc_data_length,
+    const fImpPol_Type *const RtiaCalValue,
+    const uint32_t ADC_PGA_gain,
+    const float ADC_reference_volt
+)
+{
+    /* Every ADC data is converted in place before the pairs are subtracted. */
+    if(currents_max_length < adc_data_length) return AD5940ERR_PARA;
+
+    AD5940Err error = AD5940_UTILITY_convert_ADCs_to_currents(
+        currents,
+        adc_data,
+        adc_data_length,
+        RtiaCalValue,
+        ADC_PGA_gain,
+        ADC_reference_volt
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    *currents_length = adc_data_length / 2;
+    for(size_t i=0; i<(*currents_length); i++)
+    {
+        /* Forward minus reverse. */
+        currents[i] = currents[2*i] - currents[2*i+1];
+    }
+    return AD5940ERR_OK;
+}
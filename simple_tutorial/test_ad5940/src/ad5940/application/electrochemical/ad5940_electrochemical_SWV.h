@@ -0,0 +1,229 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+#include "ad5940_electrochemical_utility.h"
+
+/**
+ * @brief Parameters for the AD5940 Electrochemical Square Wave Voltammetry (SWV) operation.
+ *
+ * Every level of the staircase from E_begin to E_end is applied as a forward pulse,
+ * in the direction of the scan, then a reverse pulse, each lasting half a period.
+ * The current is sampled at the end of both pulses.
+ */
+typedef struct
+{
+    int16_t E_begin;        /**< Starting potential of the scan, in millivolts (mV). */
+    int16_t E_end;          /**< Ending potential of the scan, in millivolts (mV). */
+    uint16_t E_step;        /**< Step potential between two periods, in millivolts (mV). */
+    uint16_t E_amplitude;   /**< Amplitude of the square wave, half of the peak-to-peak, in millivolts (mV). */
+    uint16_t frequency;     /**< Frequency of the square wave, in hertz (Hz).
+                                 Half a period must be longer than the ADC sample delay of 25 ms. */
+}
+AD5940_ELECTROCHEMICAL_SWV_PARAMETERS;
+
+/**
+ * @brief Generates time values for Square Wave Voltammetry (SWV) measurements.
+ *
+ * One time value per period, in milliseconds (ms).
+ *
+ * @param parameters            Pointer to the structure containing SWV parameters.
+ * @param times                 Pointer to an array where the calculated time values will be stored.
+ * @param times_length          Pointer to a variable to store the actual number of generated time values.
+ * @param times_max_length      The maximum capacity of the `times` array.
+ *
+ * @return AD5940Err            Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_times(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    uint32_t *const times,
+    uint16_t *const times_length,
+    const uint16_t times_max_length
+);
+
+/**
+ * @brief Generates voltage values for Square Wave Voltammetry (SWV) measurements.
+ *
+ * One voltage value per period, the level of the staircase without the square wave.
+ *
+ * @param parameters            Pointer to the structure containing SWV parameters.
+ * @param voltages              Pointer to an array where the calculated voltage values will be stored.
+ * @param voltages_length       Pointer to a variable to store the actual number of generated voltage values.
+ * @param voltages_max_length   The maximum capacity of the `voltages` array.
+ *
+ * @return AD5940Err            Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_voltages(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    int32_t *const voltages,
+    uint16_t *const voltages_length,
+    const uint16_t voltages_max_length
+);
+
+/**
+ * @brief Retrieves the number of ADC data of a scan, two per period.
+ *
+ * @param parameters    Pointer to the structure containing SWV parameters.
+ * @param fifo_count    Pointer to retrieve the number of ADC data.
+ *
+ * @return AD5940Err    Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_get_fifo_count(
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *const parameters,
+    uint16_t *const fifo_count
+);
+
+/**
+ * @brief Configuration for Square Wave Voltammetry (SWV) using LPTIA.
+ */
+typedef struct
+{
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *parameters;     /**< Pointer to the SWV parameters. */
+
+    float LFOSC_frequency;  /**< Low-frequency oscillator frequency, used for internal timing.
+                                 Obtainable via @ref AD5940_LFOSCMeasure in library/ad5940.h.*/
+
+    const AD5940_UTILITY_ClockConfig *clock;    /**< Pointer to clock configuration.
+                                                     Obtainable via
+                                                     @ref AD5940_UTILITY_set_active_power
+                                                     in utility/ad5940_utility_power.h. */
+
+    const AGPIOCfg_Type *agpio_cfg;     /**< Pointer to GPIO configuration.
+                                             - Refer to datasheet pages 112 and 122.
+                                             - Configure GPIO for interrupts based on PCB design. */
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type *utility_AFERefCfg_Type;    /**< Pointer to AFE reference configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type *utility_LPPACfg_Type;        /**< Pointer to LPPA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type *utility_LPTIACfg_Type;      /**< Pointer to LPTIA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type *utility_DSPCfg_Type;      /**< Pointer to DSP configuration. */
+
+    uint32_t DataType; /**< Data type configuration. @ref DATATYPE_Const. */
+    uint32_t FifoSrc;  /**< FIFO source configuration. @ref FIFOSRC_Const*/
+}
+AD5940_ELECTROCHEMICAL_SWV_LPTIA_CONFIG;
+
+/**
+ * @brief Starts the Square Wave Voltammetry (SWV) operation using LPTIA configuration.
+ *
+ * @param config Pointer to the LPTIA SWV configuration structure.
+ *
+ * @return AD5940Err Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_SWV_LPTIA_CONFIG *const config
+);
+
+/**
+ * @brief Configuration for Square Wave Voltammetry (SWV) with a specified working electrode.
+ */
+typedef struct
+{
+    AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE working_electrode; /**< Type of working electrode. See @ref AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE. */
+    const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS *parameters;     /**< Pointer to the SWV parameters. */
+
+    float LFOSC_frequency;  /**< Low-frequency oscillator frequency, used for internal timing.
+                                 Obtainable via @ref AD5940_LFOSCMeasure in library/ad5940.h.*/
+
+    const AD5940_UTILITY_ClockConfig *clock;    /**< Pointer to clock configuration.
+                                                     Obtainable via
+                                                     @ref AD5940_UTILITY_set_active_power
+                                                     in utility/ad5940_utility_power.h. */
+
+    const AGPIOCfg_Type *agpio_cfg;     /**< Pointer to GPIO configuration.
+                                             - Refer to datasheet pages 112 and 122.
+                                             - Configure GPIO for interrupts based on PCB design. */
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type *utility_AFERefCfg_Type;    /**< Pointer to AFE reference configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type *utility_LPPACfg_Type;        /**< Pointer to LPPA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type *utility_HSTIACfg_Type;      /**< Pointer to HSTIA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type *utility_DSPCfg_Type;      /**< Pointer to DSP configuration. */
+
+    uint32_t DataType; /**< Data type configuration. @ref DATATYPE_Const. */
+    uint32_t FifoSrc;  /**< FIFO source configuration. @ref FIFOSRC_Const*/
+}
+AD5940_ELECTROCHEMICAL_SWV_CONFIG;
+
+/**
+ * @brief Starts the Square Wave Voltammetry (SWV) operation.
+ *
+ * @param config Pointer to the SWV configuration structure.
+ *
+ * @return AD5940Err Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_start(
+    const AD5940_ELECTROCHEMICAL_SWV_CONFIG *const config
+);
+
+/**
+ * @brief Stops the Square Wave Voltammetry (SWV) operation and shuts down the AD5940.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer where remaining FIFO data will be stored.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to a variable to retrieve the remaining FIFO count.
+ *
+ * @return AD5940Err                 Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+/**
+ * @brief Handles FIFO interrupts during Square Wave Voltammetry (SWV) operation.
+ *
+ * Scans longer than the sequencer SRAM are streamed, the interrupts of the block
+ * refills only return the data read so far. The data always hold whole periods, starting with
+ * a forward pulse, see @ref AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer to store FIFO data.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to retrieve the current FIFO count.
+ *
+ * @return AD5940Err                 Error code indicating success (0) or failure.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+/**
+ * @brief Converts ADC data to current values for Square Wave Voltammetry (SWV).
+ *
+ * The ADC data come in pairs, the forward pulse then the reverse pulse of a period.
+ * Every current is the forward current minus the reverse current of a period.
+ *
+ * @param currents              Pointer to an array where the calculated current values (in nanoamperes) will be stored.
+ *                              It needs room for `adc_data_length` values while converting.
+ * @param currents_length       Pointer to a variable where the number of calculated current values will be stored.
+ * @param currents_max_length   Maximum allowable length of the `currents` array.
+ * @param adc_data              Pointer to the array of ADC data retrieved from the FIFO, starting with a forward pulse.
+ * @param adc_data_length       Number of ADC data points in the `adc_data` array.
+ * @param RtiaCalValue          Pointer to the RTIA calibration value. This parameter is obtained from RTIA calibration functions
+ *                              like @ref AD5940_HSRtiaCal or @ref AD5940_LPRtiaCal.
+ * @param ADC_PGA_gain          ADC Programmable Gain Amplifier (PGA) gain value. Refer to @ref ADCPGA_Const.
+ * @param ADC_reference_volt    Reference voltage used for the ADC (in volts). Refer to the AD5940 datasheet for details.
+ *
+ * @return AD5940Err            Returns an error code of type `AD5940Err`. A value of 0 indicates success, while other values
+ *                              indicate specific errors encountered during the conversion process.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_SWV_convert_ADCs_to_currents(
+    int32_t *const currents,
+    uint16_t *const currents_length,
+    const uint16_t currents_max_length,
+    const uint32_t *const adc_data,
+    const uint16_t adc_data_length,
+    const fImpPol_Type *const RtiaCalValue,
+    const uint32_t ADC_PGA_gain,
+    const float ADC_reference_volt
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,9 @@ extern "C"
 #include "ad5940_electrochemical_utility_afe_dac.h"
 #include "ad5940_electrochemical_utility_tia_adc.h"
 #include "ad5940_electrochemical_utility_sop.h"
+#include "ad5940_electrochemical_utility_temperature.h"
+#include "ad5940_electrochemical_utility_dac_stream.h"
+#include "ad5940_electrochemical_utility_waveform.h"
 
 #ifdef __cplusplus
 }
@@ -53,6 +53,8 @@ static void _get_AFERefCfg_Type(
     const BoolFlag LPDAC_enable
 )
 {
+    (void) utility_type;
+
     /**
      * Enable the high-precision voltage references.
      * Refer to page 25 and Figure 37 (page 87) of the datasheet.
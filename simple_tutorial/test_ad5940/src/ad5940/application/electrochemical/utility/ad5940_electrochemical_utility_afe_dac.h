@@ -6,7 +6,6 @@ extern "C"
 #endif
 
 #include "ad5940.h"
-#include "ad5940_electrochemical_utility.h"
 
 /**
  * @ref AFERefCfg_Type
@@ -0,0 +1,185 @@
+#include "ad5940_electrochemical_utility_dac_stream.h"
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+#include "ad5940_electrochemical_utility.h"
+
+#define SEQLEN_ONESTEP 3L   /* LPDACDAT0, wait for LPDAC and SEQINFO of the next step. */
+#define SEQLEN_LASTSTEP 4L  /* One more command in the last step of a block to raise AFEINTSRC_CUSTOMINT0. */
+#define SEQLEN_SPARE 1L     /* SEQ_STOP after the last step of a finite scan. */
+
+static struct
+{
+    BoolFlag running;
+    BoolFlag done;          /* The last step is written, nothing to refill. */
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_STREAM_NEXT next;
+    uint16_t seq_info[2];
+    uint32_t block_address[2];
+    uint32_t steps_per_block;
+    uint32_t step;          /* Index of the next step to write, counted from the start of the scan. */
+}
+_stream;
+
+static uint32_t _get_end_address(void)
+{
+    uint32_t start_address, end_address;
+    AD5940_ELECTROCHEMICAL_UTILITY_get_sequence_memory(&start_address, &end_address);
+    return end_address;
+}
+
+static uint32_t _get_address(const uint32_t step)
+{
+    const uint32_t block = (step / _stream.steps_per_block) & 0x01;
+    const uint32_t slot = step % _stream.steps_per_block;
+    return _stream.block_address[block] + slot * SEQLEN_ONESTEP;
+}
+
+static uint32_t _get_length(const uint32_t step)
+{
+    return ((step % _stream.steps_per_block) == (_stream.steps_per_block - 1)) ? SEQLEN_LASTSTEP : SEQLEN_ONESTEP;
+}
+
+static uint32_t _get_seq_info(const uint32_t address, const uint32_t length)
+{
+    // Same bit positions in SEQ0INFO to SEQ3INFO
+    return (address << BITP_AFE_SEQ0INFO_ADDR) | (length << BITP_AFE_SEQ0INFO_LEN);
+}
+
+/**
+ * @brief Writes steps until the end of the current block or the last step.
+ */
+static AD5940Err _write_block(void)
+{
+    AD5940Err error = AD5940ERR_OK;
+    uint32_t SeqCmdBuff[SEQLEN_LASTSTEP + SEQLEN_SPARE];
+
+    do
+    {
+        const uint32_t step = _stream.step;
+        const uint32_t address = _get_address(step);
+        uint32_t length = _get_length(step);
+        uint32_t lpdac_dat_bit;
+        BoolFlag is_last = bFALSE;
+
+        error = _stream.next(&lpdac_dat_bit, &is_last);
+        if(error != AD5940ERR_OK) return error;
+
+        SeqCmdBuff[0] = SEQ_WR(REG_AFE_LPDACDAT0, lpdac_dat_bit);
+        SeqCmdBuff[1] = SEQ_WAIT(10); /* !!!NOTE LPDAC need 10 clocks to update data. Before send AFE to sleep state, wait 10 extra clocks */
+        if(is_last)
+        {
+            /* The other sequence runs SEQ_STOP right after this step, there is a spare word at the end of every block. */
+            SeqCmdBuff[2] = SEQ_WR(
+                _stream.seq_info[(step + 1) & 0x01],
+                _get_seq_info(address + length, SEQLEN_SPARE)
+            );
+        }
+        else
+        {
+            SeqCmdBuff[2] = SEQ_WR(
+                _stream.seq_info[(step + 1) & 0x01],
+                _get_seq_info(_get_address(step + 1), _get_length(step + 1))
+            );
+        }
+        if(length == SEQLEN_LASTSTEP) SeqCmdBuff[3] = SEQ_INT0();  /* Block completed, ask MCU to refill it. */
+        if(is_last)
+        {
+            SeqCmdBuff[length] = SEQ_STOP();   /* Disable sequencer, END of sequencer interrupt is generated. */
+            length += SEQLEN_SPARE;
+        }
+        AD5940_SEQCmdWrite(address, SeqCmdBuff, length);
+
+        _stream.step++;
+        if(is_last)
+        {
+            _stream.done = bTRUE;
+            break;
+        }
+    }
+    while((_stream.step % _stream.steps_per_block) != 0);
+
+    return AD5940ERR_OK;
+}
+
+BoolFlag AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_needed(
+    const uint32_t start_address,
+    const uint32_t step_number,
+    const uint32_t extra_commands
+)
+{
+    const uint32_t end_address = _get_end_address();
+    if(start_address >= end_address) return bTRUE;
+    return ((step_number * SEQLEN_ONESTEP + extra_commands) > (end_address - start_address)) ? bTRUE : bFALSE;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_start(
+    const uint32_t start_address,
+    const uint16_t seq_info_0,
+    const uint16_t seq_info_1,
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_STREAM_NEXT next
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    _stream.running = bFALSE;
+    const uint32_t end_address = _get_end_address();
+    if(start_address >= end_address) return AD5940ERR_BUFF;
+
+    /* Every block holds its steps, the CUSTOMINT0 command and the spare word. */
+    const uint32_t block_size = (end_address - start_address) / 2;
+    if(block_size < SEQLEN_LASTSTEP + SEQLEN_SPARE) return AD5940ERR_BUFF;
+    _stream.steps_per_block = (block_size - (SEQLEN_LASTSTEP - SEQLEN_ONESTEP) - SEQLEN_SPARE) / SEQLEN_ONESTEP;
+    _stream.block_address[0] = start_address;
+    _stream.block_address[1] = start_address + block_size;
+    _stream.seq_info[0] = seq_info_0;
+    _stream.seq_info[1] = seq_info_1;
+    _stream.next = next;
+    _stream.step = 0;
+    _stream.done = bFALSE;
+
+    error = _write_block();
+    if(error != AD5940ERR_OK) return error;
+    if(_stream.done == bFALSE)
+    {
+        error = _write_block();
+        if(error != AD5940ERR_OK) return error;
+    }
+
+    AD5940_WriteReg(seq_info_0, _get_seq_info(_get_address(0), _get_length(0)));
+    AD5940_WriteReg(seq_info_1, _get_seq_info(_get_address(1), _get_length(1)));
+
+    _stream.running = bTRUE;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt(
+    uint32_t *const AFEIntSrc
+)
+{
+    *AFEIntSrc = 0;
+    if(_stream.running == bFALSE) return AD5940ERR_OK;
+
+    *AFEIntSrc = AD5940_INTCGetFlag(AFEINTC_0) | AD5940_INTCGetFlag(AFEINTC_1);
+    if(!(*AFEIntSrc & AFEINTSRC_CUSTOMINT0)) return AD5940ERR_OK;
+
+    AD5940Err error = AD5940ERR_OK;
+    if(_stream.done == bFALSE)
+    {
+        /* The sequencer is running the other block now. */
+        error = _write_block();
+    }
+    AD5940_INTCClrFlag(AFEINTSRC_CUSTOMINT0);
+    return error;
+}
+
+BoolFlag AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running(void)
+{
+    return _stream.running;
+}
+
+void AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop(void)
+{
+    _stream.running = bFALSE;
+    return;
+}
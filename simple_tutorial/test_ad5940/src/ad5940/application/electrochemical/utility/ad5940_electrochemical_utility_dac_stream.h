@@ -0,0 +1,88 @@
+/**
+ * @file ad5940_electrochemical_utility_dac_stream.h
+ * @brief Streams LPDAC steps into sequencer SRAM with two ping-pong blocks.
+ *
+ * The DAC steps of a scan are generated on the MCU and only two blocks of
+ * steps are resident in SRAM. The last step of each block raises
+ * `AFEINTSRC_CUSTOMINT0`, the interrupt handler then calls
+ * @ref AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt to write the next
+ * steps into the block just completed while the sequencer runs the other one.
+ *
+ * Every step is run by one of two sequences alternately, and writes the
+ * SEQINFO of the other sequence to point to the next step, the same chain
+ * as the fully resident scans.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_electrochemical_utility.h"
+
+/**
+ * @brief Generates the LPDACDAT0 value of the next step.
+ *
+ * @param lpdac_dat_bit Value written to LPDACDAT0.
+ * @param is_last       Set to bTRUE if it's the last step, the sequencer is stopped after it.
+ *                      Leave it bFALSE for a scan repeated until stopped.
+ * @return AD5940ERR_OK or an error that stops the stream.
+ */
+typedef AD5940Err (*AD5940_ELECTROCHEMICAL_UTILITY_DAC_STREAM_NEXT)(
+    uint32_t *const lpdac_dat_bit,
+    BoolFlag *const is_last
+);
+
+/**
+ * @brief Returns bTRUE if `step_number` steps (plus `extra_commands`) can't fit
+ *        into the SRAM between `start_address` and the end of the electrochemical region.
+ */
+BoolFlag AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_needed(
+    const uint32_t start_address,
+    const uint32_t step_number,
+    const uint32_t extra_commands
+);
+
+/**
+ * @brief Fills both blocks and configures the two DAC sequences.
+ *
+ * @param start_address     First SRAM address of the blocks, after the ADC sequence.
+ *                          The blocks fill the region up to its end, see @ref AD5940_ELECTROCHEMICAL_UTILITY_get_sequence_memory.
+ * @param seq_info_0        SEQxINFO register of the sequence running even steps.
+ * @param seq_info_1        SEQxINFO register of the sequence running odd steps.
+ * @param next              Step generator, called in thread and interrupt context.
+ * @return AD5940ERR_OK or the error of `next`.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_start(
+    const uint32_t start_address,
+    const uint16_t seq_info_0,
+    const uint16_t seq_info_1,
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_STREAM_NEXT next
+);
+
+/**
+ * @brief Refills the block completed by the sequencer if `AFEINTSRC_CUSTOMINT0` is raised.
+ *
+ * Call it from the interrupt handler with AFE awake and the sleep key locked. 
+ * The flag is cleared after the refill. Nothing is read if no stream is running.
+ *
+ * @param AFEIntSrc Flags of both INTC read by this call, 0 if no stream is running.
+ * @return AD5940ERR_OK or the error of the step generator.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt(
+    uint32_t *const AFEIntSrc
+);
+
+/**
+ * @brief Returns bTRUE if a stream is started and not stopped.
+ */
+BoolFlag AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running(void);
+
+void AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,6 +5,23 @@
 
 #include "ad5940_electrochemical_utility.h"
 
+#include "ad5940_compiled_sequences.h"
+
+/* SRAM left by the persistent slots of other applications, the DAC sequences follow the ADC sequence. */
+static const char _sequence_memory_name[] = "electrochemical";
+static uint32_t _sequence_memory_start_address = 0;
+static uint32_t _sequence_memory_end_address = AD5940_UTILITY_SEQUENCE_MEMORY_SIZE;
+
+void AD5940_ELECTROCHEMICAL_UTILITY_get_sequence_memory(
+    uint32_t *const start_address,
+    uint32_t *const end_address
+)
+{
+    *start_address = _sequence_memory_start_address;
+    *end_address = _sequence_memory_end_address;
+    return;
+}
+
 static SEQInfo_Type _ADC_seq_info = {
     .SeqId = SEQID_0,
     .WriteSRAM = bTRUE,
@@ -23,7 +40,7 @@ static void _get_SEQCfg_Type(
     BoolFlag enable
 )
 {
-    type->SeqMemSize = SEQMEMSIZE_2KB;  /* 2kB SRAM is used for sequencer, others for data FIFO */
+    type->SeqMemSize = SEQMEMSIZE_2KB;  /* 2kB SRAM is used for sequencer, others for data FIFO, @ref AD5940_UTILITY_SEQUENCE_MEMORY_SIZE */
     type->SeqBreakEn = bFALSE;
     type->SeqIgnoreEn = bTRUE;
     type->SeqCntCRCClr = bTRUE;
@@ -43,6 +60,15 @@ static void _get_FIFOCfg_Type(
     return;
 }
 
+uint32_t AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count(
+    const StatCfg_Type *const stat
+)
+{
+    if(stat->StatEnable != bTRUE) return 1;
+    /* STATSAMPLE_128 is 0, every next constant halves the sample size. */
+    return 128L >> stat->StatSample;
+}
+
 static void _get_ClksCalInfo_Type(
     ClksCalInfo_Type *const type,
     const ADCFilterCfg_Type *const adc_filter,
@@ -71,6 +97,7 @@ static AD5940Err _write_ADC_sequence_commands(
     uint32_t *const sequence_length,
     const ADCFilterCfg_Type *const adc_filter,
     const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
     const AD5940_UTILITY_ClockConfig *const clock,
     uint32_t DataType
 )
@@ -83,29 +110,60 @@ static AD5940Err _write_ADC_sequence_commands(
 	uint32_t WaitClks;
     ClksCalInfo_Type clks_cal;
 
+    /* The statistics block averages the SINC2 (+Notch) results. */
+    if((stat->StatEnable == bTRUE) && (DataType != DATATYPE_SINC2) && (DataType != DATATYPE_NOTCH)) return AD5940ERR_PARA;
+
     _get_ClksCalInfo_Type(
         &clks_cal,
         adc_filter,
         dft,
         clock,
         DataType,
-        1
+        AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count(stat)
     );
 	AD5940_ClksCalculate(&clks_cal, &WaitClks);
 
-	AD5940_SEQGenCtrl(bTRUE);
-    
-	AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_SINC2NOTCH, bTRUE);
-	AD5940_SEQGenInsert(SEQ_WAIT(16*250));  /* wait 250us for reference power up */
-	AD5940_AFECtrlS(AFECTRL_ADCCNV, bTRUE);  /* Start ADC convert and DFT */
-	AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));  /* wait for first data ready */
-	AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_ADCCNV | AFECTRL_SINC2NOTCH, bFALSE);  /* Stop ADC */
-	// AD5940_EnterSleepS();/* Goto hibernate */
-	/* Sequence end. */
-	error = AD5940_SEQGenFetchSeq(&pSeqCmd, &SeqLen);
-	AD5940_SEQGenCtrl(bFALSE); /* Stop sequencer generator */
-
-    if(error != AD5940ERR_OK) return error;
+    /**
+     * Use the sequence compiled offline if it's valid, the sequence generator buffer is not touched.
+     * Only sequences without statistics are compiled, they are found by WaitClks alone.
+     */
+    error = AD5940ERR_PARA;
+    if(stat->StatEnable != bTRUE)
+    {
+        error = AD5940_UTILITY_find_compiled_sequence(
+            AD5940_COMPILED_SEQUENCES_electrochemical_ADC,
+            AD5940_COMPILED_SEQUENCES_electrochemical_ADC_length,
+            WaitClks,
+            &pSeqCmd,
+            &SeqLen
+        );
+    }
+    if(error != AD5940ERR_OK)
+    {
+        AD5940_SEQGenCtrl(bTRUE);
+        
+        AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_SINC2NOTCH, bTRUE);
+        AD5940_SEQGenInsert(SEQ_WAIT(16*250));  /* wait 250us for reference power up */
+        if(stat->StatEnable == bTRUE)
+        {
+            /* Restart the statistics block, so every DAC step gets the mean of its own conversions only. */
+            StatCfg_Type stat_cfg = *stat;
+            stat_cfg.StatEnable = bFALSE;
+            AD5940_StatisticCfgS(&stat_cfg);
+            stat_cfg.StatEnable = bTRUE;
+            AD5940_StatisticCfgS(&stat_cfg);
+        }
+        AD5940_AFECtrlS(AFECTRL_ADCCNV, bTRUE);  /* Start ADC convert and DFT */
+        AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));  /* wait for first data ready */
+        AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_ADCCNV | AFECTRL_SINC2NOTCH, bFALSE);  /* Stop ADC */
+        // AD5940_EnterSleepS();/* Goto hibernate */
+        /* Sequence end. */
+        error = AD5940_SEQGenFetchSeq(&pSeqCmd, &SeqLen);
+        AD5940_SEQGenCtrl(bFALSE); /* Stop sequencer generator */
+
+        if(error != AD5940ERR_OK) return error;
+    }
+    if(start_address + SeqLen > _sequence_memory_end_address) return AD5940ERR_BUFF;
 
     *sequence_length = SeqLen;
     _ADC_seq_info.SeqRamAddr = start_address;
@@ -120,6 +178,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config(
     uint32_t *const sequence_address,
     const ADCFilterCfg_Type *const adc_filter,
     const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
     const AD5940_UTILITY_ClockConfig *const clock,
     const uint32_t DataType
 )
@@ -146,7 +205,16 @@ AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config(
      */
     AD5940_UTILITY_clear_sequence_generator_buffer();
 
-    *sequence_address = 0x00;
+    uint32_t sequence_memory_length = 0;
+    error = AD5940_UTILITY_sequence_memory_allocate_remaining(
+        _sequence_memory_name,
+        &_sequence_memory_start_address,
+        &sequence_memory_length
+    );
+    if(error != AD5940ERR_OK) return error;
+    _sequence_memory_end_address = _sequence_memory_start_address + sequence_memory_length;
+
+    *sequence_address = _sequence_memory_start_address;
     uint32_t sequence_commands_length = 0;
 
     error = _write_ADC_sequence_commands(
@@ -154,11 +222,25 @@ AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config(
         &sequence_commands_length,
         adc_filter,
         dft,
+        stat,
         clock,
         DataType
     );
     if(error != AD5940ERR_OK) return AD5940ERR_PARA;
     *sequence_address += sequence_commands_length;
 
+    error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_write_sequence_commands(
+        *sequence_address,
+        _sequence_memory_end_address,
+        &sequence_commands_length,
+        adc_filter,
+        dft,
+        stat,
+        clock,
+        DataType
+    );
+    if(error != AD5940ERR_OK) return error;
+    *sequence_address += sequence_commands_length;
+
     return AD5940ERR_OK;
 }
@@ -7,6 +7,7 @@
  * - Writing ADC sample sequence commands.
  * - Configuring SRAM to distribute sequence storage and FIFO management.
  * - Configuring ADC filter and DFT settings for electrochemical measurements.
+ * - Averaging several ADC conversions per sample with the statistics block.
  */
 
 #pragma once
@@ -20,6 +21,26 @@ extern "C"
 #include "ad5940_utility.h"
 #include "ad5940_electrochemical_utility.h"
 
+/**
+ * @brief Words of the data FIFO (`FIFOSIZE_4KB`), the upper bound of the FIFO threshold.
+ */
+#define AD5940_ELECTROCHEMICAL_UTILITY_DATA_FIFO_SIZE 1024
+
+/**
+ * @brief Retrieves the SRAM region of the electrochemical sequences.
+ * 
+ * The region is the SRAM left by the persistent slots of other applications
+ * (see utility/ad5940_utility_sequence_memory.h), it is allocated again by
+ * @ref AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config.
+ * 
+ * @param start_address Pointer to retrieve the first address of the region.
+ * @param end_address   Pointer to retrieve the address after the region.
+ */
+void AD5940_ELECTROCHEMICAL_UTILITY_get_sequence_memory(
+    uint32_t *const start_address,
+    uint32_t *const end_address
+);
+
 /**
  * @brief Retrieves the sequence information for ADC sampling.
  * 
@@ -33,18 +54,36 @@ void AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_seq_info(
     SEQInfo_Type **ADC_seq_info
 );
 
+/**
+ * @brief Retrieves the number of ADC conversions of one ADC sequence run, reduced to one FIFO word.
+ * 
+ * @param stat  Statistics block configuration, see `AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type`.
+ * 
+ * @return 1 without statistics, otherwise the sample size of the statistics block (8 to 128).
+ */
+uint32_t AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count(
+    const StatCfg_Type *const stat
+);
+
 /**
  * @brief Writes the configuration commands for ADC sequence operations.
  * 
  * This function writes the necessary sequence commands to configure the ADC, 
  * DFT, and clock settings for electrochemical measurements. The configuration 
  * details are based on the provided parameters, and the sequence address is updated.
+ * The temperature sequence follows the ADC sequence if its interval is set,
+ * see ad5940_electrochemical_utility_temperature.h.
  * 
- * @param sequence_address Pointer to store the address of the written sequence.
+ * @param sequence_address Pointer to store the address after the written sequence,
+ *                         the DAC sequences are written from there to the end of the region.
  * @param adc_filter       Pointer to the ADC filter configuration structure. 
  *                         See `ADCFilterCfg_Type` for details.
  * @param dft              Pointer to the DFT configuration structure. 
  *                         See `DFTCfg_Type` for details.
+ * @param stat             Pointer to the statistics block configuration. If it's enabled,
+ *                         every run converts the number of samples of the statistics block,
+ *                         see @ref AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count.
+ *                         `DataType` must be `DATATYPE_SINC2` or `DATATYPE_NOTCH` then.
  * @param clock            Clock configuration. Obtainable via 
  *                         @ref AD5940_UTILITY_set_active_power 
  *                         in utility/ad5940_utility_power.h.
@@ -59,6 +98,7 @@ AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config(
     uint32_t *const sequence_address,
     const ADCFilterCfg_Type *const adc_filter,
     const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
     const AD5940_UTILITY_ClockConfig *const clock,
     const uint32_t DataType
 );
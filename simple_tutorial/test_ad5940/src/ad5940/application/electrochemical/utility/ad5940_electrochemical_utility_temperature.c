@@ -0,0 +1,213 @@
+#include "ad5940_electrochemical_utility_temperature.h"
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+#include "ad5940_electrochemical_utility.h"
+
+#define _WUPT_SLOT_COUNT 8
+
+/* Mask of the register address of a SEQ_WR command. */
+#define _SEQ_WR_ADDRESS_MASK 0xff000000
+
+static uint8_t _interval = 0;
+
+static SEQInfo_Type _temperature_seq_info = {
+    .SeqId = AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID,
+    .WriteSRAM = bTRUE,
+};
+
+/* Indexes of the ADCCON writes, patched with the ADC input of the scan by the WUPT configuration. */
+static uint32_t _temperature_input_index = 0;
+static uint32_t _restore_input_index = 0;
+
+/* The temperature sequence pushes 2 data, the second one is the temperature. */
+static BoolFlag _is_temperature_next = bFALSE;
+
+void AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(
+    const uint8_t interval
+)
+{
+    _interval = interval;
+    return;
+}
+
+uint32_t AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(
+    const uint32_t adc_data_count
+)
+{
+    if(_interval == 0) return adc_data_count;
+    return adc_data_count + adc_data_count / _interval;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_write_sequence_commands(
+    const uint32_t start_address,
+    const uint32_t end_address,
+    uint32_t *const sequence_length,
+    const ADCFilterCfg_Type *const adc_filter,
+    const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
+    const AD5940_UTILITY_ClockConfig *const clock,
+    const uint32_t DataType
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    const uint32_t *pSeqCmd;
+    uint32_t SeqLen;
+
+    uint32_t WaitClks;
+    ClksCalInfo_Type clks_cal;
+
+    *sequence_length = 0;
+    _is_temperature_next = bFALSE;
+    if(_interval == 0) return AD5940ERR_OK;
+
+    if(stat->StatEnable == bTRUE) return AD5940ERR_PARA;
+
+    clks_cal.ADCAvgNum = adc_filter->ADCAvgNum;
+    clks_cal.ADCSinc2Osr = adc_filter->ADCSinc2Osr;
+    clks_cal.ADCSinc3Osr = adc_filter->ADCSinc3Osr;
+    clks_cal.DataType = DataType;
+    clks_cal.DataCount = 1;
+    clks_cal.DftSrc = dft->DftSrc;
+    clks_cal.RatioSys2AdcClk = clock->RatioSys2AdcClk;
+    AD5940_ClksCalculate(&clks_cal, &WaitClks);
+
+    AD5940_SEQGenCtrl(bTRUE);
+
+    /* The electrochemical data of the step, like the ADC sequence. */
+    AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_SINC2NOTCH | AFECTRL_TEMPSPWR, bTRUE);
+    AD5940_SEQGenInsert(SEQ_WAIT(16*250));  /* wait 250us for reference power up */
+    AD5940_AFECtrlS(AFECTRL_ADCCNV, bTRUE);
+    AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));
+    AD5940_AFECtrlS(AFECTRL_ADCCNV, bFALSE);
+    AD5940_SEQGenInsert(SEQ_WAIT(20));      /* needs some clock to move data to FIFO */
+
+    /* The temperature data, the ADC inputs are written by the WUPT configuration. */
+    AD5940_SEQGenInsert(SEQ_WR(REG_AFE_ADCCON, 0));
+    AD5940_SEQGenInsert(SEQ_WAIT(16*50));   /* wait 50us for ADC to settle */
+    AD5940_AFECtrlS(AFECTRL_TEMPCNV | AFECTRL_ADCCNV, bTRUE);
+    AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));
+    AD5940_AFECtrlS(AFECTRL_TEMPCNV | AFECTRL_ADCCNV, bFALSE);
+    AD5940_SEQGenInsert(SEQ_WAIT(20));
+    AD5940_SEQGenInsert(SEQ_WR(REG_AFE_ADCCON, 0));
+
+    AD5940_AFECtrlS(AFECTRL_ADCPWR | AFECTRL_SINC2NOTCH | AFECTRL_TEMPSPWR, bFALSE);
+
+    error = AD5940_SEQGenFetchSeq(&pSeqCmd, &SeqLen);
+    AD5940_SEQGenCtrl(bFALSE);
+    if(error != AD5940ERR_OK) return error;
+
+    if(start_address + SeqLen > end_address) return AD5940ERR_BUFF;
+
+    /* The first ADCCON write switches to the temperature sensor, the last one switches back. */
+    _temperature_input_index = SeqLen;
+    for(uint32_t i = 0; i < SeqLen; i++)
+    {
+        if((pSeqCmd[i] & _SEQ_WR_ADDRESS_MASK) != (SEQ_WR(REG_AFE_ADCCON, 0) & _SEQ_WR_ADDRESS_MASK)) continue;
+        if(_temperature_input_index == SeqLen) _temperature_input_index = i;
+        _restore_input_index = i;
+    }
+
+    *sequence_length = SeqLen;
+    _temperature_seq_info.SeqRamAddr = start_address;
+    _temperature_seq_info.pSeqCmd = pSeqCmd;
+    _temperature_seq_info.SeqLen = SeqLen;
+    AD5940_SEQInfoCfg(&_temperature_seq_info);
+
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(
+    WUPTCfg_Type *const wupt_cfg
+)
+{
+    if(_interval == 0) return AD5940ERR_OK;
+
+    SEQInfo_Type *ADC_seq_info;
+    AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_seq_info(&ADC_seq_info);
+    const uint32_t ADC_seq_id = ADC_seq_info->SeqId;
+
+    const uint32_t cycle_slot_count = wupt_cfg->WuptEndSeq + 1;
+    uint32_t cycle_ADC_count = 0;
+    for(uint32_t i = 0; i < cycle_slot_count; i++)
+    {
+        if(wupt_cfg->WuptOrder[i] == ADC_seq_id) cycle_ADC_count++;
+    }
+    if(cycle_ADC_count == 0) return AD5940ERR_PARA;
+    if(_interval % cycle_ADC_count != 0) return AD5940ERR_PARA;
+    const uint32_t cycle_repeat = _interval / cycle_ADC_count;
+    if(cycle_slot_count * cycle_repeat > _WUPT_SLOT_COUNT) return AD5940ERR_PARA;
+
+    const uint32_t slot_count = cycle_slot_count * cycle_repeat;
+    for(uint32_t i = cycle_slot_count; i < slot_count; i++)
+    {
+        wupt_cfg->WuptOrder[i] = wupt_cfg->WuptOrder[i - cycle_slot_count];
+    }
+    for(uint32_t i = slot_count; i-- > 0;)
+    {
+        if(wupt_cfg->WuptOrder[i] != ADC_seq_id) continue;
+        wupt_cfg->WuptOrder[i] = AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID;
+        break;
+    }
+    wupt_cfg->WuptEndSeq = slot_count - 1;
+
+    wupt_cfg->SeqxSleepTime[AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID] = wupt_cfg->SeqxSleepTime[ADC_seq_id];
+    wupt_cfg->SeqxWakeupTime[AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID] = wupt_cfg->SeqxWakeupTime[ADC_seq_id];
+
+    /* Keep the ADC configuration of the scan, only its inputs are switched. */
+    const uint32_t adccon = AD5940_ReadReg(REG_AFE_ADCCON);
+    const uint32_t temperature_adccon = (adccon & ~(BITM_AFE_ADCCON_MUXSELP | BITM_AFE_ADCCON_MUXSELN))
+        | (ADCMUXP_TEMPP << BITP_AFE_ADCCON_MUXSELP)
+        | (ADCMUXN_TEMPN << BITP_AFE_ADCCON_MUXSELN);
+    uint32_t command;
+
+    command = SEQ_WR(REG_AFE_ADCCON, temperature_adccon);
+    AD5940_SEQCmdWrite(_temperature_seq_info.SeqRamAddr + _temperature_input_index, &command, 1);
+    command = SEQ_WR(REG_AFE_ADCCON, adccon);
+    AD5940_SEQCmdWrite(_temperature_seq_info.SeqRamAddr + _restore_input_index, &command, 1);
+
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_split(
+    uint32_t *const adc_data,
+    uint16_t *const adc_data_length,
+    uint32_t *const temperature_data,
+    uint16_t *const temperature_data_length,
+    const uint16_t temperature_data_max_length
+)
+{
+    /* Count first, the FIFO data are left as they are if the temperature data don't fit. */
+    BoolFlag is_temperature_next = _is_temperature_next;
+    uint16_t temperature_count = 0;
+    for(uint16_t i = 0; i < *adc_data_length; i++)
+    {
+        if(FIFO_SEQID(adc_data[i]) != AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID) continue;
+        if(is_temperature_next == bTRUE) temperature_count++;
+        is_temperature_next = (is_temperature_next == bTRUE) ? bFALSE : bTRUE;
+    }
+    if(temperature_count > temperature_data_max_length) return AD5940ERR_BUFF;
+
+    uint16_t adc_count = 0;
+    temperature_count = 0;
+    for(uint16_t i = 0; i < *adc_data_length; i++)
+    {
+        if(FIFO_SEQID(adc_data[i]) == AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID)
+        {
+            const BoolFlag is_temperature = _is_temperature_next;
+            _is_temperature_next = (is_temperature == bTRUE) ? bFALSE : bTRUE;
+            if(is_temperature == bTRUE)
+            {
+                temperature_data[temperature_count++] = adc_data[i];
+                continue;
+            }
+        }
+        adc_data[adc_count++] = adc_data[i];
+    }
+    *adc_data_length = adc_count;
+    *temperature_data_length = temperature_count;
+
+    return AD5940ERR_OK;
+}
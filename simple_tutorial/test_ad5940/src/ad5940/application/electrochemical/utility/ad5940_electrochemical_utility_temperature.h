@@ -0,0 +1,120 @@
+/**
+ * @file ad5940_electrochemical_utility_temperature.h
+ * @brief Interleaves temperature sensor conversions into electrochemical scans.
+ *
+ * Every `interval` ADC data, the wakeup timer runs the temperature sequence instead of
+ * the ADC sequence. It converts the electrochemical ADC data like the ADC sequence,
+ * then switches the ADC input to the temperature sensor, converts it and switches back.
+ * The scan isn't stopped and the AFE isn't configured again for the temperature.
+ *
+ * Both data of the temperature sequence are tagged with its sequence ID in the FIFO,
+ * see @ref FIFO_SEQID, the electrochemical one first.
+ * @ref AD5940_ELECTROCHEMICAL_UTILITY_temperature_split moves the temperature data out.
+ * They are converted with the ADC PGA gain of the scan,
+ * see @ref AD5940_UTILITY_convert_ADCs_to_temperatures.
+ *
+ * The wakeup timer has 8 slots, the slots of one cycle are repeated until the cycle has
+ * `interval` ADC data. CA takes any interval up to 8. CV, DPV, SWV and LSV have 2 ADC data
+ * in 4 slots, they take 2 or 4. The temperature sequence runs longer than the ADC sequence,
+ * the step after it may be longer by up to the time of the temperature conversion.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+/**
+ * @brief Sequence of the temperature conversions, unused by the electrochemical applications.
+ */
+#define AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID SEQID_3
+
+/**
+ * @brief Sets the number of ADC data between two temperature data for the scans started after.
+ *
+ * @param interval  0 disables the temperature data, the default.
+ */
+void AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(
+    const uint8_t interval
+);
+
+/**
+ * @brief Retrieves the number of FIFO data of a scan, its ADC data and the temperature data among them.
+ *
+ * @param adc_data_count    Number of ADC data of the scan.
+ */
+uint32_t AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(
+    const uint32_t adc_data_count
+);
+
+/**
+ * @brief Writes the temperature sequence into SRAM, nothing if the interval is 0.
+ *
+ * Called after the ADC sequence by @ref AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config
+ * with the same ADC configuration. It also restarts @ref AD5940_ELECTROCHEMICAL_UTILITY_temperature_split.
+ *
+ * @param start_address     First SRAM address of the sequence.
+ * @param end_address       Address after the SRAM region of the sequence.
+ * @param sequence_length   Pointer to retrieve the number of commands, 0 if the interval is 0.
+ *
+ * @return AD5940ERR_OK, AD5940ERR_PARA if the statistics block is enabled,
+ *         as it would average the temperature with the ADC data, or AD5940ERR_BUFF if the sequence doesn't fit.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_write_sequence_commands(
+    const uint32_t start_address,
+    const uint32_t end_address,
+    uint32_t *const sequence_length,
+    const ADCFilterCfg_Type *const adc_filter,
+    const DFTCfg_Type *const dft,
+    const StatCfg_Type *const stat,
+    const AD5940_UTILITY_ClockConfig *const clock,
+    const uint32_t DataType
+);
+
+/**
+ * @brief Repeats the wakeup timer cycle for the interval and replaces its last ADC sequence slot
+ *        by the temperature sequence, nothing is changed if the interval is 0.
+ *
+ * Call it with the complete cycle before @ref AD5940_WUPTCfg, once the ADC input is configured
+ * for the scan. The temperature sequence switches the ADC input back to it.
+ *
+ * @param wupt_cfg  Pointer to the wakeup timer configuration, the ADC sequence slots are found by
+ *                  the sequence ID of @ref AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_seq_info.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the interval doesn't fit into the 8 slots.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(
+    WUPTCfg_Type *const wupt_cfg
+);
+
+/**
+ * @brief Moves the temperature data out of the FIFO data, the ADC data are compacted in place.
+ *
+ * Call it with every FIFO read of the scan in order, a read may end between the two data
+ * of the temperature sequence.
+ *
+ * @param adc_data                      Pointer to the FIFO data, left with the ADC data only.
+ * @param adc_data_length               Pointer to the number of FIFO data, updated to the number of ADC data.
+ * @param temperature_data              Pointer to an array where the temperature data will be stored.
+ * @param temperature_data_length       Pointer to retrieve the number of temperature data.
+ * @param temperature_data_max_length   The maximum capacity of the `temperature_data` array.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_BUFF if `temperature_data` is too short,
+ *         the FIFO data are left as they are then.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_temperature_split(
+    uint32_t *const adc_data,
+    uint16_t *const adc_data_length,
+    uint32_t *const temperature_data,
+    uint16_t *const temperature_data_length,
+    const uint16_t temperature_data_max_length
+);
+
+#ifdef __cplusplus
+}
+#endif
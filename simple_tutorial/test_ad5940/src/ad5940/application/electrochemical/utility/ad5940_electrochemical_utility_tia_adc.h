@@ -23,7 +23,7 @@ extern "C"
 #endif
 
 #include "ad5940.h"
-#include "ad5940_electrochemical_utility.h"
+#include "ad5940_electrochemical_utility_working_electrode.h"
 
 /**
  * @ref LPTIACfg_Type
@@ -77,7 +77,10 @@ typedef struct
     ADCFilterCfg_Type ADCFilterCfg;   /**< ADC filter configuration include SINC3/SINC2/Notch/Average(for DFT only) */
     ADCDigComp_Type ADCDigCompCfg;    /**< ADC digital comparator */
     DFTCfg_Type DftCfg;               /**< DFT configuration include data source, DFT number and Hanning Window */
-    StatCfg_Type StatCfg;             /**< Statistic block */
+    StatCfg_Type StatCfg;             /**< Statistic block. If `StatEnable`, every ADC sequence run converts `StatSample`
+                                           SINC2 results and the FIFO gets their mean with `FIFOSRC_MEAN`
+                                           (or their variance with `FIFOSRC_VAR`), still one word per run.
+                                           `StatDev` rejects the outliers. */
 }
 AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type;
 
@@ -0,0 +1,692 @@
+#include "ad5940_electrochemical_utility_waveform.h"
+
+#include "ad5940.h"
+#include "ad5940_utility.h"
+
+#include "ad5940_electrochemical_utility.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQLEN_ONESTEP 3L  /* How many sequence commands are needed to update LPDAC. */
+
+/**
+ * Generator of the DAC steps, shared by the SRAM writer and the stream.
+ */
+static struct
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    int16_t E_max;
+    uint8_t segment;        /* segments_length for the level reached by the last segment. */
+    uint16_t level;
+    uint8_t phase;
+    uint32_t step;
+    uint32_t step_number;
+}
+_generator;
+
+static void _get_segment(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    const uint8_t segment,
+    int16_t *const E_step_real,
+    uint16_t *const levels_length
+)
+{
+    const int16_t E_begin = waveform->E_vertices[segment];
+    const int16_t E_end = waveform->E_vertices[segment + 1];
+    *E_step_real = (E_end > E_begin) ? waveform->E_step : -waveform->E_step;
+    *levels_length = abs(E_end - E_begin) / waveform->E_step;
+    return;
+}
+
+static uint16_t _get_levels_length(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    const uint8_t segment
+)
+{
+    if(segment == waveform->segments_length) return (waveform->include_end == bTRUE) ? 1 : 0;
+
+    int16_t E_step_real;
+    uint16_t levels_length;
+    _get_segment(waveform, segment, &E_step_real, &levels_length);
+    return levels_length;
+}
+
+static int16_t _get_level(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    const uint8_t segment,
+    const uint16_t level
+)
+{
+    int16_t E_step_real;
+    uint16_t levels_length;
+    if(segment == waveform->segments_length)
+    {
+        /* The level reached by the last segment, its end vertex if the step divides the segment. */
+        _get_segment(waveform, segment - 1, &E_step_real, &levels_length);
+        return waveform->E_vertices[segment - 1] + levels_length * E_step_real;
+    }
+    _get_segment(waveform, segment, &E_step_real, &levels_length);
+    return waveform->E_vertices[segment] + level * E_step_real;
+}
+
+static uint32_t _get_total_levels_length(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform
+)
+{
+    uint32_t total = 0;
+    for(uint8_t i=0; i<=waveform->segments_length; i++)
+    {
+        total += _get_levels_length(waveform, i);
+    }
+    return total;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_check(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform
+)
+{
+    if(waveform->E_step == 0) return AD5940ERR_PARA;
+    if(waveform->segments_length == 0) return AD5940ERR_PARA;
+    if(waveform->segments_length > AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SEGMENT_MAX) return AD5940ERR_PARA;
+    if(waveform->phases_length == 0) return AD5940ERR_PARA;
+    if(waveform->phases_length > AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_PHASE_MAX) return AD5940ERR_PARA;
+    if(_get_total_levels_length(waveform) == 0) return AD5940ERR_PARA;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    uint32_t *const step_number
+)
+{
+    AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_check(waveform);
+    if(error != AD5940ERR_OK) return error;
+
+    *step_number = _get_total_levels_length(waveform) * waveform->phases_length;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_E_max(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    int16_t *const E_max
+)
+{
+    AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_check(waveform);
+    if(error != AD5940ERR_OK) return error;
+
+    *E_max = waveform->E_vertices[0];
+    for(uint8_t i=1; i<=waveform->segments_length; i++)
+    {
+        if(waveform->E_vertices[i] > *E_max) *E_max = waveform->E_vertices[i];
+    }
+
+    int16_t E_phase_max = 0;
+    for(uint8_t i=0; i<waveform->phases_length; i++)
+    {
+        if(waveform->E_phases[i] > E_phase_max) E_phase_max = waveform->E_phases[i];
+    }
+    *E_max += E_phase_max;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_levels(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    int32_t *const levels,
+    uint16_t *const levels_length,
+    const uint16_t levels_max_length
+)
+{
+    AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_check(waveform);
+    if(error != AD5940ERR_OK) return error;
+
+    const uint32_t total = _get_total_levels_length(waveform);
+    if(total > levels_max_length) return AD5940ERR_PARA;
+    *levels_length = total;
+
+    uint16_t index = 0;
+    for(uint8_t i=0; i<=waveform->segments_length; i++)
+    {
+        const uint16_t length = _get_levels_length(waveform, i);
+        for(uint16_t j=0; j<length; j++)
+        {
+            levels[index] = _get_level(waveform, i, j);
+            index++;
+        }
+    }
+    return AD5940ERR_OK;
+}
+
+static AD5940Err _next_DAC_step(
+    uint32_t *const lpdac_dat_bit,
+    BoolFlag *const is_last
+)
+{
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform = &_generator.waveform;
+
+    /* Skip segments without level, the waveform is checked to have at least one. */
+    while(_generator.level >= _get_levels_length(waveform, _generator.segment))
+    {
+        _generator.segment = (_generator.segment + 1) % (waveform->segments_length + 1);
+        _generator.level = 0;
+    }
+
+    AD5940Err error = AD5940_UTILITY_get_LPDACDATBIT(
+        _generator.E_max,
+        _get_level(waveform, _generator.segment, _generator.level) + waveform->E_phases[_generator.phase],
+        lpdac_dat_bit
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    _generator.phase++;
+    if(_generator.phase >= waveform->phases_length)
+    {
+        _generator.phase = 0;
+        _generator.level++;
+    }
+    _generator.step++;
+    *is_last = (waveform->repeat == bFALSE && _generator.step >= _generator.step_number) ? bTRUE : bFALSE;
+    return AD5940ERR_OK;
+}
+
+/* Geneate sequence(s) to update DAC step by step */
+/* Note: this function doesn't need sequencer generator */
+
+/**
+* @brief Writes all DAC steps of one scan into SRAM.
+* @details Every step writes the SEQINFO of the other sequence to point to the next step. The last step
+*          points back to the first one for a repeated scan, otherwise to SEQ_STOP.
+*          We don't use sequence generator to save memory.
+*          Check more details from documentation of this example. @ref Ramp_Test_Example
+* @return return error code
+*
+* */
+static AD5940Err _write_DAC_sequence_commands(
+	const uint32_t start_address,
+    const uint16_t seq_info_0,
+    const uint16_t seq_info_1
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+	uint32_t SeqCmdBuff[SEQLEN_ONESTEP];
+    const uint16_t seq_info[2] = {seq_info_0, seq_info_1};
+
+	uint32_t current_address = start_address;
+    uint32_t lpdac_dat_bit;
+    BoolFlag is_last;
+	for(uint32_t i=0; i<_generator.step_number; i++)
+	{
+        error = _next_DAC_step(
+            &lpdac_dat_bit,
+            &is_last
+        );
+        if(error != AD5940ERR_OK) return error;
+
+        const uint32_t next_address = (
+            (i == (_generator.step_number - 1)) && (_generator.waveform.repeat == bTRUE)
+        ) ? start_address : (current_address + SEQLEN_ONESTEP);
+
+		SeqCmdBuff[0] = SEQ_WR(REG_AFE_LPDACDAT0, lpdac_dat_bit);
+		SeqCmdBuff[1] = SEQ_WAIT(10); /* !!!NOTE LPDAC need 10 clocks to update data. Before send AFE to sleep state, wait 10 extra clocks */
+        // Same bit positions in SEQ0INFO to SEQ3INFO
+        SeqCmdBuff[2] = SEQ_WR(
+            seq_info[(i + 1) & 0x01],
+            (next_address << BITP_AFE_SEQ0INFO_ADDR)
+            | (SEQLEN_ONESTEP << BITP_AFE_SEQ0INFO_LEN)
+        );
+		AD5940_SEQCmdWrite(current_address, SeqCmdBuff, SEQLEN_ONESTEP);
+        current_address += SEQLEN_ONESTEP;
+	}
+    if(_generator.waveform.repeat == bFALSE)
+    {
+        SeqCmdBuff[0] = SEQ_STOP();   /* Stop sequencer. */
+        /* Disable sequencer, END of sequencer interrupt is generated. */
+        AD5940_SEQCmdWrite(current_address, SeqCmdBuff, 1);
+    }
+
+    AD5940_WriteReg(
+        seq_info[0],
+        (start_address << BITP_AFE_SEQ0INFO_ADDR)
+        | (SEQLEN_ONESTEP << BITP_AFE_SEQ0INFO_LEN)
+    );
+    AD5940_WriteReg(
+        seq_info[1],
+        ((start_address + SEQLEN_ONESTEP) << BITP_AFE_SEQ0INFO_ADDR)
+        | (SEQLEN_ONESTEP << BITP_AFE_SEQ0INFO_LEN)
+    );
+
+	return AD5940ERR_OK;
+}
+
+/**
+ * @brief Writes the DAC steps of the waveform after the ADC sequence and configures the two DAC sequences.
+ *
+ * Even steps are run by the sequence of `seq_info_0`, odd steps by `seq_info_1`.
+ * The steps are streamed if they don't fit into the electrochemical region.
+ */
+static AD5940Err _write_waveform_sequence_commands(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    const uint32_t start_address,
+    const uint16_t seq_info_0,
+    const uint16_t seq_info_1
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop();
+
+    memcpy(&_generator.waveform, waveform, sizeof(AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM));
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+        &_generator.waveform,
+        &_generator.step_number
+    );
+    if(error != AD5940ERR_OK) return error;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_E_max(
+        &_generator.waveform,
+        &_generator.E_max
+    );
+    if(error != AD5940ERR_OK) return error;
+    _generator.segment = 0;
+    _generator.level = 0;
+    _generator.phase = 0;
+    _generator.step = 0;
+
+    /* A finite scan needs one more command to stop the sequencer. */
+    if(AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_needed(
+        start_address,
+        _generator.step_number,
+        (waveform->repeat == bTRUE) ? 0 : 1
+    ))
+    {
+        return AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_start(
+            start_address,
+            seq_info_0,
+            seq_info_1,
+            _next_DAC_step
+        );
+    }
+
+    return _write_DAC_sequence_commands(
+        start_address,
+        seq_info_0,
+        seq_info_1
+    );
+}
+
+/* The DAC sequences, even steps by DAC0 and odd steps by DAC1. */
+static const SEQInfo_Type _DAC0_seq_info = {
+    .SeqId = SEQID_1,
+    .WriteSRAM = bFALSE,
+};
+#define DAC0_REG_AFE_SEQINFO REG_AFE_SEQ1INFO
+
+static const SEQInfo_Type _DAC1_seq_info = {
+    .SeqId = SEQID_2,
+    .WriteSRAM = bFALSE,
+};
+#define DAC1_REG_AFE_SEQINFO REG_AFE_SEQ2INFO
+
+#define CARRY_MAX (2 * AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_PHASE_MAX)
+
+/**
+ * State of the running scan, kept from the start to the stop for the interrupts.
+ */
+static struct
+{
+    BoolFlag repeat;
+    uint8_t phases_length;
+    uint32_t FIFOThresh;        /* Threshold after the first interrupt of a repeated scan. */
+    BoolFlag first;
+    uint8_t phase;              /* Phase of the next ADC data read from the FIFO. */
+    BoolFlag is_temperature;    /* The next data of the temperature sequence is the temperature. */
+    uint32_t carry[CARRY_MAX];  /* Data of the level still converted, returned by the next interrupt. */
+    uint8_t carry_length;
+}
+_scan;
+
+static AD5940Err _write_sequence_commands(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    uint32_t sequence_address = 0x00;
+
+    error = AD5940_ELECTROCHEMICAL_UTILITY_write_sequence_commands_config(
+        &sequence_address,
+        &(config->utility_DSPCfg_Type->ADCFilterCfg),
+        &(config->utility_DSPCfg_Type->DftCfg),
+        &(config->utility_DSPCfg_Type->StatCfg),
+        config->clock,
+        config->DataType
+    );
+    if(error != AD5940ERR_OK) return AD5940ERR_PARA;
+
+    error = _write_waveform_sequence_commands(
+        &(scan->waveform),
+        sequence_address,
+        DAC0_REG_AFE_SEQINFO,
+        DAC1_REG_AFE_SEQINFO
+    );
+    if(error != AD5940ERR_OK) return AD5940ERR_PARA;
+
+    return AD5940ERR_OK;
+}
+
+static uint32_t _get_FIFOThresh(
+    const uint16_t fifo_count
+)
+{
+    uint32_t FIFOThresh = AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(fifo_count);
+    /* A streamed scan drains the FIFO at every refill, the threshold only has to be valid. */
+    if(FIFOThresh > AD5940_ELECTROCHEMICAL_UTILITY_DATA_FIFO_SIZE) FIFOThresh = AD5940_ELECTROCHEMICAL_UTILITY_DATA_FIFO_SIZE;
+    return FIFOThresh;
+}
+
+static AD5940Err _start_wakeup_timer_sequence(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const uint32_t FifoSrc,
+    const float LFOSC_frequency
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    /* Configure FIFO and Sequencer for normal Amperometric Measurement */
+    AD5940_FIFOThrshSet(_get_FIFOThresh(scan->fifo_count_first));
+    AD5940_FIFOCtrlS(FifoSrc, bTRUE);
+
+    AD5940_SEQCtrlS(bTRUE);
+
+    SEQInfo_Type *ADC_seq_info;
+    AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_seq_info(
+        &ADC_seq_info
+    );
+
+    /* Configure Wakeup Timer, the ADC samples at the end of every DAC step. */
+	WUPTCfg_Type wupt_cfg = {0};
+	wupt_cfg.WuptEn = bTRUE;
+	wupt_cfg.WuptEndSeq = WUPTENDSEQ_D;
+	wupt_cfg.WuptOrder[0] = _DAC0_seq_info.SeqId;
+	wupt_cfg.WuptOrder[1] = ADC_seq_info->SeqId;
+	wupt_cfg.WuptOrder[2] = _DAC1_seq_info.SeqId;
+	wupt_cfg.WuptOrder[3] = ADC_seq_info->SeqId;
+	wupt_cfg.SeqxSleepTime[ADC_seq_info->SeqId] = 1;        // The minimum value is 1. Do not set it to zero. Set it to 1 will spend 2 32kHz clock.
+	wupt_cfg.SeqxWakeupTime[ADC_seq_info->SeqId] = (uint32_t)(LFOSC_frequency * AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY * 1E-3F) - 1;
+	wupt_cfg.SeqxSleepTime[_DAC0_seq_info.SeqId] = 1;       // The minimum value is 1. Do not set it to zero. Set it to 1 will spend 2 32kHz clock.
+	wupt_cfg.SeqxWakeupTime[_DAC0_seq_info.SeqId] = (uint32_t)(LFOSC_frequency * (scan->t_steps[0] - AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY) * 1E-3F) - 1;
+	wupt_cfg.SeqxSleepTime[_DAC1_seq_info.SeqId] = 1;       // The minimum value is 1. Do not set it to zero. Set it to 1 will spend 2 32kHz clock.
+	wupt_cfg.SeqxWakeupTime[_DAC1_seq_info.SeqId] = (uint32_t)(LFOSC_frequency * (scan->t_steps[1] - AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY) * 1E-3F) - 1;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&wupt_cfg);
+    if(error != AD5940ERR_OK) return error;
+    AD5940_WUPTCfg(&wupt_cfg);
+
+    return AD5940ERR_OK;
+}
+
+/**
+ * @brief Starts the scan with either TIA, `utility_LPTIACfg_Type` selects the LPTIA if not NULL.
+ */
+static AD5940Err _start(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config,
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type *const utility_LPTIACfg_Type,
+    const AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE working_electrode,
+    const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type *const utility_HSTIACfg_Type
+)
+{
+    AD5940Err error = AD5940ERR_OK;
+
+    int16_t E_max;
+    error = AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_E_max(&(scan->waveform), &E_max);
+    if(error != AD5940ERR_OK) return error;
+
+    /* Wakeup AFE by read register, read 10 times at most */
+    if(AD5940_WakeUp(10) > 10) return AD5940ERR_WAKEUP;  /* Wakeup Failed */
+
+    /**
+     * Before the application begins, INT are used for configuring parameters.
+     * Therefore, they should not be used during the configuration process itself.
+     */
+    AD5940_UTILITY_clear_GPIO_and_INT_flag();
+
+    if(utility_LPTIACfg_Type != NULL)
+    {
+        error = AD5940_ELECTROCHEMICAL_UTILITY_AFE_LPDAC_LPTIA_config(
+            scan->waveform.E_vertices[0],
+            E_max,
+            config->utility_AFERefCfg_Type
+        );
+    }
+    else
+    {
+        error = AD5940_ELECTROCHEMICAL_UTILITY_AFE_LPDAC_HSTIA_config(
+            scan->waveform.E_vertices[0],
+            E_max,
+            config->utility_AFERefCfg_Type
+        );
+    }
+    if(error != AD5940ERR_OK) return error;
+
+    error = _write_sequence_commands(
+        scan,
+        config
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    if(utility_LPTIACfg_Type != NULL)
+    {
+        error = AD5940_ELECTROCHEMICAL_UTILITY_LPDAC_LPTIA_ADC_config(
+            config->utility_LPPACfg_Type,
+            utility_LPTIACfg_Type,
+            config->utility_DSPCfg_Type
+        );
+    }
+    else
+    {
+        error = AD5940_ELECTROCHEMICAL_UTILITY_LPDAC_HSTIA_ADC_config(
+            working_electrode,
+            config->utility_LPPACfg_Type,
+            utility_HSTIACfg_Type,
+            config->utility_DSPCfg_Type
+        );
+    }
+    if(error != AD5940ERR_OK) return error;
+
+    // Ensure it is cleared as ad5940.c relies on the INTC flag as well.
+    AD5940_INTCClrFlag(AFEINTSRC_ALLINT);
+
+    /* A repeated scan never stops the sequencer. */
+    AGPIOCfg_Type agpio_cfg;
+    memcpy(&agpio_cfg, config->agpio_cfg, sizeof(AGPIOCfg_Type));
+    AD5940_UTILITY_set_INTCCfg_by_AGPIOCfg_Type(
+        &agpio_cfg,
+        AFEINTSRC_DATAFIFOTHRESH
+        | ((scan->waveform.repeat == bTRUE) ? 0 : AFEINTSRC_ENDSEQ)
+        | ((AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running() == bTRUE) ? AFEINTSRC_CUSTOMINT0 : 0)
+    );
+    AD5940_AGPIOCfg(&agpio_cfg);
+
+    _scan.repeat = scan->waveform.repeat;
+    _scan.phases_length = scan->waveform.phases_length;
+    _scan.FIFOThresh = _get_FIFOThresh(scan->fifo_count);
+    _scan.first = bTRUE;
+    _scan.phase = 0;
+    _scan.is_temperature = bFALSE;
+    _scan.carry_length = 0;
+
+    error = _start_wakeup_timer_sequence(
+        scan,
+        config->FifoSrc,
+        config->LFOSC_frequency
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    return error;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config,
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type *const utility_LPTIACfg_Type
+)
+{
+    return _start(
+        scan,
+        config,
+        utility_LPTIACfg_Type,
+        AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        NULL
+    );
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_start(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config,
+    const AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE working_electrode,
+    const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type *const utility_HSTIACfg_Type
+)
+{
+    return _start(
+        scan,
+        config,
+        NULL,
+        working_electrode,
+        utility_HSTIACfg_Type
+    );
+}
+
+/**
+ * @brief Reads the FIFO after the data kept from the last read.
+ *
+ * The ADC data are counted through the phases of the levels, the data of the temperature
+ * sequence alternate between an ADC data and a temperature, see ad5940_electrochemical_utility_temperature.h.
+ * With `whole_levels`, the data after the last complete level are kept for the next read.
+ */
+static AD5940Err _read_FIFO(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count,
+    const BoolFlag whole_levels
+)
+{
+    const uint32_t FIFO_count = AD5940_FIFOGetCnt();
+    if(_scan.carry_length + FIFO_count > MCU_FIFO_buffer_max_length) return AD5940ERR_BUFF;
+    memcpy(MCU_FIFO_buffer, _scan.carry, _scan.carry_length * sizeof(uint32_t));
+    AD5940_FIFORd(MCU_FIFO_buffer + _scan.carry_length, FIFO_count);
+
+    const uint16_t count = _scan.carry_length + FIFO_count;
+    uint16_t level_end = 0;
+    for(uint16_t i=_scan.carry_length; i<count; i++)
+    {
+        BoolFlag is_ADC = bTRUE;
+        if(FIFO_SEQID(MCU_FIFO_buffer[i]) == AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID)
+        {
+            is_ADC = (_scan.is_temperature == bTRUE) ? bFALSE : bTRUE;
+            _scan.is_temperature = (_scan.is_temperature == bTRUE) ? bFALSE : bTRUE;
+        }
+        if(is_ADC == bTRUE) _scan.phase = (_scan.phase + 1) % _scan.phases_length;
+        if(_scan.phase == 0) level_end = i + 1;
+    }
+
+    _scan.carry_length = 0;
+    if(whole_levels == bTRUE && count - level_end <= CARRY_MAX)
+    {
+        _scan.carry_length = count - level_end;
+        memcpy(_scan.carry, MCU_FIFO_buffer + level_end, _scan.carry_length * sizeof(uint32_t));
+        *AD5940_FIFO_count = level_end;
+    }
+    else
+    {
+        *AD5940_FIFO_count = count;
+    }
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    /* Wakeup AFE by read register, read 10 times at most */
+    if(AD5940_WakeUp(10) > 10) return AD5940ERR_WAKEUP;  /* Wakeup Failed */
+
+    AD5940_SleepKeyCtrlS(SLPKEY_LOCK);  /* We need time to read data from FIFO, so, do not let AD5940 goes to hibernate automatically */
+
+    /* Refill the streamed DAC steps first, the sequencer is already running the other block. */
+    uint32_t AFEIntSrc;
+    AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt(&AFEIntSrc);
+    if(error != AD5940ERR_OK) return error;
+
+    error = _read_FIFO(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count,
+        bTRUE
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_INTCClrFlag(AFEINTSRC_DATAFIFOTHRESH);
+
+    if(_scan.repeat == bTRUE)
+    {
+        /* A streamed scan also drains the FIFO at every refill, only the threshold interrupt ends the first cycle. */
+        if(
+            _scan.first == bTRUE
+            && (
+                (AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running() == bFALSE)
+                || (AFEIntSrc & AFEINTSRC_DATAFIFOTHRESH)
+            )
+        )
+        {
+            AD5940_FIFOThrshSet(_scan.FIFOThresh);
+            _scan.first = bFALSE;
+        }
+    }
+    else if(
+        (AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running() == bFALSE)
+        || !(AFEIntSrc & AFEINTSRC_CUSTOMINT0)
+        || (AFEIntSrc & AFEINTSRC_ENDSEQ)
+    )
+    {
+        /* The scan is finished. */
+        AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop();
+        /* Still locked, so AD5940_UTILITY_shutdown needn't wake AFE up again. It unlocks the key by itself. */
+        AD5940_UTILITY_shutdown();
+        return AD5940ERR_OK;
+    }
+
+    /* The scan goes on. */
+    AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK);
+    AD5940_EnterSleepS();
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+)
+{
+    /* Wakeup AFE by read register, read 10 times at most */
+    if(AD5940_WakeUp(10) > 10) return AD5940ERR_WAKEUP;  /* Wakeup Failed */
+
+    AD5940_SleepKeyCtrlS(SLPKEY_LOCK);  /* We need time to read data from FIFO, so, do not let AD5940 goes to hibernate automatically */
+
+    AD5940Err error = _read_FIFO(
+        MCU_FIFO_buffer,
+        MCU_FIFO_buffer_max_length,
+        AD5940_FIFO_count,
+        bFALSE
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    AD5940_INTCClrFlag(AFEINTSRC_DATAFIFOTHRESH);
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop();
+    /* Still locked, so AD5940_UTILITY_shutdown needn't wake AFE up again. It unlocks the key by itself. */
+    AD5940_UTILITY_shutdown();
+
+    return AD5940ERR_OK;
+}
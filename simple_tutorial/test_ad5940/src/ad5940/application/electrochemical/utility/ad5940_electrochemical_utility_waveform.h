@@ -0,0 +1,215 @@
+/**
+ * @file ad5940_electrochemical_utility_waveform.h
+ * @brief Generates the LPDAC steps of staircase and pulse waveforms.
+ *
+ * A waveform is a staircase through its vertices, every level of the staircase
+ * is applied once per phase with the offset of the phase added:
+ * - CV and LSV have one phase without offset.
+ * - DPV has a base phase and a pulse phase.
+ * - SWV has a forward and a reverse phase, symmetric around the level.
+ *
+ * Every phase is one DAC step, run by two sequences alternately as described in
+ * ad5940_electrochemical_utility_dac_stream.h. The steps are written into SRAM
+ * at once, or streamed if they don't fit.
+ *
+ * The techniques describe their scan, @ref AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN,
+ * and leave the AFE configuration, the wakeup timer and the interrupts to this engine.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+#include "ad5940_electrochemical_utility.h"
+
+#define AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SEGMENT_MAX 3   /**< Maximum number of linear segments, 3 for CV. */
+#define AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_PHASE_MAX 2     /**< Maximum number of phases per level. */
+
+/**
+ * @brief Staircase and pulse waveform.
+ */
+typedef struct
+{
+    int16_t E_vertices[AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SEGMENT_MAX + 1];   /**< Potentials of the vertices, in millivolts (mV). */
+    uint8_t segments_length;    /**< Number of segments, segment `i` goes from `E_vertices[i]` to `E_vertices[i+1]`. */
+    uint16_t E_step;            /**< Potential between two levels, in millivolts (mV). */
+    BoolFlag include_end;       /**< The level reached by the last segment is applied too.
+                                     Otherwise a segment stops one level before its end vertex. */
+    BoolFlag repeat;            /**< The scan starts again after the last level until it's stopped,
+                                     otherwise the sequencer is stopped after it. */
+    int16_t E_phases[AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_PHASE_MAX];   /**< Offsets added to every level, in millivolts (mV). */
+    uint8_t phases_length;      /**< Number of phases per level. */
+}
+AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM;
+
+/**
+ * @brief Checks the waveform has at least one level.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_check(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform
+);
+
+/**
+ * @brief Retrieves the number of DAC steps of one scan, the number of levels times the number of phases.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the waveform is invalid.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_step_number(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    uint32_t *const step_number
+);
+
+/**
+ * @brief Retrieves the highest potential of the vertices plus the highest positive phase offset,
+ *        the maximum output of the LPDAC configuration.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the waveform is invalid.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_E_max(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    int16_t *const E_max
+);
+
+/**
+ * @brief Generates the levels of one scan, without the phase offsets.
+ *
+ * @param waveform              Pointer to the waveform.
+ * @param levels                Pointer to an array where the levels, in millivolts (mV), will be stored.
+ * @param levels_length         Pointer to a variable to store the number of levels.
+ * @param levels_max_length     The maximum capacity of the `levels` array.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the waveform is invalid or `levels` is too short.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_get_levels(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM *const waveform,
+    int32_t *const levels,
+    uint16_t *const levels_length,
+    const uint16_t levels_max_length
+);
+
+#define AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SAMPLE_DELAY 25  /**< Time from the ADC sample to the end of its DAC step, in milliseconds (ms). */
+
+/**
+ * @brief Scan of a technique, its waveform and the timing of its DAC steps.
+ */
+typedef struct
+{
+    AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM waveform;
+    float t_steps[2];           /**< Durations of the even and the odd DAC steps, in milliseconds (ms).
+                                     Both must be longer than the sample delay. */
+    uint16_t fifo_count_first;  /**< Number of ADC data until the first FIFO threshold interrupt. */
+    uint16_t fifo_count;        /**< Number of ADC data between the next interrupts of a repeated scan,
+                                     the same as `fifo_count_first` for a scan that stops. */
+}
+AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN;
+
+/**
+ * @brief Configuration of the AFE shared by the voltammetry techniques.
+ */
+typedef struct
+{
+    float LFOSC_frequency;                      /**< Low-frequency oscillator frequency, used for internal timing. */
+    const AD5940_UTILITY_ClockConfig *clock;    /**< Pointer to clock configuration. */
+    const AGPIOCfg_Type *agpio_cfg;             /**< Pointer to GPIO configuration. */
+
+    const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type *utility_AFERefCfg_Type;    /**< Pointer to AFE reference configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type *utility_LPPACfg_Type;        /**< Pointer to LPPA configuration. */
+    const AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type *utility_DSPCfg_Type;          /**< Pointer to DSP configuration. */
+
+    uint32_t DataType; /**< Data type configuration. @ref DATATYPE_Const. */
+    uint32_t FifoSrc;  /**< FIFO source configuration. @ref FIFOSRC_Const*/
+}
+AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG;
+
+/**
+ * @brief Initializer of @ref AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG from the
+ *        configuration of a technique, which has the same fields.
+ */
+#define AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG_OF(technique_config) { \
+    .LFOSC_frequency = (technique_config)->LFOSC_frequency, \
+    .clock = (technique_config)->clock, \
+    .agpio_cfg = (technique_config)->agpio_cfg, \
+    .utility_AFERefCfg_Type = (technique_config)->utility_AFERefCfg_Type, \
+    .utility_LPPACfg_Type = (technique_config)->utility_LPPACfg_Type, \
+    .utility_DSPCfg_Type = (technique_config)->utility_DSPCfg_Type, \
+    .DataType = (technique_config)->DataType, \
+    .FifoSrc = (technique_config)->FifoSrc, \
+}
+
+/**
+ * @brief Starts the scan with the LPTIA.
+ *
+ * Configures the AFE for the potential range of the waveform, writes the ADC sequence and the
+ * DAC steps, see @ref AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_is_running for a scan that doesn't fit
+ * into SRAM, and starts the wakeup timer. Every DAC step is followed by an ADC data, sampled
+ * the sample delay before the end of the step.
+ *
+ * @param scan                      Pointer to the scan, the waveform is copied.
+ * @param config                    Pointer to the AFE configuration.
+ * @param utility_LPTIACfg_Type     Pointer to LPTIA configuration.
+ *
+ * @return AD5940ERR_OK, AD5940ERR_PARA if the waveform is invalid, or the error of the AFE configuration.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_start_with_LPTIA(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config,
+    const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type *const utility_LPTIACfg_Type
+);
+
+/**
+ * @brief Starts the scan with the HSTIA, see @ref AD5940_ELECTROCHEMICAL_UTILITY_waveform_start_with_LPTIA.
+ *
+ * @param working_electrode         Type of working electrode. See @ref AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE.
+ * @param utility_HSTIACfg_Type     Pointer to HSTIA configuration.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_start(
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_SCAN *const scan,
+    const AD5940_ELECTROCHEMICAL_UTILITY_WAVEFORM_CONFIG *const config,
+    const AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE working_electrode,
+    const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type *const utility_HSTIACfg_Type
+);
+
+/**
+ * @brief Handles the interrupts of the running scan.
+ *
+ * Refills the streamed DAC steps and reads the FIFO. The data returned always start with
+ * the first phase of a level and hold whole levels, the data of a level still being converted
+ * are returned by the next call. A scan that stops shuts the AFE down after its last data,
+ * a repeated scan runs until @ref AD5940_ELECTROCHEMICAL_UTILITY_waveform_stop.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer to store FIFO data.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to retrieve the number of data stored.
+ *
+ * @return AD5940ERR_OK, AD5940ERR_BUFF if the buffer is too short, or the error of the stream.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_interrupt(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+/**
+ * @brief Stops the scan and shuts the AFE down, the remaining data are read even if a level is incomplete.
+ *
+ * @param MCU_FIFO_buffer            Pointer to the buffer where remaining FIFO data will be stored.
+ * @param MCU_FIFO_buffer_max_length Maximum length of the MCU FIFO buffer.
+ * @param AD5940_FIFO_count          Pointer to retrieve the number of data stored.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_BUFF if the buffer is too short.
+ */
+AD5940Err AD5940_ELECTROCHEMICAL_UTILITY_waveform_stop(
+    uint32_t *const MCU_FIFO_buffer,
+    const uint16_t MCU_FIFO_buffer_max_length,
+    uint16_t *const AD5940_FIFO_count
+);
+
+#ifdef __cplusplus
+}
+#endif
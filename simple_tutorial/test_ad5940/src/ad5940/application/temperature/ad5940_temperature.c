@@ -4,6 +4,8 @@
 #include "ad5940_utility.h"
 #include "ad5940_temperature_utility.h"
 
+#include "ad5940_compiled_sequences.h"
+
 static void _get_SEQCfg_Type(
     SEQCfg_Type *const type, 
     BoolFlag enable
@@ -71,13 +73,16 @@ static void _ad5940_analog_config(
     return;
 }
 
+/* Persistent SRAM slot, the sequence stays resident while other applications run. */
+static const char _sequence_memory_name[] = "temperature";
+
 static SEQInfo_Type _temperature_seq_info = {
     .SeqId = SEQID_0,       // use SEQ0 to run this sequence
     .WriteSRAM = bTRUE,     // we need to write this sequence to AD5940 SRAM.
 };
 
 static AD5940Err _write_temperature_sequence_commands(
-	const uint32_t start_address,
+	uint32_t *const start_address,
     uint32_t *const sequence_length,
     const AD5940_TEMPERATURE_ANALOG_CONFIG *const analog,
     const AD5940_UTILITY_ClockConfig *const clock
@@ -97,24 +102,42 @@ static AD5940Err _write_temperature_sequence_commands(
     clks_cal.RatioSys2AdcClk = clock->RatioSys2AdcClk; /* Assume ADC clock is same as system clock */
     AD5940_ClksCalculate(&clks_cal, &WaitClks);
 
-    //generate sequence to measure temperature sensor output
-    AD5940_SEQGenCtrl(bTRUE); //from now on, record all register operations rather than write them to AD5940 through SPI.
+    /* Use the sequence compiled offline if it's valid, the sequence generator buffer is not touched. */
+    error = AD5940_UTILITY_find_compiled_sequence(
+        AD5940_COMPILED_SEQUENCES_temperature,
+        AD5940_COMPILED_SEQUENCES_temperature_length,
+        WaitClks,
+        &pSeqCmd,
+        &seq_len
+    );
+    if(error != AD5940ERR_OK)
+    {
+        //generate sequence to measure temperature sensor output
+        AD5940_SEQGenCtrl(bTRUE); //from now on, record all register operations rather than write them to AD5940 through SPI.
 
-    AD5940_AFECtrlS(AFECTRL_ADCPWR, bTRUE); /* Turn ON ADC power */
-    AD5940_SEQGenInsert(SEQ_WAIT(16*50));   /* wait another 50us for ADC to settle. */
-    AD5940_AFECtrlS(AFECTRL_TEMPCNV|AFECTRL_ADCCNV, bTRUE);  /* Start ADC convert */
-    AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));
-    AD5940_AFECtrlS(AFECTRL_ADCPWR|AFECTRL_TEMPCNV, bFALSE);    /* Stop ADC */
-    AD5940_SEQGenInsert(SEQ_WAIT(20));			/* Add some delay before put AD5940 to hibernate, needs some clock to move data to FIFO. */
-    AD5940_EnterSleepS();/* Goto hibernate */
+        AD5940_AFECtrlS(AFECTRL_ADCPWR, bTRUE); /* Turn ON ADC power */
+        AD5940_SEQGenInsert(SEQ_WAIT(16*50));   /* wait another 50us for ADC to settle. */
+        AD5940_AFECtrlS(AFECTRL_TEMPCNV|AFECTRL_ADCCNV, bTRUE);  /* Start ADC convert */
+        AD5940_SEQGenInsert(SEQ_WAIT(WaitClks));
+        AD5940_AFECtrlS(AFECTRL_ADCPWR|AFECTRL_TEMPCNV, bFALSE);    /* Stop ADC */
+        AD5940_SEQGenInsert(SEQ_WAIT(20));			/* Add some delay before put AD5940 to hibernate, needs some clock to move data to FIFO. */
+        AD5940_EnterSleepS();/* Goto hibernate */
 
-    AD5940_SEQGenCtrl(bFALSE);  /* stop sequence generator */
-    error = AD5940_SEQGenFetchSeq(&pSeqCmd, &seq_len);
+        AD5940_SEQGenCtrl(bFALSE);  /* stop sequence generator */
+        error = AD5940_SEQGenFetchSeq(&pSeqCmd, &seq_len);
 
+        if(error != AD5940ERR_OK) return error;
+    }
+
+    error = AD5940_UTILITY_sequence_memory_allocate(
+        _sequence_memory_name,
+        seq_len,
+        start_address
+    );
     if(error != AD5940ERR_OK) return error;
 
     *sequence_length = seq_len;
-    _temperature_seq_info.SeqRamAddr = start_address;
+    _temperature_seq_info.SeqRamAddr = *start_address;
     _temperature_seq_info.pSeqCmd = pSeqCmd;
     _temperature_seq_info.SeqLen = seq_len;
     AD5940_SEQInfoCfg(&_temperature_seq_info);
@@ -150,7 +173,7 @@ static AD5940Err _write_sequence_commands(
 	uint32_t sequence_address = 0x00000000;
     uint32_t sequence_commands_length = 0;
     error = _write_temperature_sequence_commands(
-        sequence_address,
+        &sequence_address,
         &sequence_commands_length,
         config,
         clock
@@ -203,10 +226,11 @@ AD5940Err AD5940_TEMPERATURE_start(
         config->analog,
         config->clock
     );
-    _write_sequence_commands(
+    error = _write_sequence_commands(
         config->analog,
         config->clock
     );
+    if(error) return error;
 
     // Ensure it is cleared as ad5940.c relies on the INTC flag as well.
     AD5940_INTCClrFlag(AFEINTSRC_ALLINT);
@@ -257,18 +281,18 @@ AD5940Err AD5940_TEMPERATURE_interrupt(
     if(*AD5940_FIFO_count > MCU_FIFO_buffer_max_length) return AD5940ERR_BUFF;
     AD5940_FIFORd(MCU_FIFO_buffer, *AD5940_FIFO_count);
 
-    // Enable AFE to enter sleep mode.
-    AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK); /* Unlock so sequencer can put AD5940 to sleep */
-
     AD5940_INTCClrFlag(AFEINTSRC_DATAFIFOTHRESH);
     if(AD5940_FIFO_new_thresh > 0)
     {
+        // Enable AFE to enter sleep mode.
+        AD5940_SleepKeyCtrlS(SLPKEY_UNLOCK); /* Unlock so sequencer can put AD5940 to sleep */
         AD5940_FIFOThrshSet(AD5940_FIFO_new_thresh);
         AD5940_EnterSleepS();
     }
     else
     {
         AD5940_WriteReg(REG_AFE_TEMPSENS, 0x0);
+        /* Still locked, so AD5940_UTILITY_shutdown needn't wake AFE up again. It unlocks the key by itself. */
         AD5940_UTILITY_shutdown();
     }
 
@@ -102,8 +102,25 @@ struct
   SEQGenRegInfo_Type *pRegInfo; /**< Pointer to buffer where stores register info */
   uint32_t RegCount;            /**< The count of register info available in buffer *pRegInfo. */
   AD5940Err LastError;          /**< The last error message. */
+  uint32_t RegValid[256/32];    /**< Bit n set means register with 8bit address n has a record in RegInfo */
+  uint8_t RegSlot[256];         /**< Insert order of the record of register with 8bit address n, 0 is the first record */
+  void (*pDefaultHook)(uint16_t RegAddr, uint32_t RegData); /**< Called with every register default read from AD5940 */
 }SeqGenDB;  /* Data base of Seq Generator */
 
+/**
+ * @brief Drop all register records of sequencer generator.
+ * @details The record count, the valid bitmap and the record pointer are reset together, so a stale
+ *          valid bit can't index a record that doesn't exist anymore.
+ * @return None;
+*/
+static void AD5940_SEQGenRegInfoReset(void)
+{
+  if(SeqGenDB.pSeqBuff)
+    SeqGenDB.pRegInfo = (SEQGenRegInfo_Type*)SeqGenDB.pSeqBuff + SeqGenDB.BufferSize - 1; /* Point to the last element in buffer */
+  SeqGenDB.RegCount = 0;
+  memset(SeqGenDB.RegValid, 0, sizeof(SeqGenDB.RegValid));
+}
+
 /**
  * @brief Manually input a command to sequencer generator.
  * @param CmdWord: The 32-bit width sequencer command word. @ref Sequencer_Helper can be used to generate commands.
@@ -125,22 +142,19 @@ void AD5940_SEQGenInsert(uint32_t CmdWord)
 
 /**
  * @brief Search data-base to get current register value.
+ * @details The 8bit register address indexes a bitmap and a slot table, so lookup doesn't depend on sequence length.
  * @param RegAddr: The register address.
  * @param pIndex: Pointer to a variable that used to store index of found register-info.
  * @return Return AD5940ERR_OK if register found in data-base. Otherwise return AD5940ERR_SEQREG.
 */
 static AD5940Err AD5940_SEQGenSearchReg(uint32_t RegAddr, uint32_t *pIndex)
 {
-  uint32_t i;
-
   RegAddr = (RegAddr>>2)&0xff;
-  for(i=0;i<SeqGenDB.SeqLen;i++)
+  if(SeqGenDB.RegValid[RegAddr>>5] & (1L<<(RegAddr&0x1f)))
   {
-    if(RegAddr == SeqGenDB.pRegInfo[i].RegAddr)
-    {
-      *pIndex = i;
-      return AD5940ERR_OK;
-    }
+    /* pRegInfo points to the latest record, the first record is at index RegCount-1 */
+    *pIndex = SeqGenDB.RegCount - 1 - SeqGenDB.RegSlot[RegAddr];
+    return AD5940ERR_OK;
   }
   return AD5940ERR_SEQREG;
 }
@@ -158,9 +172,23 @@ static AD5940Err AD5940_SEQGenGetRegDefault(uint32_t RegAddr, uint32_t *pRegData
 #else
   *pRegData = AD5940_SPIReadReg(RegAddr);
 #endif
+  if(SeqGenDB.pDefaultHook)
+    SeqGenDB.pDefaultHook(RegAddr, *pRegData);
   return AD5940ERR_OK;
 }
 
+/**
+ * @brief Set a function called with every register default value read by sequencer generator.
+ * @details The generated sequence depends on these values only besides the register writes. 
+ *          Offline sequence compilers use it to record the register state a sequence is valid for.
+ * @param pHook: The function, NULL to remove it.
+ * @return Return None.
+*/
+void AD5940_SEQGenDefaultHook(void (*pHook)(uint16_t RegAddr, uint32_t RegData))
+{
+  SeqGenDB.pDefaultHook = pHook;
+}
+
 /**
  * @brief Record the current register info to data-base. Update LastError if there is error.
  * @param RegAddr: The register address.
@@ -177,6 +205,8 @@ static void AD5940_SEQRegInfoInsert(uint16_t RegAddr, uint32_t RegData)
     SeqGenDB.pRegInfo --; /* Move back */
     SeqGenDB.pRegInfo[0].RegAddr = (RegAddr>>2)&0xff;
     SeqGenDB.pRegInfo[0].RegValue = RegData&0x00ffffff;
+    SeqGenDB.RegSlot[SeqGenDB.pRegInfo[0].RegAddr] = SeqGenDB.RegCount;
+    SeqGenDB.RegValid[SeqGenDB.pRegInfo[0].RegAddr>>5] |= 1L<<(SeqGenDB.pRegInfo[0].RegAddr&0x1f);
     SeqGenDB.RegCount ++;
   }
   else  /* There is no more buffer  */
@@ -259,10 +289,9 @@ void AD5940_SEQGenInit(uint32_t *pBuffer, uint32_t BufferSize)
   if(BufferSize < 2) return;
   SeqGenDB.BufferSize = BufferSize;
   SeqGenDB.pSeqBuff = pBuffer;
-  SeqGenDB.pRegInfo = (SEQGenRegInfo_Type*)pBuffer + BufferSize - 1; /* Point to the last element in buffer */
   SeqGenDB.SeqLen = 0;
 
-  SeqGenDB.RegCount = 0;
+  AD5940_SEQGenRegInfoReset();
   SeqGenDB.LastError = AD5940ERR_OK;
   SeqGenDB.EngineStart = bFALSE;
 }
@@ -313,12 +342,23 @@ void AD5940_SEQGenCtrl(BoolFlag bFlag)
  * @return Return Number of ACLK Cycles that a generated sequence will take.
 */
 uint32_t AD5940_SEQCycleTime(void)
+{
+  return AD5940_SEQCmdCycleTime(SeqGenDB.pSeqBuff, SeqGenDB.SeqLen);
+}
+
+/**
+ * @brief Calculate the number of cycles of a sequence command stream, such as a fetched or compiled sequence.
+ * @param pSeqCmd: Pointer to the sequence commands.
+ * @param SeqLen: Number of commands.
+ * @return Return Number of ACLK Cycles that the sequence will take.
+*/
+uint32_t AD5940_SEQCmdCycleTime(const uint32_t *pSeqCmd, uint32_t SeqLen)
 {
   uint32_t i, Cycles, Cmd;  
   Cycles = 0;
-  for(i=0;i<SeqGenDB.RegCount;i++)
+  for(i=0;i<SeqLen;i++)
   {
-    Cmd = (SeqGenDB.pSeqBuff[i]  >> 30) & 0x3;
+    Cmd = (pSeqCmd[i]  >> 30) & 0x3;
     if (Cmd & 0x2)
     {
       /* A write command */
@@ -334,7 +374,7 @@ uint32_t AD5940_SEQCycleTime(void)
       else
         {
           /* Wait command */
-          Cycles += SeqGenDB.pSeqBuff[i] & 0x3FFFFFFF;
+          Cycles += pSeqCmd[i] & 0x3FFFFFFF;
         }
     }
   } 
@@ -930,57 +970,550 @@ static uint32_t AD5940_ReadWrite32B(uint32_t data)
    return (((uint32_t)RecvBuffer[0])<<24)|(((uint32_t)RecvBuffer[1])<<16)|(((uint32_t)RecvBuffer[2])<<8)|RecvBuffer[3];
 }
 
+/**
+ * @brief Put register address and data in big-endian order to buffer.
+ * @param pBuffer: The buffer to store the register data.
+ * @param RegAddr: The register address. It decides the data width.
+ * @param RegData: The register data.
+ * @return Return number of bytes put to buffer.
+**/
+static uint32_t AD5940_SPIPackRegData(uint8_t *pBuffer, uint16_t RegAddr, uint32_t RegData)
+{
+  if(((RegAddr>=0x1000)&&(RegAddr<=0x3014)))  /* 32bit register */
+  {
+    pBuffer[0] = (RegData>>24)&0xff;
+    pBuffer[1] = (RegData>>16)&0xff;
+    pBuffer[2] = (RegData>> 8)&0xff;
+    pBuffer[3] = (RegData    )&0xff;
+    return 4;
+  }
+  pBuffer[0] = (RegData>> 8)&0xff;            /* 16bit register */
+  pBuffer[1] = (RegData    )&0xff;
+  return 2;
+}
+
+/**
+ * @brief Set register address through SPI. The SETADDR frame is sent by one transfer.
+ * @param RegAddr: The register address.
+ * @return Return None.
+**/
+static void AD5940_SPISetAddr(uint16_t RegAddr)
+{
+  uint8_t SendBuffer[3], RecvBuffer[3];
+  SendBuffer[0] = SPICMD_SETADDR;
+  SendBuffer[1] = RegAddr>>8;
+  SendBuffer[2] = RegAddr&0xff;
+  AD5940_CsClr();
+  AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, 3);
+  AD5940_CsSet();
+}
+
 /**
  * @brief Write register through SPI.
+ * @details Each CS phase (SETADDR+address, WRITEREG+data) is built in one buffer and sent by one transfer.
  * @param RegAddr: The register address.
  * @param RegData: The register data.
  * @return Return None.
 **/
 static void AD5940_SPIWriteReg(uint16_t RegAddr, uint32_t RegData)
 {  
+  uint8_t SendBuffer[5], RecvBuffer[5];
+  uint32_t Len;
   /* Set register address */
-  AD5940_CsClr();
-  AD5940_ReadWrite8B(SPICMD_SETADDR);
-  AD5940_ReadWrite16B(RegAddr);
-  AD5940_CsSet();
+  AD5940_SPISetAddr(RegAddr);
   /* Add delay here to meet the SPI timing. */
+  SendBuffer[0] = SPICMD_WRITEREG;
+  Len = 1 + AD5940_SPIPackRegData(&SendBuffer[1], RegAddr, RegData);
   AD5940_CsClr();
-  AD5940_ReadWrite8B(SPICMD_WRITEREG);
-  if(((RegAddr>=0x1000)&&(RegAddr<=0x3014)))
-    AD5940_ReadWrite32B(RegData);
-  else
-    AD5940_ReadWrite16B(RegData);
+  AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, Len);
   AD5940_CsSet();
 }
 
 /**
  * @brief Read register through SPI.
+ * @details Each CS phase (SETADDR+address, READREG+dummy+data) is built in one buffer and sent by one transfer.
  * @param RegAddr: The register address.
  * @return Return register data.
 **/
 static uint32_t AD5940_SPIReadReg(uint16_t RegAddr)
 {  
-  uint32_t Data = 0;
+  uint8_t SendBuffer[6] = {0}, RecvBuffer[6];
+  uint32_t Len;
   /* Set register address that we want to read */
+  AD5940_SPISetAddr(RegAddr);
+  /* Read it, one dummy byte is in front of the real data */
+  SendBuffer[0] = SPICMD_READREG;
+  Len = 2 + AD5940_SPIPackRegData(&SendBuffer[2], RegAddr, 0);
   AD5940_CsClr();
-  AD5940_ReadWrite8B(SPICMD_SETADDR);
-  AD5940_ReadWrite16B(RegAddr);
+  AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, Len);
   AD5940_CsSet();
-  /* Read it */
-  AD5940_CsClr();
-  AD5940_ReadWrite8B(SPICMD_READREG);
-  AD5940_ReadWrite8B(0);  //Dummy read
-  /* The real data is coming */
-  if((RegAddr>=0x1000)&&(RegAddr<=0x3014))
-    Data = AD5940_ReadWrite32B(0);
-  else
-    Data = AD5940_ReadWrite16B(0);
-  AD5940_CsSet();
-  return Data;
+  if(Len == 6)
+    return (((uint32_t)RecvBuffer[2])<<24)|(((uint32_t)RecvBuffer[3])<<16)|(((uint32_t)RecvBuffer[4])<<8)|RecvBuffer[5];
+  return (((uint32_t)RecvBuffer[2])<<8)|RecvBuffer[3];
+}
+
+//#define SEQ_CMDWRITE_BURST  /*!< Set CMDFIFOWADDR once and stream all commands to CMDFIFOWRITE. Requires auto-increment of CMDFIFOWADDR, uncomment this line to enable it */
+
+/* The datasheet doesn't say CMDFIFOWADDR increments after a write to CMDFIFOWRITE, and the
+   burst upload hasn't been verified on a real AD5940 yet. Keep it disabled until it is. */
+
+/**
+ * @brief Upload sequencer commands to SRAM through SPI.
+ * @details The SETADDR and WRITEREG frames are prebuilt and sent directly, without going
+ *          through register cache. With SEQ_CMDWRITE_BURST, the SRAM address is set once, SPI
+ *          address is pointed to CMDFIFOWRITE once and every command word then costs one 5-byte
+ *          transfer. Otherwise every word costs four transfers(address and data).
+ * @param StartAddr: The SRAM start address.
+ * @param pCommand: Pointer to sequencer commands.
+ * @param CmdCnt: Number of commands.
+ * @return Return None.
+**/
+static void AD5940_SPISEQCmdWrite(uint32_t StartAddr, const uint32_t *pCommand, uint32_t CmdCnt)
+{
+  uint8_t SendBuffer[5], RecvBuffer[5];
+
+  SendBuffer[0] = SPICMD_WRITEREG;
+#ifdef SEQ_CMDWRITE_BURST
+  AD5940_SPIWriteReg(REG_AFE_CMDFIFOWADDR, StartAddr);
+  AD5940_SPISetAddr(REG_AFE_CMDFIFOWRITE);
+  while(CmdCnt--)
+  {
+    AD5940_SPIPackRegData(&SendBuffer[1], REG_AFE_CMDFIFOWRITE, *pCommand++);
+    AD5940_CsClr();
+    AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, 5);
+    AD5940_CsSet();
+  }
+#else
+  while(CmdCnt--)
+  {
+    AD5940_SPISetAddr(REG_AFE_CMDFIFOWADDR);
+    AD5940_SPIPackRegData(&SendBuffer[1], REG_AFE_CMDFIFOWADDR, StartAddr++);
+    AD5940_CsClr();
+    AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, 5);
+    AD5940_CsSet();
+    AD5940_SPISetAddr(REG_AFE_CMDFIFOWRITE);
+    AD5940_SPIPackRegData(&SendBuffer[1], REG_AFE_CMDFIFOWRITE, *pCommand++);
+    AD5940_CsClr();
+    AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, 5);
+    AD5940_CsSet();
+  }
+#endif
+}
+
+//#define REGISTER_CACHE  /*!< Serve reads of firmware owned control registers from RAM. Only this library may write them, uncomment this line to enable it */
+
+/* The cache can't see writes by another SPI master or by a second driver instance sharing
+   the AD5940, and it's also stale after a reset that doesn't go through AD5940_SoftRst or
+   AD5940_HWReset. Enable it only when this library is the sole owner of the chip. */
+
+#ifdef REGISTER_CACHE
+/**
+ * Control registers that are only changed by firmware or sequencer. Status, data and FIFO 
+ * registers are not listed here so they are always read through SPI.
+*/
+static const uint16_t RegCacheAddr[] =
+{
+  REG_AFE_AFECON, REG_AFE_SEQCON, REG_AFE_FIFOCON, REG_AFE_ADCFILTERCON,
+  REG_AFE_HPOSCCON, REG_AFE_HSRTIACON, REG_AFE_LPMODECON, REG_AFE_BUFSENCON,
+  REG_AFE_ADCCON, REG_AFE_SEQ0INFO, REG_AFE_SEQ1INFO, REG_AFE_SEQ2INFO,
+  REG_AFE_SEQ3INFO, REG_AFE_CMDDATACON, REG_AFE_DATAFIFOTHRES, REG_INTC_INTCSEL0,
+  REG_INTC_INTCSEL1, REG_ALLON_EI0CON, REG_ALLON_EI1CON, REG_WUPTMR_CON,
+  REG_AFECON_CLKSEL, REG_AFECON_CLKEN1,
+};
+#define REGCACHE_SIZE (sizeof(RegCacheAddr)/sizeof(RegCacheAddr[0]))
+
+/**
+ * Write-through register shadow cache.
+*/
+static struct
+{
+  uint32_t Valid;                     /**< Bit n set means RegValue[n] is same as register RegCacheAddr[n] */
+  uint32_t RegValue[REGCACHE_SIZE];   /**< Last value written to or read from register */
+  BoolFlag SeqEnabled;                /**< Sequencer is enabled, it may change the registers by itself */
+  BoolFlag WuptEnabled;               /**< Wakeup timer is enabled, it triggers sequencer */
+  BoolFlag SeqTriggered;              /**< Sequence is triggered by MMR */
+  uint32_t SavedCnt;                  /**< SPI transfers saved by cache hits */
+}RegCache;
+
+/**
+ * @brief Find cache index of register.
+ * @param RegAddr: The register address.
+ * @return Return index of register, or REGCACHE_SIZE if the register is not cacheable.
+**/
+static uint32_t AD5940_RegCacheIndex(uint16_t RegAddr)
+{
+  uint32_t i;
+  for(i=0;i<REGCACHE_SIZE;i++)
+  {
+    if(RegCacheAddr[i] == RegAddr)
+      break;
+  }
+  return i;
 }
 
+/**
+ * @brief Cache is used only when sequencer can't change any register behind firmware.
+ * @return Return bTRUE if cache can be used.
+**/
+static BoolFlag AD5940_RegCacheUsable(void)
+{
+  return (RegCache.SeqEnabled || RegCache.WuptEnabled || RegCache.SeqTriggered)?bFALSE:bTRUE;
+}
+
+/**
+ * @brief Invalidate all cached registers. Called after reset or sequencer is stopped.
+ * @return Return None.
+**/
+void AD5940_RegCacheInvalidate(void)
+{
+  RegCache.Valid = 0;
+  RegCache.SeqEnabled = bFALSE;
+  RegCache.WuptEnabled = bFALSE;
+  RegCache.SeqTriggered = bFALSE;
+}
+
+/**
+ * @brief Get number of SPI transfers saved by cache.
+ * @param bClear: Clear the counter after read. Clear it before measurement starts to get the saving of one start.
+ * @return Return number of saved SPI transfers.
+**/
+uint32_t AD5940_RegCacheSavedCnt(BoolFlag bClear)
+{
+  uint32_t SavedCnt = RegCache.SavedCnt;
+  if(bClear == bTRUE)
+    RegCache.SavedCnt = 0;
+  return SavedCnt;
+}
+
+/**
+ * @brief Track register write. Update the cached value and sequencer state.
+ * @param RegAddr: The register address.
+ * @param RegData: The register data.
+ * @return Return None.
+**/
+static void AD5940_RegCacheWrite(uint16_t RegAddr, uint32_t RegData)
+{
+  uint32_t i;
+  BoolFlag WasUsable = AD5940_RegCacheUsable();
+
+  if(!((RegAddr>=0x1000)&&(RegAddr<=0x3014)))  /* 16bit register */
+    RegData &= 0xffff;
+  switch(RegAddr)
+  {
+    case REG_AFECON_SWRSTCON:
+      AD5940_RegCacheInvalidate();
+      return;
+    case REG_AFE_SEQCON:
+      RegCache.SeqEnabled = (RegData&BITM_AFE_SEQCON_SEQEN)?bTRUE:bFALSE;
+      if(RegCache.SeqEnabled == bFALSE)
+        RegCache.SeqTriggered = bFALSE;
+      break;
+    case REG_WUPTMR_CON:
+      RegCache.WuptEnabled = (RegData&BITM_WUPTMR_CON_EN)?bTRUE:bFALSE;
+      break;
+    case REG_AFECON_TRIGSEQ:
+      RegCache.SeqTriggered = bTRUE;
+      break;
+    default:
+      break;
+  }
+  /* Sequencer may have changed registers when it was running */
+  if(WasUsable == bFALSE)
+    RegCache.Valid = 0;
+  i = AD5940_RegCacheIndex(RegAddr);
+  if(i < REGCACHE_SIZE)
+  {
+    RegCache.RegValue[i] = RegData;
+    RegCache.Valid |= 1L<<i;
+  }
+  if(AD5940_RegCacheUsable() == bFALSE)
+    RegCache.Valid = 0;
+}
+
+/**
+ * @brief Read register from cache or from SPI.
+ * @param RegAddr: The register address.
+ * @return Return register data.
+**/
+static uint32_t AD5940_RegCacheRead(uint16_t RegAddr)
+{
+  uint32_t RegData;
+  uint32_t i = AD5940_RegCacheIndex(RegAddr);
+
+  if(i < REGCACHE_SIZE && AD5940_RegCacheUsable() == bTRUE)
+  {
+    if(RegCache.Valid & (1L<<i))
+    {
+      RegCache.SavedCnt += 2;   /* SETADDR and READREG transfers */
+      return RegCache.RegValue[i];
+    }
+    RegData = AD5940_SPIReadReg(RegAddr);
+    RegCache.RegValue[i] = RegData;
+    RegCache.Valid |= 1L<<i;
+    return RegData;
+  }
+  return AD5940_SPIReadReg(RegAddr);
+}
+#endif
+
+#define AFE_STATE_TRACKER  /*!< Skip wakeup register reads when AFE is known to be awake. Comment this line to remove this feature */
+
+#ifdef AFE_STATE_TRACKER
+/**
+ * AFE power state seen from register writes. AFE can only go to hibernate by itself when 
+ * the sleep key is unlocked and the wakeup timer is running, or when SEQTRGSLP is written.
+*/
+static struct
+{
+  BoolFlag Awake;                     /**< AFE answered the last wakeup and nothing could put it to hibernate since then */
+  BoolFlag KeyLocked;                 /**< SEQSLPLOCK is locked, AFE can't enter hibernate */
+  BoolFlag WuptIdle;                  /**< Wakeup timer is known to be disabled */
+  uint32_t SavedCnt;                  /**< SPI transfers saved by skipped wakeup reads */
+}AfeState;
+
+/**
+ * @brief Forget that AFE is awake. Call it if AFE may be reset or powered off behind the library.
+ * @return Return None.
+**/
+void AD5940_AFEStateInvalidate(void)
+{
+  AfeState.Awake = bFALSE;
+}
+
+/**
+ * @brief Get number of SPI transfers saved by skipped wakeup reads.
+ * @param bClear: Clear the counter after read.
+ * @return Return number of saved SPI transfers.
+**/
+uint32_t AD5940_AFEStateSavedCnt(BoolFlag bClear)
+{
+  uint32_t SavedCnt = AfeState.SavedCnt;
+  if(bClear == bTRUE)
+    AfeState.SavedCnt = 0;
+  return SavedCnt;
+}
+
+/**
+ * @brief AFE is reset, it's active but key and wakeup timer are back to default.
+ * @return Return None.
+**/
+static void AD5940_AFEStateReset(void)
+{
+  AfeState.Awake = bFALSE;
+  AfeState.KeyLocked = bFALSE;
+  AfeState.WuptIdle = bTRUE;
+}
+
+/**
+ * @brief Track register write that may change AFE power state.
+ * @param RegAddr: The register address.
+ * @param RegData: The register data.
+ * @return Return None.
+**/
+static void AD5940_AFEStateWrite(uint16_t RegAddr, uint32_t RegData)
+{
+  switch(RegAddr)
+  {
+    case REG_AFECON_SWRSTCON:
+      AD5940_AFEStateReset();
+      break;
+    case REG_AFE_SEQSLPLOCK:
+      AfeState.KeyLocked = (RegData == SLPKEY_UNLOCK)?bFALSE:bTRUE;
+      break;
+    case REG_WUPTMR_CON:
+      AfeState.WuptIdle = (RegData&BITM_WUPTMR_CON_EN)?bFALSE:bTRUE;
+      break;
+    case REG_AFE_SEQTRGSLP:   /* AD5940_EnterSleepS, AD5940_ShutDownS */
+    case REG_AFECON_TRIGSEQ:  /* Sequence may end with SEQ_SLP */
+      if(AfeState.KeyLocked == bFALSE)
+        AfeState.Awake = bFALSE;
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Check if AFE is surely awake so the wakeup reads can be skipped.
+ * @return Return bTRUE if AFE is awake.
+**/
+static BoolFlag AD5940_AFEStateAwake(void)
+{
+  if(AfeState.Awake == bFALSE)
+    return bFALSE;
+  return (AfeState.KeyLocked || AfeState.WuptIdle)?bTRUE:bFALSE;
+}
+#endif
+
+//#define SEQ_SRAM_RESIDENCY  /*!< Skip upload of sequencer command blocks already resident in SRAM. Uncomment this line to enable it */
+
+/* The block table takes SEQRESIDENT_SIZE*16 bytes of RAM(about 3kB by default) and every
+   AD5940_SEQCmdWrite searches it from the last hit. Enable it when the same blocks are
+   uploaded again and again, e.g. a CV restarted with the same parameters. */
+
+#ifdef SEQ_SRAM_RESIDENCY
+#ifndef SEQRESIDENT_SIZE
+#define SEQRESIDENT_SIZE  192  /*!< Number of command blocks tracked, CV writes one block for every DAC step */
+#endif
+#define SEQRESIDENT_KEYLEN  3   /*!< Words of block key, blocks up to this length are compared command by command */
+
+/**
+ * Command blocks written by AD5940_SEQCmdWrite and still resident in sequencer SRAM.
+ * Hibernate keeps SRAM, only reset or a write to an overlapping range evicts a block.
+*/
+static struct
+{
+  struct
+  {
+    uint16_t StartAddr;               /**< SRAM address of first command */
+    uint16_t CmdCnt;                  /**< Number of commands, 0 means the entry is free */
+    uint32_t Key[SEQRESIDENT_KEYLEN]; /**< The commands, or the first one and their hash if there are more */
+  }Block[SEQRESIDENT_SIZE];
+  uint32_t Hint;                      /**< Entry after the last hit, blocks are usually written in the same order */
+  uint32_t CmdMem;                    /**< Last command memory setting in CMDDATACON */
+  uint32_t SavedCnt;                  /**< Commands not uploaded because they are resident */
+}SeqResident;
+
+/**
+ * @brief Forget all resident blocks. The next AD5940_SEQCmdWrite uploads everything.
+ * @return Return None.
+**/
+void AD5940_SEQResidentClear(void)
+{
+  memset(SeqResident.Block, 0, sizeof(SeqResident.Block));
+  SeqResident.Hint = 0;
+}
+
+/**
+ * @brief Get number of sequencer commands not uploaded because they were resident.
+ * @param bClear: Clear the counter after read.
+ * @return Return number of commands.
+**/
+uint32_t AD5940_SEQResidentSavedCnt(BoolFlag bClear)
+{
+  uint32_t SavedCnt = SeqResident.SavedCnt;
+  if(bClear == bTRUE)
+    SeqResident.SavedCnt = 0;
+  return SavedCnt;
+}
+
+/**
+ * @brief Track register write that may destroy SRAM content.
+ * @param RegAddr: The register address.
+ * @param RegData: The register data.
+ * @return Return None.
+**/
+static void AD5940_SEQResidentWrite(uint16_t RegAddr, uint32_t RegData)
+{
+  switch(RegAddr)
+  {
+    case REG_AFECON_SWRSTCON:
+      AD5940_SEQResidentClear();
+      break;
+    case REG_AFE_CMDDATACON:
+      /* Command memory is resized, data FIFO may take the SRAM of resident blocks */
+      RegData &= BITM_AFE_CMDDATACON_CMD_MEM_SEL|BITM_AFE_CMDDATACON_CMDMEMMDE;
+      if(RegData != SeqResident.CmdMem)
+        AD5940_SEQResidentClear();
+      SeqResident.CmdMem = RegData;
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Get the key a command block is matched by, together with its address and length.
+ * @details Blocks of up to three commands, like the DAC steps of CV, are kept exactly so they can't
+ *          collide. Longer blocks keep their first command and their 64bit FNV-1a hash.
+ * @param pKey: Pointer to the key, SEQRESIDENT_KEYLEN words.
+ * @param pCommand: Pointer to commands.
+ * @param CmdCnt: Number of commands.
+ * @return Return None.
+**/
+static void AD5940_SEQResidentKey(uint32_t *pKey, const uint32_t *pCommand, uint32_t CmdCnt)
+{
+  uint64_t Hash = 14695981039346656037ULL;
+  uint32_t i, j;
+  memset(pKey, 0, SEQRESIDENT_KEYLEN*sizeof(uint32_t));
+  if(CmdCnt <= SEQRESIDENT_KEYLEN)
+  {
+    memcpy(pKey, pCommand, CmdCnt*sizeof(uint32_t));
+    return;
+  }
+  for(i=0;i<CmdCnt;i++)
+  {
+    for(j=0;j<32;j+=8)
+    {
+      Hash ^= (pCommand[i]>>j)&0xff;
+      Hash *= 1099511628211ULL;
+    }
+  }
+  pKey[0] = pCommand[0];
+  pKey[1] = (uint32_t)Hash;
+  pKey[2] = (uint32_t)(Hash>>32);
+}
+
+/**
+ * @brief Check if the command block is resident. If not, record it as resident and evict the blocks it overwrites.
+ * @param StartAddr: SRAM address of first command.
+ * @param pCommand: Pointer to commands.
+ * @param CmdCnt: Number of commands.
+ * @return Return bTRUE if the block is resident and needn't be uploaded.
+**/
+static BoolFlag AD5940_SEQResidentCheck(uint32_t StartAddr, const uint32_t *pCommand, uint32_t CmdCnt)
+{
+  uint32_t i, n, Free = SEQRESIDENT_SIZE;
+  uint32_t Key[SEQRESIDENT_KEYLEN];
+
+  AD5940_SEQResidentKey(Key, pCommand, CmdCnt);
+
+  for(n=0;n<SEQRESIDENT_SIZE;n++)
+  {
+    i = (SeqResident.Hint + n) % SEQRESIDENT_SIZE;
+    if(SeqResident.Block[i].CmdCnt == 0)
+    {
+      if(Free == SEQRESIDENT_SIZE)
+        Free = i;
+      continue;
+    }
+    if(SeqResident.Block[i].StartAddr == StartAddr && SeqResident.Block[i].CmdCnt == CmdCnt && memcmp(SeqResident.Block[i].Key, Key, sizeof(Key)) == 0)
+    {
+      SeqResident.Hint = (i + 1) % SEQRESIDENT_SIZE;
+      SeqResident.SavedCnt += CmdCnt;
+      return bTRUE;
+    }
+    /* Overlapped block is overwritten */
+    if(SeqResident.Block[i].StartAddr < StartAddr + CmdCnt && StartAddr < SeqResident.Block[i].StartAddr + SeqResident.Block[i].CmdCnt)
+    {
+      SeqResident.Block[i].CmdCnt = 0;
+      if(Free == SEQRESIDENT_SIZE)
+        Free = i;
+    }
+  }
+  /* Not tracked if table is full, it will be uploaded again next time */
+  if(Free < SEQRESIDENT_SIZE)
+  {
+    SeqResident.Block[Free].StartAddr = StartAddr;
+    SeqResident.Block[Free].CmdCnt = CmdCnt;
+    memcpy(SeqResident.Block[Free].Key, Key, sizeof(Key));
+    SeqResident.Hint = (Free + 1) % SEQRESIDENT_SIZE;
+  }
+  return bFALSE;
+}
+#endif
+
+#ifndef AD5940_FIFORD_BURST_SIZE
+#define AD5940_FIFORD_BURST_SIZE  64  /*!< FIFO words clocked by one AD5940_ReadWriteNBytes call in burst read mode */
+#endif
+
 /**
   @brief Read specific number of data from FIFO with optimized SPI access.
+  @details When more than two words are requested, the READFIFO command, the 6 dummy bytes and
+           the data words are clocked inside one CS window. Words are packed into chunks of
+           @ref AD5940_FIFORD_BURST_SIZE so the whole FIFO is drained with a few
+           AD5940_ReadWriteNBytes calls instead of one call per byte/word. The last two words are
+           still sent with none-zero offset, the byte stream on the bus is identical to word-by-word access.
   @param pBuffer: Pointer to a buffer that used to store data read back.
   @param uiReadCount: How much data to be read.
   @return none.
@@ -989,7 +1522,7 @@ void AD5940_FIFORd(uint32_t *pBuffer, uint32_t uiReadCount)
 {
   /* Use function AD5940_SPIReadReg to read REG_AFE_DATAFIFORD is also one method. */
    uint32_t i;
-   
+
    if(uiReadCount < 3)
    {
       /* This method is more efficient when readcount < 3 */
@@ -1009,19 +1542,30 @@ void AD5940_FIFORd(uint32_t *pBuffer, uint32_t uiReadCount)
    }
    else
    {
+      /* Command byte and 6 dummy bytes are placed in front of the first chunk */
+      static uint8_t SendBuffer[7 + AD5940_FIFORD_BURST_SIZE*4];
+      static uint8_t RecvBuffer[7 + AD5940_FIFORD_BURST_SIZE*4];
+      uint32_t HeaderLen = 7;
+      uint32_t ChunkLen, j;
+      uint8_t *pData;
+
+      SendBuffer[0] = SPICMD_READFIFO;
+      memset(&SendBuffer[1], 0, 6);
       AD5940_CsClr();
-      AD5940_ReadWrite8B(SPICMD_READFIFO);
-      /* 6 dummy write before valid data read back */
-      for(i=0;i<6;i++)
-         AD5940_ReadWrite8B(0);
-      /* Continuously read DATAFIFORD register with offset 0 */
-      for(i=0;i<uiReadCount-2;i++)
+      for(i=0;i<uiReadCount;i+=ChunkLen)
       {
-         pBuffer[i] = AD5940_ReadWrite32B(0); /*Offset is 0, so we always read DATAFIFORD register */
+         ChunkLen = uiReadCount - i;
+         if(ChunkLen > AD5940_FIFORD_BURST_SIZE)
+            ChunkLen = AD5940_FIFORD_BURST_SIZE;
+         /* Offset is 0, so we always read DATAFIFORD register. Last two FIFO data are read with none-zero offset */
+         for(j=0;j<ChunkLen;j++)
+            memset(&SendBuffer[HeaderLen+j*4], ((i+j) >= (uiReadCount-2))?0x44:0x00, 4);
+         AD5940_ReadWriteNBytes(SendBuffer, RecvBuffer, HeaderLen + ChunkLen*4);
+         pData = &RecvBuffer[HeaderLen];
+         for(j=0;j<ChunkLen;j++, pData+=4)
+            pBuffer[i+j] = (((uint32_t)pData[0])<<24)|(((uint32_t)pData[1])<<16)|(((uint32_t)pData[2])<<8)|pData[3];
+         HeaderLen = 0;
       }
-      /* Read back last two FIFO data with none-zero offset*/
-      pBuffer[i++] = AD5940_ReadWrite32B(0x44444444);
-      pBuffer[i] = AD5940_ReadWrite32B(0x44444444);
       AD5940_CsSet();
    }
 }
@@ -1049,7 +1593,18 @@ void AD5940_WriteReg(uint16_t RegAddr, uint32_t RegData)
 #ifdef CHIPSEL_M355
     AD5940_D2DWriteReg(RegAddr, RegData);
 #else
+  {
+#ifdef REGISTER_CACHE
+    AD5940_RegCacheWrite(RegAddr, RegData);
+#endif
+#ifdef AFE_STATE_TRACKER
+    AD5940_AFEStateWrite(RegAddr, RegData);
+#endif
+#ifdef SEQ_SRAM_RESIDENCY
+    AD5940_SEQResidentWrite(RegAddr, RegData);
+#endif
     AD5940_SPIWriteReg(RegAddr, RegData);
+  }
 #endif
 }
 
@@ -1068,8 +1623,14 @@ uint32_t AD5940_ReadReg(uint16_t RegAddr)
 #endif
 #ifdef CHIPSEL_M355
     return AD5940_D2DReadReg(RegAddr);
+#else
+  {
+#ifdef REGISTER_CACHE
+    return AD5940_RegCacheRead(RegAddr);
 #else
     return AD5940_SPIReadReg(RegAddr);
+#endif
+  }
 #endif
 }
 
@@ -1126,13 +1687,13 @@ void AD5940_Initialize(void)
   };
   //initialize global variables
   SeqGenDB.SeqLen = 0;
-  SeqGenDB.RegCount = 0;
+  AD5940_SEQGenRegInfoReset();
   SeqGenDB.LastError = AD5940ERR_OK;
   SeqGenDB.EngineStart = bFALSE;
 #ifndef CHIPSEL_M355
   AD5940_CsSet(); /* Pull high CS in case it's low */
 #endif
-  for(i=0; i<sizeof(RegTable)/sizeof(RegTable[0]); i++)
+  for(i=0; i<(int)(sizeof(RegTable)/sizeof(RegTable[0])); i++)
     AD5940_WriteReg(RegTable[i].reg_addr, RegTable[i].reg_data);
   i = AD5940_ReadReg(REG_AFECON_CHIPID);  
   if(i == 0x5501)
@@ -2191,10 +2752,24 @@ void AD5940_SEQMmrTrig(uint32_t SeqId)
 
 /**
  * @brief Write sequencer commands to AD5940 SRAM.
+ * @details With SEQ_SRAM_RESIDENCY, a block with same address and commands as one already written is not uploaded again.
  * @return return none.
 **/
 void AD5940_SEQCmdWrite(uint32_t StartAddr, const uint32_t *pCommand, uint32_t CmdCnt)
 {
+#ifndef CHIPSEL_M355
+#ifdef SEQUENCE_GENERATOR
+  if(SeqGenDB.EngineStart == bFALSE)
+#endif
+  {
+#ifdef SEQ_SRAM_RESIDENCY
+    if(AD5940_SEQResidentCheck(StartAddr, pCommand, CmdCnt) == bTRUE)
+      return;
+#endif
+    AD5940_SPISEQCmdWrite(StartAddr, pCommand, CmdCnt);
+    return;
+  }
+#endif
   while(CmdCnt--)
   {
     AD5940_WriteReg(REG_AFE_CMDFIFOWADDR, StartAddr++);
@@ -2947,21 +3522,34 @@ void AD5940_ShutDownS(void)
 /**
  * @brief Try to wakeup AD5940 by read register.
  * @details Any SPI operation can wakeup AD5940. AD5940_Initialize must be called to enable this function.
+ *          With AFE_STATE_TRACKER, no register is read if AFE is known to be awake and can't enter hibernate by itself.
  * @param TryCount Specify how many times we will read register. Zero or negative number means always waiting here.
  * @return How many times register is read. If returned value is bigger than TryCount, it means wakeup failed.
 */
 uint32_t  AD5940_WakeUp(int32_t TryCount)
 {
   uint32_t count = 0;
+#ifdef AFE_STATE_TRACKER
+  if(AD5940_AFEStateAwake() == bTRUE)
+  {
+    AfeState.SavedCnt += 2;   /* SETADDR and READREG transfers */
+    return 1;
+  }
+#endif
   while(1)
   {
     count++;
     if(AD5940_ReadReg(REG_AFECON_ADIID) == AD5940_ADIID)
+    {
+#ifdef AFE_STATE_TRACKER
+      AfeState.Awake = bTRUE;
+#endif
       break;    /* Succeed */
+    }
     if(TryCount<=0) 
       continue; /* Always try to wakeup AFE */
 
-    if(count > TryCount)
+    if(count > (uint32_t)TryCount)
       break;    /* Failed */
   }
   return count;
@@ -3007,6 +3595,15 @@ AD5940Err  AD5940_SoftRst(void)
 void AD5940_HWReset(void)
 {
 #ifndef CHIPSEL_M355
+#ifdef REGISTER_CACHE
+  AD5940_RegCacheInvalidate();
+#endif
+#ifdef AFE_STATE_TRACKER
+  AD5940_AFEStateReset();
+#endif
+#ifdef SEQ_SRAM_RESIDENCY
+  AD5940_SEQResidentClear();
+#endif
   AD5940_RstClr();
   AD5940_Delay10us(200); /* Delay some time */
   AD5940_RstSet();
@@ -3214,7 +3811,7 @@ AD5940Err AD5940_ADCPGACal(ADCPGACal_Type *pADCPGACal)
       uint32_t HSDACCode;
       if(pADCPGACal->ADCPga == ADCPGA_4)
         HSDACCode = 0x800 + 0x300;  /* 0x300--> 0x300/0x1000*0.8*BUFFERGAIN2 = 0.3V. */
-      else if(pADCPGACal->ADCPga == ADCPGA_9)
+      else  /* ADCPGA_9 */
         HSDACCode = 0x800 + 0x155;  /* 0x155--> 0x155/0x1000*0.8*BUFFERGAIN2 = 0.133V. */
       hsloop_cfg.WgCfg.WgCode = HSDACCode;
       AD5940_HSLoopCfgS(&hsloop_cfg);
@@ -3381,6 +3978,7 @@ LPTIAOFFSETCALERROR:
 **/
 AD5940Err AD5940_HSTIAOffsetCal(LPTIAOffsetCal_Type *pHSTIAOffsetCal)
 {
+  (void)pHSTIAOffsetCal;
   return AD5940ERR_OK;
 }
 
@@ -3413,8 +4011,9 @@ AD5940Err AD5940_HSRtiaCal(HSRTIACal_Type *pCalCfg, void *pResult)
   float ExcitVolt; /* Excitation voltage, unit is mV */
   uint32_t RtiaVal;
   uint32_t const HpRtiaTable[]={200,1000,5000,10000,20000,40000,80000,160000,0};
-  uint32_t const HSTIADERLOADTable[]={0,10,30,50,100,999999999999};
-  uint32_t const HSTIADERTIATable[] = {50,100,200,1000,5000,10000,20000,40000,80000,160000,0,999999999999999};
+  /* Open is 1GOhm, so the sum of both open and an external RTIA still fits 32 bits */
+  uint32_t const HSTIADERLOADTable[]={0,10,30,50,100,1000000000};
+  uint32_t const HSTIADERTIATable[] = {50,100,200,1000,5000,10000,20000,40000,80000,160000,0,1000000000};
   uint32_t WgAmpWord;
 
   iImpCar_Type DftRcalVolt, DftRtiaVolt;
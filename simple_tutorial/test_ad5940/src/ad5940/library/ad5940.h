@@ -4768,6 +4768,12 @@ typedef struct
 void      AD5940_WriteReg(uint16_t RegAddr, uint32_t RegData);
 uint32_t  AD5940_ReadReg(uint16_t RegAddr);
 void      AD5940_FIFORd(uint32_t *pBuffer,uint32_t uiReadCount);
+void      AD5940_RegCacheInvalidate(void);      /* Drop all cached register values */
+uint32_t  AD5940_RegCacheSavedCnt(BoolFlag bClear); /* Number of SPI transfers saved by register cache */
+void      AD5940_AFEStateInvalidate(void);      /* Forget that AFE is awake, the next wakeup reads register again */
+uint32_t  AD5940_AFEStateSavedCnt(BoolFlag bClear); /* Number of SPI transfers saved by skipped wakeup reads */
+void      AD5940_SEQResidentClear(void);        /* Forget sequencer command blocks resident in SRAM */
+uint32_t  AD5940_SEQResidentSavedCnt(BoolFlag bClear); /* Number of sequencer commands not uploaded because they were resident */
 
 /* 2. AD5940 Top Control functions */
 void      AD5940_Initialize(void); /* Call this function firstly once AD5940 power on or come from soft reset */
@@ -4887,8 +4893,10 @@ void      AD5940_SEQGenInit(uint32_t *pBuffer, uint32_t BufferSize);/* Initializ
 void      AD5940_SEQGenCtrl(BoolFlag bFlag);  /* Enable or disable sequence generator */
 void      AD5940_SEQGenInsert(uint32_t CmdWord); /* Manually insert a sequence command */
 AD5940Err AD5940_SEQGenFetchSeq(const uint32_t **ppSeqCmd, uint32_t *pSeqCount);  /* Fetch generated sequence and start a new sequence */
+void      AD5940_SEQGenDefaultHook(void (*pHook)(uint16_t RegAddr, uint32_t RegData));  /* Get notified of register defaults read by sequence generator */
 void      AD5940_ClksCalculate(ClksCalInfo_Type *pFilterInfo, uint32_t *pClocks);
 uint32_t  AD5940_SEQCycleTime(void);
+uint32_t  AD5940_SEQCmdCycleTime(const uint32_t *pSeqCmd, uint32_t SeqLen);  /* Number of ACLK cycles of a sequence command stream */
 void      AD5940_SweepNext(SoftSweepCfg_Type *pSweepCfg, float *pNextFreq);
 void      AD5940_StructInit(void *pStruct, uint32_t StructSize);
 float     AD5940_ADCCode2Volt(uint32_t code, uint32_t ADCPga, float VRef1p82); /* Calculate ADC code to voltage */
@@ -12,6 +12,8 @@ extern "C"
 #include "ad5940_utility_lpdac.h"
 #include "ad5940_utility_power.h"
 #include "ad5940_utility_sequence_generator.h"
+#include "ad5940_utility_sequence_memory.h"
+#include "ad5940_utility_sequence_timing.h"
 
 #ifdef __cplusplus
 }
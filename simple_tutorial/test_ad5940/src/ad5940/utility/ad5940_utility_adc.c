@@ -101,6 +101,99 @@ AD5940Err AD5940_UTILITY_get_ADCPGA(
     return AD5940ERR_PARA;
 }
 
+/* Factor of AD5940_ADCCode2Volt. */
+#define ADC_K_FACTOR (1.835 / 1.82)
+/* Temperature sensor, ADC codes per kelvin with a PGA gain of 1. */
+#define TEMPERATURE_K 8.13
+
+/**
+ * Largest shift keeping the scale below 2^31, so a 16-bit code times the scale fits into 47 bits.
+ */
+static AD5940Err _set_fixed_scale(
+    AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const double value_per_code,
+    const double value_offset
+)
+{
+    if(!(value_per_code > 0)) return AD5940ERR_PARA;
+    uint8_t shift = 0;
+    while((shift < 40) && (value_per_code * (double) (1LL << (shift + 1)) < 2147483647.0)) shift++;
+    if(value_per_code * (double) (1LL << shift) >= 2147483647.0) return AD5940ERR_PARA;
+
+    scale->shift = shift;
+    scale->scale = (int32_t) (value_per_code * (double) (1LL << shift) + 0.5);
+    const double offset = value_offset * (double) (1LL << shift);
+    scale->offset = (int64_t) ((offset >= 0) ? (offset + 0.5) : (offset - 0.5));
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_UTILITY_get_current_fixed_scale(
+    AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const fImpPol_Type *const RtiaCalValue,
+    const uint32_t ADCPga,
+    const float VRef1p82
+)
+{
+    float adcpga_float;
+    AD5940Err error = AD5940_UTILITY_get_ADCPGA(
+        ADCPga,
+        &adcpga_float
+    );
+    if(error != AD5940ERR_OK) return AD5940ERR_PARA;
+    if(!(RtiaCalValue->Magnitude > 0)) return AD5940ERR_PARA;
+
+    /* Volt per code divided by the RTIA, in nanoamperes like the float conversion. */
+    return _set_fixed_scale(
+        scale,
+        (double) VRef1p82 * ADC_K_FACTOR * 1e9 / (32768.0 * adcpga_float * RtiaCalValue->Magnitude),
+        0
+    );
+}
+
+AD5940Err AD5940_UTILITY_get_temperature_fixed_scale(
+    AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const uint32_t ADCPga
+)
+{
+    float adcpga_float;
+    AD5940Err error = AD5940_UTILITY_get_ADCPGA(
+        ADCPga,
+        &adcpga_float
+    );
+    if(error != AD5940ERR_OK) return AD5940ERR_PARA;
+
+    /* Microdegrees Celsius. */
+    return _set_fixed_scale(
+        scale,
+        1e6 / (TEMPERATURE_K * adcpga_float),
+        -273.15e6
+    );
+}
+
+void AD5940_UTILITY_convert_ADCs_fixed(
+    int32_t *const values,
+    const uint32_t *const adc_data,
+    const uint16_t adc_data_length,
+    const AD5940_UTILITY_ADC_FIXED_SCALE *const scale
+)
+{
+    /**
+     * One 32x32 to 64-bit multiply (SMLAL on Cortex-M4) per data. Every FIFO word carries
+     * one code and the scale needs more than 16 bits, so the dual 16-bit SIMD instructions don't apply.
+     */
+    const int64_t factor = scale->scale;
+    const int64_t offset = scale->offset;
+    const uint8_t shift = scale->shift;
+    for(uint16_t i=0; i<adc_data_length; i++)
+    {
+        const int32_t code = (int32_t) (adc_data[i] & 0xFFFF) - 0x8000;
+        const int64_t value = code * factor + offset;
+        /* Truncated toward zero like the float to int conversion. */
+        values[i] = (int32_t) ((value >= 0) ? (value >> shift) : -((-value) >> shift));
+    }
+    return;
+}
+
 AD5940Err AD5940_UTILITY_convert_ADCs_to_currents(
     int32_t *const currents, 
     const uint32_t *const adc_data,
@@ -110,21 +203,20 @@ AD5940Err AD5940_UTILITY_convert_ADCs_to_currents(
     const float VRef1p82
 )
 {
-    if(!IS_ADCPGA(ADCPga)) return AD5940ERR_PARA;
-    for(size_t i=0; i<adc_data_length; i++)
-    {
-        currents[i] = (int32_t) (
-            (
-                AD5940_ADCCode2Volt(
-                    adc_data[i] & 0xFFFF, 
-                    ADCPga, 
-                    VRef1p82
-                ) 
-                / RtiaCalValue->Magnitude
-            )
-            * 1e9f
-        );
-    }
+    AD5940_UTILITY_ADC_FIXED_SCALE scale;
+    AD5940Err error = AD5940_UTILITY_get_current_fixed_scale(
+        &scale,
+        RtiaCalValue,
+        ADCPga,
+        VRef1p82
+    );
+    if(error != AD5940ERR_OK) return error;
+    AD5940_UTILITY_convert_ADCs_fixed(
+        currents,
+        adc_data,
+        adc_data_length,
+        &scale
+    );
     return AD5940ERR_OK;
 }
 
@@ -135,18 +227,17 @@ AD5940Err AD5940_UTILITY_convert_ADCs_to_temperatures(
     const uint32_t ADCPga
 )
 {
-    #define K 8.13f
-    float adcpga_float;
-    AD5940Err error = AD5940_UTILITY_get_ADCPGA(
-        ADCPga,
-        &adcpga_float
+    AD5940_UTILITY_ADC_FIXED_SCALE scale;
+    AD5940Err error = AD5940_UTILITY_get_temperature_fixed_scale(
+        &scale,
+        ADCPga
+    );
+    if(error != AD5940ERR_OK) return error;
+    AD5940_UTILITY_convert_ADCs_fixed(
+        temperatures,
+        adc_data,
+        adc_data_length,
+        &scale
     );
-    if(error != AD5940ERR_OK) return AD5940ERR_PARA;
-    for(int i=0; i<adc_data_length; i++)
-    {
-        temperatures[i] = adc_data[i] & 0xffff;
-        temperatures[i] -= 0x8000;	// data from SINC2 is added 0x8000, while data from register TEMPSENSDAT has no 0x8000 offset.
-        temperatures[i] = (temperatures[i] / K / adcpga_float - 273.15f) * 1e6f;
-    }
     return AD5940ERR_OK;
 }
@@ -82,10 +82,73 @@ AD5940Err AD5940_UTILITY_get_ADCPGA(
     float *const ADCPGA
 );
 
+/**
+ * Fixed-point conversion of ADC codes, computed once per measurement by
+ * @ref AD5940_UTILITY_get_current_fixed_scale or @ref AD5940_UTILITY_get_temperature_fixed_scale.
+ * 
+ * A value is `(code - 0x8000) * scale / 2^shift + offset / 2^shift`, truncated toward zero
+ * like the float conversion.
+ */
+typedef struct
+{
+    int32_t scale;      /**< Value per ADC code, in Q`shift`. */
+    uint8_t shift;
+    int64_t offset;     /**< Value of the code 0x8000, in Q`shift`. */
+}
+AD5940_UTILITY_ADC_FIXED_SCALE;
+
+/**
+ * Computes the fixed-point scale of @ref AD5940_UTILITY_convert_ADCs_to_currents.
+ * 
+ * @param scale                 Pointer to store the scale.
+ * @param RtiaCalValue          Pointer to the RTIA calibration result.
+ * @param ADC_PGA_gain          ADC PGA gain value. See @ref ADCPGA_Const.
+ * @param ADC_reference_volt    Reference voltage for the ADC (in volts).
+ * 
+ * @return AD5940Err AD5940ERR_PARA if the PGA gain is invalid or the RTIA magnitude isn't positive.
+ */
+AD5940Err AD5940_UTILITY_get_current_fixed_scale(
+    AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const fImpPol_Type *const RtiaCalValue,
+    const uint32_t ADC_PGA_gain,
+    const float ADC_reference_volt
+);
+
+/**
+ * Computes the fixed-point scale of @ref AD5940_UTILITY_convert_ADCs_to_temperatures.
+ * 
+ * @param scale         Pointer to store the scale.
+ * @param ADCPGA_Const  ADC PGA gain configuration constant. See @ref ADCPGA_Const.
+ * 
+ * @return AD5940Err AD5940ERR_PARA if the PGA gain is invalid.
+ */
+AD5940Err AD5940_UTILITY_get_temperature_fixed_scale(
+    AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const uint32_t ADCPGA_Const
+);
+
+/**
+ * Converts ADC data with an integer multiply and shift per data, no float.
+ * 
+ * Within 1 LSB of the float conversion the scale is computed for, the value of one ADC code
+ * or 1 unit of the values if that's larger, checked by tools/ad5940_emulator_harness/ad5940_adc_fixed_check.c.
+ * 
+ * @param values            Pointer to store the resulting values, can be `adc_data` to convert in place.
+ * @param adc_data          Pointer to the ADC data retrieved from the FIFO.
+ * @param adc_data_length   Number of ADC data points.
+ * @param scale             Pointer to the scale.
+ */
+void AD5940_UTILITY_convert_ADCs_fixed(
+    int32_t *const values,
+    const uint32_t *const adc_data,
+    const uint16_t adc_data_length,
+    const AD5940_UTILITY_ADC_FIXED_SCALE *const scale
+);
+
 /**
  * Converts ADC data to current values.
  * 
- * @param currents              Pointer to store the resulting current values (in microamperes).
+ * @param currents              Pointer to store the resulting current values (in nanoamperes).
  * @param adc_data              Pointer to the ADC data retrieved from the FIFO.
  * @param adc_data_length       Number of ADC data points.
  * @param RtiaCalValue          Pointer to the RTIA calibration result. Available after calibration:
@@ -94,6 +157,9 @@ AD5940Err AD5940_UTILITY_get_ADCPGA(
  * @param ADC_PGA_gain          ADC PGA gain value. See @ref ADCPGA_Const.
  * @param ADC_reference_volt    Reference voltage for the ADC (in volts). Refer to datasheet page 87.
  * 
+ * @note Converting several arrays of one measurement, get the scale once with
+ *       @ref AD5940_UTILITY_get_current_fixed_scale and call @ref AD5940_UTILITY_convert_ADCs_fixed.
+ * 
  * @return AD5940Err Error code indicating the success or failure of the operation.
  */
 AD5940Err AD5940_UTILITY_convert_ADCs_to_currents(
@@ -113,6 +179,9 @@ AD5940Err AD5940_UTILITY_convert_ADCs_to_currents(
  * @param adc_data_length       Number of ADC data points.
  * @param ADCPGA_Const          ADC PGA gain configuration constant. See @ref ADCPGA_Const.
  * 
+ * @note Converting several arrays of one measurement, get the scale once with
+ *       @ref AD5940_UTILITY_get_temperature_fixed_scale and call @ref AD5940_UTILITY_convert_ADCs_fixed.
+ * 
  * @return AD5940Err Error code indicating the success or failure of the operation.
  */
 AD5940Err AD5940_UTILITY_convert_ADCs_to_temperatures(
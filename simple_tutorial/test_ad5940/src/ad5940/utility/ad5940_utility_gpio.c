@@ -8,8 +8,6 @@ void AD5940_UTILITY_clear_GPIO_and_INT_flag(void)
 
     AGPIOCfg_Type gpio_cfg = {0};
     AD5940_AGPIOCfg(&gpio_cfg);
-
-    return AD5940ERR_OK;
 }
 
 void AD5940_UTILITY_get_AfeIntcSel_by_AGPIOCfg_Type(
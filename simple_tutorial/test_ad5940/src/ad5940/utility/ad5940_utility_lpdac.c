@@ -103,7 +103,7 @@ AD5940Err AD5940_UTILITY_get_LPDACDATBITS(
 
     if(*lpdac_dat_6_bit > 0x3F) return AD5940ERR_PARA;
 
-    double V_cal;
+    double V_cal = 0;
     if(V_out_max > 0) V_cal = ((*lpdac_dat_6_bit) * DAC6BITVOLT_1LSB) - V_out_max;
 
     if(V_out_max > 0) *lpdac_dat_12_bit = (uint16_t) (roundf((V_out_max - V_out + V_cal) / DAC12BITVOLT_1LSB));
@@ -67,4 +67,31 @@ AD5940Err AD5940_UTILITY_get_change_sequence_info_command(
     default:
         return AD5940ERR_PARA;
     }
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_UTILITY_find_compiled_sequence(
+    const AD5940_UTILITY_COMPILED_SEQUENCE *const table,
+    const uint16_t table_length,
+    const uint32_t WaitClks,
+    const uint32_t **pSeqCmd,
+    uint32_t *const SeqLen
+)
+{
+    for(uint16_t i=0; i<table_length; i++)
+    {
+        if(table[i].WaitClks != WaitClks) continue;
+
+        uint16_t j;
+        for(j=0; j<table[i].registers_length; j++)
+        {
+            if(AD5940_ReadReg(table[i].registers[j].RegAddr) != table[i].registers[j].RegData) break;
+        }
+        if(j != table[i].registers_length) continue;
+
+        *pSeqCmd = table[i].commands;
+        *SeqLen = table[i].commands_length;
+        return AD5940ERR_OK;
+    }
+    return AD5940ERR_SEQGEN;
 }
@@ -59,6 +59,57 @@ AD5940Err AD5940_UTILITY_get_change_sequence_info_command(
     uint32_t *const sequence_command
 );
 
+/**
+ * Register value read by the sequence generator while a sequence was compiled.
+ */
+typedef struct
+{
+    uint16_t RegAddr;
+    uint32_t RegData;
+}
+AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER;
+
+/**
+ * Sequence generated offline by `tools/ad5940_sequence_compiler` and stored in flash.
+ * 
+ * @note
+ * The ADC sequences only depend on the wait clocks of the conversion and on the
+ * register values the generator read from the AD5940 (`AFECON` for example).
+ * Both are checked before the commands are used.
+ */
+typedef struct
+{
+    uint32_t WaitClks;                                          /**< Result of @ref AD5940_ClksCalculate the sequence was generated with. */
+    const AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER *registers; /**< Register values read by the sequence generator. */
+    uint16_t registers_length;
+    const uint32_t *commands;
+    uint16_t commands_length;
+}
+AD5940_UTILITY_COMPILED_SEQUENCE;
+
+/**
+ * Finds a compiled sequence that is valid for the current register state.
+ * 
+ * @note
+ * The registers are read by `AD5940_ReadReg()`, so AFE must be awake and the
+ * sequence generator must be stopped.
+ * 
+ * @param table         Compiled sequences, see `ad5940_compiled_sequences.h`.
+ * @param table_length  Number of compiled sequences in `table`.
+ * @param WaitClks      Result of @ref AD5940_ClksCalculate for the current parameters.
+ * @param pSeqCmd       Pointer to retrieve the commands in flash.
+ * @param SeqLen        Pointer to retrieve the number of commands.
+ * 
+ * @return AD5940ERR_OK if found, AD5940ERR_SEQGEN if the sequence has to be generated at runtime.
+ */
+AD5940Err AD5940_UTILITY_find_compiled_sequence(
+    const AD5940_UTILITY_COMPILED_SEQUENCE *const table,
+    const uint16_t table_length,
+    const uint32_t WaitClks,
+    const uint32_t **pSeqCmd,
+    uint32_t *const SeqLen
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,201 @@
+#include "ad5940_utility_sequence_memory.h"
+
+#include <string.h>
+
+typedef struct
+{
+    const char *name;   /* NULL if the slot is not allocated. */
+    uint32_t address;
+    uint32_t length;
+    BoolFlag remaining; /* Allocated by AD5940_UTILITY_sequence_memory_allocate_remaining(). */
+}
+_SLOT;
+
+static _SLOT _slots[AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER];
+
+static _SLOT *_find(
+    const char *const name
+)
+{
+    for(uint8_t i=0; i<AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        if(_slots[i].name != NULL && strcmp(_slots[i].name, name) == 0) return &_slots[i];
+    }
+    return NULL;
+}
+
+static _SLOT *_find_unused(void)
+{
+    for(uint8_t i=0; i<AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        if(_slots[i].name == NULL) return &_slots[i];
+    }
+    return NULL;
+}
+
+static BoolFlag _is_overlapped(
+    const _SLOT *const slot,
+    const uint32_t address,
+    const uint32_t length
+)
+{
+    return (slot->address < address + length && address < slot->address + slot->length) ? bTRUE : bFALSE;
+}
+
+/**
+ * @brief Returns bTRUE if [address, address + length) doesn't overlap any slot,
+ *        slots of the remaining memory are ignored if `include_remaining` is bFALSE.
+ */
+static BoolFlag _is_free(
+    const uint32_t address,
+    const uint32_t length,
+    const BoolFlag include_remaining
+)
+{
+    for(uint8_t i=0; i<AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        if(_slots[i].name == NULL) continue;
+        if(_slots[i].remaining && !include_remaining) continue;
+        if(_is_overlapped(&_slots[i], address, length)) return bFALSE;
+    }
+    return bTRUE;
+}
+
+/**
+ * @brief Shrinks the slots of the remaining memory to the part below `address`.
+ */
+static void _shrink_remaining(
+    const uint32_t address,
+    const uint32_t length
+)
+{
+    for(uint8_t i=0; i<AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        if(_slots[i].name == NULL) continue;
+        if(!_slots[i].remaining) continue;
+        if(!_is_overlapped(&_slots[i], address, length)) continue;
+
+        if(_slots[i].address < address) _slots[i].length = address - _slots[i].address;
+        else _slots[i].name = NULL;
+    }
+    return;
+}
+
+AD5940Err AD5940_UTILITY_sequence_memory_allocate(
+    const char *const name,
+    const uint32_t length,
+    uint32_t *const address
+)
+{
+    if(length == 0) return AD5940ERR_PARA;
+    if(length > AD5940_UTILITY_SEQUENCE_MEMORY_SIZE) return AD5940ERR_BUFF;
+
+    _SLOT *slot = _find(name);
+    if(slot != NULL)
+    {
+        if(!slot->remaining && slot->length >= length)
+        {
+            *address = slot->address;
+            return AD5940ERR_OK;
+        }
+        /* The new location may reuse the memory of the old one, the old one is restored if there is none. */
+        slot->name = NULL;
+    }
+    _SLOT *const old_slot = slot;
+
+    /* The highest free address, a slot ends at the top of SRAM or at the start of another slot. */
+    BoolFlag found = bFALSE;
+    uint32_t start = 0;
+    for(uint8_t i=0; i<=AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        uint32_t end;
+        if(i == AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER) end = AD5940_UTILITY_SEQUENCE_MEMORY_SIZE;
+        else if(_slots[i].name != NULL && !_slots[i].remaining) end = _slots[i].address;
+        else continue;
+
+        if(end < length) continue;
+        if(found && end - length <= start) continue;
+        if(!_is_free(end - length, length, bFALSE)) continue;
+        start = end - length;
+        found = bTRUE;
+    }
+    if(!found)
+    {
+        if(old_slot != NULL) old_slot->name = name;
+        return AD5940ERR_BUFF;
+    }
+
+    slot = _find_unused();
+    if(slot == NULL) return AD5940ERR_BUFF;
+
+    _shrink_remaining(start, length);
+    slot->name = name;
+    slot->address = start;
+    slot->length = length;
+    slot->remaining = bFALSE;
+    *address = start;
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_UTILITY_sequence_memory_allocate_remaining(
+    const char *const name,
+    uint32_t *const address,
+    uint32_t *const length
+)
+{
+    _SLOT *slot = _find(name);
+    if(slot != NULL) slot->name = NULL;
+    _SLOT *const old_slot = slot;
+
+    /* The largest free region, the lowest one if several are as large. A region starts at 0 or at the end of a slot. */
+    uint32_t best_start = 0;
+    uint32_t best_length = 0;
+    for(uint8_t i=0; i<=AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; i++)
+    {
+        uint32_t start;
+        if(i == AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER) start = 0;
+        else if(_slots[i].name != NULL) start = _slots[i].address + _slots[i].length;
+        else continue;
+
+        if(start >= AD5940_UTILITY_SEQUENCE_MEMORY_SIZE) continue;
+        if(!_is_free(start, 1, bTRUE)) continue;
+
+        uint32_t end = AD5940_UTILITY_SEQUENCE_MEMORY_SIZE;
+        for(uint8_t j=0; j<AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER; j++)
+        {
+            if(_slots[j].name == NULL) continue;
+            if(_slots[j].address >= start && _slots[j].address < end) end = _slots[j].address;
+        }
+
+        if(end - start > best_length || (end - start == best_length && start < best_start))
+        {
+            best_start = start;
+            best_length = end - start;
+        }
+    }
+    if(best_length == 0)
+    {
+        if(old_slot != NULL) old_slot->name = name;
+        return AD5940ERR_BUFF;
+    }
+
+    slot = _find_unused();
+    if(slot == NULL) return AD5940ERR_BUFF;
+
+    slot->name = name;
+    slot->address = best_start;
+    slot->length = best_length;
+    slot->remaining = bTRUE;
+    *address = best_start;
+    *length = best_length;
+    return AD5940ERR_OK;
+}
+
+void AD5940_UTILITY_sequence_memory_free(
+    const char *const name
+)
+{
+    _SLOT *slot = _find(name);
+    if(slot != NULL) slot->name = NULL;
+    return;
+}
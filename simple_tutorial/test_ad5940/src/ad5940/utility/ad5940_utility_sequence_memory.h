@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+
+/**
+ * Words of SRAM reserved for sequencer commands (`SEQMEMSIZE_2KB`), the rest is data FIFO.
+ */
+#define AD5940_UTILITY_SEQUENCE_MEMORY_SIZE 512
+
+/**
+ * Maximum number of named slots allocated at the same time.
+ */
+#define AD5940_UTILITY_SEQUENCE_MEMORY_SLOT_NUMBER 4
+
+/**
+ * Allocates a persistent named slot in the sequencer SRAM.
+ *
+ * @note
+ * Slots are placed from the top of the SRAM so that the remaining memory at
+ * the bottom stays contiguous, see @ref AD5940_UTILITY_sequence_memory_allocate_remaining.
+ *
+ * A slot keeps its address as long as it is not freed and the requested
+ * `length` fits into it. A sequence written there stays resident, so switching
+ * back to it only needs its `SEQxINFO` rewritten.
+ *
+ * A slot allocated by @ref AD5940_UTILITY_sequence_memory_allocate_remaining
+ * gives up the words this slot needs.
+ *
+ * @param name      Name of the slot, compared by `strcmp()`. The string must stay valid.
+ * @param length    Number of sequencer commands.
+ * @param address   Pointer to retrieve the first address of the slot.
+ *
+ * @return AD5940ERR_OK, AD5940ERR_PARA if `length` is 0, AD5940ERR_BUFF if it doesn't fit.
+ */
+AD5940Err AD5940_UTILITY_sequence_memory_allocate(
+    const char *const name,
+    const uint32_t length,
+    uint32_t *const address
+);
+
+/**
+ * Allocates the largest free region of the sequencer SRAM to a named slot.
+ *
+ * @note
+ * For sequences whose length depends on the parameters, such as the DAC steps
+ * of a scan. The region may shrink when other slots are allocated, call it
+ * again before writing the sequences of every measurement.
+ *
+ * @param name      Name of the slot, compared by `strcmp()`. The string must stay valid.
+ * @param address   Pointer to retrieve the first address of the slot.
+ * @param length    Pointer to retrieve the number of words of the slot.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_BUFF if no memory is free.
+ */
+AD5940Err AD5940_UTILITY_sequence_memory_allocate_remaining(
+    const char *const name,
+    uint32_t *const address,
+    uint32_t *const length
+);
+
+/**
+ * Frees a named slot, nothing is done if it's not allocated.
+ */
+void AD5940_UTILITY_sequence_memory_free(
+    const char *const name
+);
+
+#ifdef __cplusplus
+}
+#endif
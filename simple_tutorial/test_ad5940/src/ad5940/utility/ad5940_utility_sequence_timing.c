@@ -0,0 +1,244 @@
+#include "ad5940_utility_sequence_timing.h"
+
+#include <string.h>
+
+#define SEQ_WR_ADDR(command) (((command) >> 24) & 0x7F)
+#define SEQ_WR_DATA(command) ((command) & 0x00FFFFFF)
+#define AFECON_ADDR ((REG_AFE_AFECON >> 2) & 0x7F)  /* Address field of SEQ_WR(REG_AFE_AFECON, ...) */
+
+typedef struct
+{
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *config;
+    uint32_t FIFO_thresh;
+    float duration;
+    uint32_t first_cycles;
+    uint32_t period_cycles;
+
+    uint32_t FIFO_count;
+    BoolFlag read_pending;
+    float read_time;
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT *result;
+}
+_SIMULATION;
+
+AD5940Err AD5940_UTILITY_get_ADC_output_cycles(
+    const ClksCalInfo_Type *const clks_cal,
+    uint32_t *const first_cycles,
+    uint32_t *const period_cycles
+)
+{
+    ClksCalInfo_Type info = *clks_cal;
+    uint32_t second_cycles;
+
+    info.DataCount = 1;
+    AD5940_ClksCalculate(&info, first_cycles);
+    info.DataCount = 2;
+    AD5940_ClksCalculate(&info, &second_cycles);
+    if(*first_cycles == 0 || second_cycles <= *first_cycles) return AD5940ERR_PARA;
+
+    *period_cycles = second_cycles - *first_cycles;
+    return AD5940ERR_OK;
+}
+
+static void _push(
+    _SIMULATION *const simulation,
+    const float time
+)
+{
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT *const result = simulation->result;
+
+    if(simulation->read_pending && simulation->read_time <= time)
+    {
+        simulation->FIFO_count = 0;
+        simulation->read_pending = bFALSE;
+    }
+
+    if(simulation->FIFO_count == simulation->config->FIFO_size) result->FIFO_overflow++;
+    else simulation->FIFO_count++;
+    if(simulation->FIFO_count > result->FIFO_max) result->FIFO_max = simulation->FIFO_count;
+
+    if(!simulation->read_pending && simulation->FIFO_count >= simulation->FIFO_thresh)
+    {
+        result->interrupts++;
+        simulation->read_pending = bTRUE;
+        simulation->read_time = time + simulation->config->MCU_latency;
+    }
+    return;
+}
+
+/**
+ * @brief Walks the commands of a sequence started at `start_time`, data is pushed into the FIFO if `simulation` isn't NULL.
+ * @return Number of data written into the FIFO.
+ */
+static uint32_t _run(
+    const AD5940_UTILITY_SEQUENCE_TIMING_SEQUENCE *const sequence,
+    const uint32_t first_cycles,
+    const uint32_t period_cycles,
+    const uint32_t statistics_samples,
+    _SIMULATION *const simulation,
+    const float start_time
+)
+{
+    uint32_t samples = 0;
+    uint32_t cycles = 0;
+    BoolFlag converting = bFALSE;
+    uint32_t next_sample = 0;
+    /* The statistics block is restarted by every run of the ADC sequence. */
+    uint32_t statistics_count = 0;
+
+    for(uint32_t i=0; i<=sequence->commands_length; i++)
+    {
+        const BoolFlag is_end = (i == sequence->commands_length) ? bTRUE : bFALSE;
+        const uint32_t command_cycles = is_end ? 0 : AD5940_SEQCmdCycleTime(&sequence->commands[i], 1);
+
+        /* The ADC stops when the sequence ends and AFE goes back to sleep. */
+        while(converting && next_sample <= cycles + command_cycles)
+        {
+            statistics_count++;
+            if(statistics_count >= statistics_samples)
+            {
+                statistics_count = 0;
+                samples++;
+                if(simulation != NULL)
+                {
+                    const float time = start_time + next_sample / simulation->config->SysClk_frequency;
+                    if(time >= simulation->duration) return samples;
+                    _push(simulation, time);
+                }
+            }
+            next_sample += period_cycles;
+        }
+        if(is_end) break;
+
+        const uint32_t command = sequence->commands[i];
+        cycles += command_cycles;
+        if((command & 0x80000000) && SEQ_WR_ADDR(command) == AFECON_ADDR)
+        {
+            const BoolFlag enable = (SEQ_WR_DATA(command) & BITM_AFE_AFECON_ADCCONVEN) ? bTRUE : bFALSE;
+            if(enable && !converting) next_sample = cycles + first_cycles;
+            converting = enable;
+        }
+    }
+    return samples;
+}
+
+static AD5940Err _check_config(
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config
+)
+{
+    if(config->LFOSC_frequency <= 0) return AD5940ERR_PARA;
+    if(config->SysClk_frequency <= 0) return AD5940ERR_PARA;
+    if(config->FIFO_size == 0) return AD5940ERR_PARA;
+    if(config->MCU_latency < 0) return AD5940ERR_PARA;
+    if(config->wupt.WuptEndSeq > WUPTENDSEQ_H) return AD5940ERR_PARA;
+    for(uint32_t i=0; i<=config->wupt.WuptEndSeq; i++)
+    {
+        if(config->wupt.WuptOrder[i] > SEQID_3) return AD5940ERR_PARA;
+        if(config->sequences[config->wupt.WuptOrder[i]].commands == NULL) return AD5940ERR_PARA;
+    }
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_UTILITY_sequence_timing_simulate(
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config,
+    const uint32_t FIFO_thresh,
+    const float duration,
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT *const result
+)
+{
+    AD5940Err error = _check_config(config);
+    if(error != AD5940ERR_OK) return error;
+    if(FIFO_thresh == 0 || FIFO_thresh > config->FIFO_size) return AD5940ERR_PARA;
+    if(duration <= 0) return AD5940ERR_PARA;
+
+    _SIMULATION simulation = {
+        .config = config,
+        .FIFO_thresh = FIFO_thresh,
+        .duration = duration,
+        .FIFO_count = 0,
+        .read_pending = bFALSE,
+        .read_time = 0,
+        .result = result,
+    };
+    error = AD5940_UTILITY_get_ADC_output_cycles(
+        &config->clks_cal,
+        &simulation.first_cycles,
+        &simulation.period_cycles
+    );
+    if(error != AD5940ERR_OK) return error;
+
+    memset(result, 0, sizeof(AD5940_UTILITY_SEQUENCE_TIMING_RESULT));
+    for(uint8_t i=0; i<4; i++)
+    {
+        const AD5940_UTILITY_SEQUENCE_TIMING_SEQUENCE *const sequence = &config->sequences[i];
+        if(sequence->commands == NULL) continue;
+        result->run_cycles[i] = AD5940_SEQCmdCycleTime(sequence->commands, sequence->commands_length);
+        result->samples[i] = _run(sequence, simulation.first_cycles, simulation.period_cycles, config->statistics_samples, NULL, 0);
+    }
+
+    /* One round of the wakeup timer order. */
+    uint32_t round_ticks = 0;
+    uint32_t round_samples = 0;
+    for(uint32_t i=0; i<=config->wupt.WuptEndSeq; i++)
+    {
+        const uint32_t SeqId = config->wupt.WuptOrder[i];
+        const uint32_t wakeup_ticks = config->wupt.SeqxWakeupTime[SeqId] + 1;
+        round_ticks += config->wupt.SeqxSleepTime[SeqId] + 1 + wakeup_ticks;
+        round_samples += result->samples[SeqId];
+        if(result->run_cycles[SeqId] / config->SysClk_frequency > wakeup_ticks / config->LFOSC_frequency) result->overrun = bTRUE;
+    }
+    result->round_time = round_ticks / config->LFOSC_frequency;
+    result->sample_rate = round_samples / result->round_time;
+
+    /* Slots one after another, a sequence can't start before the previous one ends. */
+    uint32_t ticks = 0;
+    float end_time = 0;
+    for(uint32_t slot=0; ticks / config->LFOSC_frequency < duration; slot = (slot + 1) % (config->wupt.WuptEndSeq + 1))
+    {
+        const uint32_t SeqId = config->wupt.WuptOrder[slot];
+        const float trigger_time = (ticks + config->wupt.SeqxSleepTime[SeqId] + 1) / config->LFOSC_frequency;
+        const float start_time = (trigger_time > end_time) ? trigger_time : end_time;
+        if(start_time >= duration) break;
+
+        _run(&config->sequences[SeqId], simulation.first_cycles, simulation.period_cycles, config->statistics_samples, &simulation, start_time);
+        end_time = start_time + result->run_cycles[SeqId] / config->SysClk_frequency;
+        ticks += config->wupt.SeqxSleepTime[SeqId] + 1 + config->wupt.SeqxWakeupTime[SeqId] + 1;
+    }
+    result->interrupt_rate = result->interrupts / duration;
+
+    return AD5940ERR_OK;
+}
+
+AD5940Err AD5940_UTILITY_sequence_timing_recommend_FIFO_thresh(
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config,
+    const float interrupt_rate,
+    const float duration,
+    uint32_t *const FIFO_thresh
+)
+{
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT result;
+    if(interrupt_rate <= 0) return AD5940ERR_PARA;
+
+    AD5940Err error = AD5940_UTILITY_sequence_timing_simulate(config, 1, duration, &result);
+    if(error != AD5940ERR_OK) return error;
+    if(result.FIFO_overflow > 0) return AD5940ERR_BUFF;
+
+    /* The interrupt rate is the data rate divided by the threshold. */
+    uint32_t high = (uint32_t) (result.sample_rate / interrupt_rate);
+    if(high > config->FIFO_size) high = config->FIFO_size;
+    if(high < 1) high = 1;
+
+    /* Overflow only gets worse with a higher threshold, find the largest one without it. */
+    uint32_t low = 1;
+    while(low < high)
+    {
+        const uint32_t middle = low + (high - low + 1) / 2;
+        error = AD5940_UTILITY_sequence_timing_simulate(config, middle, duration, &result);
+        if(error != AD5940ERR_OK) return error;
+        if(result.FIFO_overflow > 0) high = middle - 1;
+        else low = middle;
+    }
+
+    *FIFO_thresh = low;
+    return AD5940ERR_OK;
+}
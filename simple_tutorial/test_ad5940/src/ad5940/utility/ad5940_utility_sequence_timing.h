@@ -0,0 +1,123 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ad5940.h"
+
+/**
+ * Sequence run by the wakeup timer, indexed by @ref SEQID_Const.
+ */
+typedef struct
+{
+    const uint32_t *commands;   /**< NULL if the sequence isn't in the wakeup timer order. */
+    uint32_t commands_length;
+}
+AD5940_UTILITY_SEQUENCE_TIMING_SEQUENCE;
+
+/**
+ * Everything that decides when the sequencer runs and when data enters the FIFO.
+ */
+typedef struct
+{
+    AD5940_UTILITY_SEQUENCE_TIMING_SEQUENCE sequences[4];
+    WUPTCfg_Type wupt;          /**< Wakeup timer configuration written by @ref AD5940_WUPTCfg. */
+    ClksCalInfo_Type clks_cal;  /**< ADC filter settings and FIFO data type, `DataCount` is ignored. */
+    uint32_t statistics_samples;    /**< ADC data averaged into one FIFO word by the statistics block
+                                         (`FIFOSRC_MEAN` or `FIFOSRC_VAR`), 0 or 1 without it. */
+    float LFOSC_frequency;      /**< Hz, clock of the wakeup timer. */
+    float SysClk_frequency;     /**< Hz, clock of the sequencer. */
+    uint32_t FIFO_size;         /**< Words of the data FIFO, @ref FIFOSIZE_Const. */
+    float MCU_latency;          /**< Seconds from the FIFO threshold interrupt to the FIFO read by MCU. */
+}
+AD5940_UTILITY_SEQUENCE_TIMING_CONFIG;
+
+/**
+ * Result of @ref AD5940_UTILITY_sequence_timing_simulate.
+ */
+typedef struct
+{
+    uint32_t run_cycles[4];     /**< System clock cycles of one run of every sequence. */
+    uint32_t samples[4];        /**< FIFO words written by one run of every sequence. */
+    BoolFlag overrun;           /**< A sequence runs longer than its wakeup timer slot. */
+    float round_time;           /**< Seconds of one round of the wakeup timer order. */
+    float sample_rate;          /**< Average FIFO words per second. */
+    uint32_t FIFO_max;          /**< Highest FIFO count. */
+    uint32_t FIFO_overflow;     /**< Words lost because the FIFO was full. */
+    uint32_t interrupts;        /**< FIFO threshold interrupts. */
+    float interrupt_rate;       /**< Average FIFO threshold interrupts per second. */
+}
+AD5940_UTILITY_SEQUENCE_TIMING_RESULT;
+
+/**
+ * Computes the output rate of the ADC data type in `clks_cal`.
+ *
+ * @note
+ * Based on @ref AD5940_ClksCalculate, the first data takes `first_cycles`
+ * because the filters have to settle, then one data every `period_cycles`.
+ *
+ * @param clks_cal          ADC filter settings and data type, `DataCount` is ignored.
+ * @param first_cycles      Pointer to retrieve the system clock cycles of the first data after ADC conversion starts.
+ * @param period_cycles     Pointer to retrieve the system clock cycles between two data.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the settings are invalid.
+ */
+AD5940Err AD5940_UTILITY_get_ADC_output_cycles(
+    const ClksCalInfo_Type *const clks_cal,
+    uint32_t *const first_cycles,
+    uint32_t *const period_cycles
+);
+
+/**
+ * Simulates the wakeup timer, the sequencer and the data FIFO.
+ *
+ * @note
+ * The model:
+ * - Every slot of the wakeup timer order sleeps `SeqxSleepTime + 1` LFOSC
+ *   clocks, then triggers its sequence and stays awake `SeqxWakeupTime + 1` clocks.
+ * - A sequence takes @ref AD5940_SEQCmdCycleTime system clocks. The ADC produces
+ *   data while `AFECON.ADCCONVEN` is set by the sequence, at the rate of
+ *   @ref AD5940_UTILITY_get_ADC_output_cycles.
+ * - When the FIFO count reaches `FIFO_thresh`, MCU reads the whole FIFO
+ *   `MCU_latency` seconds later.
+ *
+ * Sequences that rewrite `SEQxINFO` are simulated with the commands given in `config`.
+ *
+ * @param config        The sequences, wakeup timer and FIFO configuration.
+ * @param FIFO_thresh   FIFO threshold written by @ref AD5940_FIFOThrshSet.
+ * @param duration      Seconds to simulate.
+ * @param result        Pointer to retrieve the result.
+ *
+ * @return AD5940ERR_OK or AD5940ERR_PARA if the configuration is invalid.
+ */
+AD5940Err AD5940_UTILITY_sequence_timing_simulate(
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config,
+    const uint32_t FIFO_thresh,
+    const float duration,
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT *const result
+);
+
+/**
+ * Finds the largest FIFO threshold that raises at least `interrupt_rate`
+ * interrupts per second without FIFO overflow.
+ *
+ * @param config            The sequences, wakeup timer and FIFO configuration.
+ * @param interrupt_rate    Minimum FIFO threshold interrupts per second, the data latency MCU accepts.
+ * @param duration          Seconds to simulate for every threshold.
+ * @param FIFO_thresh       Pointer to retrieve the threshold.
+ *
+ * @return AD5940ERR_OK, AD5940ERR_PARA if the configuration is invalid or
+ *         AD5940ERR_BUFF if every threshold overflows.
+ */
+AD5940Err AD5940_UTILITY_sequence_timing_recommend_FIFO_thresh(
+    const AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config,
+    const float interrupt_rate,
+    const float duration,
+    uint32_t *const FIFO_thresh
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/**
+ * Checks the fixed-point ADC conversion of `AD5940_UTILITY_convert_ADCs_fixed()`
+ * against the float conversion the library used before.
+ *
+ * Every 16-bit code, with the upper bits of a FIFO word set, is converted with
+ * the scale of `AD5940_UTILITY_get_current_fixed_scale()` for every PGA gain
+ * and a range of RTIA magnitudes, and with the scale of
+ * `AD5940_UTILITY_get_temperature_fixed_scale()` for every PGA gain. The float
+ * path is `AD5940_ADCCode2Volt()` over the RTIA for the currents. Codes whose
+ * float value doesn't fit into 32 bits are skipped, neither path defines them.
+ * The largest difference of every scale is printed, in values and in LSB.
+ *
+ * Returns non-zero if any value differs by more than 1 LSB, the value of one
+ * ADC code or 1 nA / 1 microdegree if that's larger, the resolution of the
+ * integer values.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_utility_adc.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define CODE_COUNT 0x10000
+/* A sequence ID and the ECC of a FIFO word, the conversion only takes the low 16 bits */
+#define FIFO_WORD_UPPER_BITS 0x01A30000
+
+static const struct {
+    uint32_t ADCPga;
+    float gain;
+} _pgas[] = {
+    {ADCPGA_1, 1.0f},
+    {ADCPGA_1P5, 1.5f},
+    {ADCPGA_2, 2.0f},
+    {ADCPGA_4, 4.0f},
+    {ADCPGA_9, 9.0f},
+};
+#define PGA_COUNT (sizeof(_pgas) / sizeof(_pgas[0]))
+
+/* HSTIA 200 ohm to LPTIA 160 kohm, one calibrated value in between */
+static const float _rtias[] = {200.0f, 1000.0f, 5000.0f, 10013.7f, 160000.0f};
+#define RTIA_COUNT (sizeof(_rtias) / sizeof(_rtias[0]))
+
+#define REFERENCE_VOLT 1.82f
+
+static uint32_t _adc_data[CODE_COUNT];
+static int32_t _values[CODE_COUNT];
+
+/* AD5940_UTILITY_convert_ADCs_to_currents() before the fixed-point scale */
+static int _float_current(const uint32_t adc_data, const uint32_t ADCPga, const float rtia, double *const value)
+{
+    const float current = AD5940_ADCCode2Volt(adc_data & 0xFFFF, ADCPga, REFERENCE_VOLT) / rtia * 1e9f;
+    if(!(fabsf(current) < 2147483647.0f)) return 0;
+    *value = (int32_t) current;
+    return 1;
+}
+
+/* AD5940_UTILITY_convert_ADCs_to_temperatures() before the fixed-point scale */
+static int _float_temperature(const uint32_t adc_data, const float gain, double *const value)
+{
+    const int32_t code = (int32_t) (adc_data & 0xFFFF) - 0x8000;
+    const float temperature = (code / 8.13f / gain - 273.15f) * 1e6f;
+    if(!(fabsf(temperature) < 2147483647.0f)) return 0;
+    *value = (int32_t) temperature;
+    return 1;
+}
+
+static int _check(
+    const char *const name,
+    const AD5940_UTILITY_ADC_FIXED_SCALE *const scale,
+    const double lsb,
+    const uint32_t ADCPga,
+    const float gain,
+    const float rtia
+)
+{
+    /* The length is 16 bits, so in two halves */
+    AD5940_UTILITY_convert_ADCs_fixed(_values, _adc_data, CODE_COUNT / 2, scale);
+    AD5940_UTILITY_convert_ADCs_fixed(_values + CODE_COUNT / 2, _adc_data + CODE_COUNT / 2, CODE_COUNT / 2, scale);
+
+    double max_difference = 0;
+    uint32_t checked = 0;
+    for(uint32_t i=0; i<CODE_COUNT; i++)
+    {
+        double expected;
+        const int in_range = (rtia > 0)
+            ? _float_current(_adc_data[i], ADCPga, rtia, &expected)
+            : _float_temperature(_adc_data[i], gain, &expected);
+        if(!in_range) continue;
+        checked++;
+        const double difference = fabs(_values[i] - expected);
+        if(difference > max_difference) max_difference = difference;
+    }
+
+    const int ok = (checked > 0) && (max_difference <= fmax(lsb, 1));
+    printf("%-12s PGA %-4g RTIA %-8g: %5u codes, max difference %-8.4g = %.4f LSB %s\n",
+        name, gain, rtia, checked, max_difference, max_difference / lsb, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    for(uint32_t i=0; i<CODE_COUNT; i++) _adc_data[i] = FIFO_WORD_UPPER_BITS | i;
+
+    for(size_t p=0; p<PGA_COUNT; p++)
+    {
+        for(size_t r=0; r<RTIA_COUNT; r++)
+        {
+            const fImpPol_Type rtia = {.Magnitude = _rtias[r], .Phase = 0};
+            AD5940_UTILITY_ADC_FIXED_SCALE scale;
+            if(AD5940_UTILITY_get_current_fixed_scale(&scale, &rtia, _pgas[p].ADCPga, REFERENCE_VOLT) != AD5940ERR_OK)
+            {
+                printf("current      PGA %-4g RTIA %-8g: no scale FAILED\n", _pgas[p].gain, _rtias[r]);
+                failed++;
+                continue;
+            }
+            /* Nanoamperes per code */
+            const double lsb = REFERENCE_VOLT * (1.835 / 1.82) / 32768 / _pgas[p].gain / _rtias[r] * 1e9;
+            failed += _check("current", &scale, lsb, _pgas[p].ADCPga, _pgas[p].gain, _rtias[r]);
+        }
+
+        AD5940_UTILITY_ADC_FIXED_SCALE scale;
+        if(AD5940_UTILITY_get_temperature_fixed_scale(&scale, _pgas[p].ADCPga) != AD5940ERR_OK)
+        {
+            printf("temperature  PGA %-4g: no scale FAILED\n", _pgas[p].gain);
+            failed++;
+            continue;
+        }
+        /* Microdegrees Celsius per code */
+        const double lsb = 1e6 / 8.13 / _pgas[p].gain;
+        failed += _check("temperature", &scale, lsb, _pgas[p].ADCPga, _pgas[p].gain, 0);
+    }
+
+    return failed;
+}
@@ -0,0 +1,144 @@
+/**
+ * Checks the ping-pong DAC steps of `AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_start()`
+ * on the sequencer of the emulator.
+ *
+ * The steps are written to the emulator SRAM by the library. The harness plays
+ * the wakeup timer: it triggers SEQ1 and SEQ2 alternately, one DAC step per
+ * run, and reads LPDACDAT0 back after every step. A raised CUSTOMINT0 is given
+ * to `AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt()` at once, or just
+ * before the other block completes, the latest the MCU may refill.
+ *
+ * Finite scans of 1 to 1000 steps, at several start addresses and so block
+ * sizes, must set every DAC code in order and stop the sequencer exactly once,
+ * right after the last step. A scan repeated until stopped must keep running.
+ *
+ * Returns non-zero if any scan differs.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_electrochemical_utility_dac_stream.h"
+
+#include <stdio.h>
+
+#define REPEATED_STEPS 5000
+#define SEQUENCE_MEMORY_END 512
+
+/* The DAC codes are the step indexes, within the 18 bits of LPDACDAT0 */
+static uint32_t _step;
+static uint32_t _step_number;   /* 0 for a scan repeated until stopped */
+
+static AD5940Err _next(uint32_t *const lpdac_dat_bit, BoolFlag *const is_last)
+{
+    *lpdac_dat_bit = _step++ & 0x3FFFF;
+    *is_last = (_step_number != 0 && _step >= _step_number) ? bTRUE : bFALSE;
+    return AD5940ERR_OK;
+}
+
+/* The electrochemical region of the sop utility, the stream fills it up to the end */
+void AD5940_ELECTROCHEMICAL_UTILITY_get_sequence_memory(
+    uint32_t *const start_address,
+    uint32_t *const end_address
+)
+{
+    *start_address = 0;
+    *end_address = SEQUENCE_MEMORY_END;
+}
+
+/* Steps of one block, as the stream splits the region after start_address */
+static uint32_t _get_steps_per_block(const uint32_t start_address)
+{
+    return ((SEQUENCE_MEMORY_END - start_address) / 2 - 2) / 3;
+}
+
+static int _check(
+    const uint32_t start_address,
+    const uint32_t step_number,
+    const BoolFlag late_refill
+)
+{
+    AD5940_HWReset();
+    AD5940_Initialize();
+    AD5940_INTCCfg(AFEINTC_0, AFEINTSRC_CUSTOMINT0 | AFEINTSRC_ENDSEQ, bTRUE);
+    AD5940_INTCClrFlag(AFEINTSRC_ALLINT);
+    AD5940_SEQCtrlS(bTRUE);
+
+    _step = 0;
+    _step_number = step_number;
+    if(AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_start(start_address, REG_AFE_SEQ1INFO, REG_AFE_SEQ2INFO, _next) != AD5940ERR_OK)
+    {
+        printf("start %3u, %4u steps: not started FAILED\n", start_address, step_number);
+        return 1;
+    }
+
+    const uint32_t refill_delay = late_refill ? _get_steps_per_block(start_address) - 1 : 0;
+    const uint32_t max_runs = (step_number != 0) ? step_number + 2 : REPEATED_STEPS;
+    uint32_t expected = 0, stops = 0, stop_run = 0;
+    BoolFlag pending = bFALSE;
+    uint32_t steps_since_interrupt = 0;
+    int ok = 1;
+    for(uint32_t run=0; run<max_runs; run++)
+    {
+        const BoolFlag was_running = (AD5940_ReadReg(REG_AFE_SEQCON) & BITM_AFE_SEQCON_SEQEN) ? bTRUE : bFALSE;
+        AD5940_WriteReg(REG_AFECON_TRIGSEQ, (run & 0x01) ? (1L << SEQID_2) : (1L << SEQID_1));
+        if(!was_running) continue;
+
+        const uint32_t flags = AD5940_INTCGetFlag(AFEINTC_0);
+        if(flags & AFEINTSRC_ENDSEQ)
+        {
+            stops++;
+            stop_run = run;
+            AD5940_INTCClrFlag(AFEINTSRC_ENDSEQ);
+            continue;
+        }
+
+        const uint32_t code = AD5940_ReadReg(REG_AFE_LPDACDAT0);
+        if(ok && code != (expected & 0x3FFFF))
+        {
+            printf("start %3u, %4u steps: run %u set %u instead of %u ", start_address, step_number, run, code, expected);
+            ok = 0;
+        }
+        expected++;
+
+        /* The flag stays raised until the refill clears it */
+        if(pending) steps_since_interrupt++;
+        else if(flags & AFEINTSRC_CUSTOMINT0)
+        {
+            pending = bTRUE;
+            steps_since_interrupt = 0;
+        }
+        /* After the last step of the other block at the latest, its SEQINFO write points at the refilled one */
+        if(pending && steps_since_interrupt >= refill_delay)
+        {
+            uint32_t AFEIntSrc;
+            AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_interrupt(&AFEIntSrc);
+            pending = bFALSE;
+        }
+    }
+    AD5940_ELECTROCHEMICAL_UTILITY_DAC_stream_stop();
+
+    if(step_number != 0) ok = ok && (expected == step_number) && (stops == 1) && (stop_run == step_number);
+    else ok = ok && (expected == REPEATED_STEPS) && (stops == 0);
+    printf("start %3u, %4u steps, %2u per block, %s refill: %4u steps, %u stops %s\n",
+        start_address, step_number, _get_steps_per_block(start_address), late_refill ? "late" : "soon",
+        expected, stops, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    static const uint32_t start_addresses[] = {0, 37, 300, 480};
+    /* Around the 84, 78, 34 and 4 steps per block of the start addresses, 0 repeats until stopped */
+    static const uint32_t step_numbers[] = {1, 2, 3, 4, 5, 8, 9, 33, 34, 35, 68, 69, 77, 78, 79, 83, 84, 85, 168, 169, 1000, 0};
+    int failed = 0;
+
+    for(size_t a=0; a<sizeof(start_addresses)/sizeof(start_addresses[0]); a++)
+    {
+        for(size_t s=0; s<sizeof(step_numbers)/sizeof(step_numbers[0]); s++)
+        {
+            failed += _check(start_addresses[a], step_numbers[s], bFALSE);
+            failed += _check(start_addresses[a], step_numbers[s], bTRUE);
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,135 @@
+/**
+ * Checks the burst FIFO read of `AD5940_FIFORd()` against the emulator.
+ *
+ * The emulator FIFO is filled with the same words twice, after a reset that
+ * also restarts its noise. They are read once with the word-by-word path the
+ * library used before (one `AD5940_ReadWriteNBytes()` call per byte or word)
+ * and once with `AD5940_FIFORd()`. The words read and the bytes on the bus,
+ * CS windows included, must be identical. The number of port calls of both
+ * paths is printed.
+ *
+ * Returns non-zero if any count differs.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_spi_counter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define WORD_MAX 1000   /* Fits the 1024 words of the emulator FIFO */
+#define STREAM_MAX (16 + WORD_MAX * 12)
+
+static uint32_t _words[2][WORD_MAX];
+static uint16_t _streams[2][STREAM_MAX];
+static size_t _stream_lengths[2];
+
+/* AD5940_FIFORd() of the library before the burst read */
+static uint32_t _read_write_32(const uint32_t data)
+{
+    uint8_t tx[4], rx[4];
+    tx[0] = (data >> 24) & 0xff;
+    tx[1] = (data >> 16) & 0xff;
+    tx[2] = (data >> 8) & 0xff;
+    tx[3] = data & 0xff;
+    AD5940_ReadWriteNBytes(tx, rx, 4);
+    return ((uint32_t) rx[0] << 24) | ((uint32_t) rx[1] << 16) | ((uint32_t) rx[2] << 8) | rx[3];
+}
+
+static uint32_t _read_write_8(const uint8_t data)
+{
+    uint8_t tx = data, rx;
+    AD5940_ReadWriteNBytes(&tx, &rx, 1);
+    return rx;
+}
+
+static void _read_write_16(const uint16_t data)
+{
+    uint8_t tx[2] = {data >> 8, data & 0xff}, rx[2];
+    AD5940_ReadWriteNBytes(tx, rx, 2);
+}
+
+static void _fifo_read_word_by_word(uint32_t *const buffer, const uint32_t count)
+{
+    uint32_t i;
+    if(count < 3)
+    {
+        AD5940_CsClr();
+        _read_write_8(SPICMD_SETADDR);
+        _read_write_16(REG_AFE_DATAFIFORD);
+        AD5940_CsSet();
+        for(i=0; i<count; i++)
+        {
+            AD5940_CsClr();
+            _read_write_8(SPICMD_READREG);
+            _read_write_8(0);
+            buffer[i] = _read_write_32(0);
+            AD5940_CsSet();
+        }
+        return;
+    }
+    AD5940_CsClr();
+    _read_write_8(SPICMD_READFIFO);
+    for(i=0; i<6; i++) _read_write_8(0);
+    for(i=0; i<count-2; i++) buffer[i] = _read_write_32(0);
+    buffer[i++] = _read_write_32(0x44444444);
+    buffer[i] = _read_write_32(0x44444444);
+    AD5940_CsSet();
+}
+
+/* Fills the FIFO with `count` conversions of changing LPDAC codes. */
+static void _fill_fifo(const uint32_t count)
+{
+    AD5940_HWReset();
+    AD5940_Initialize();
+    AD5940_WriteReg(REG_AFE_FIFOCON, BITM_AFE_FIFOCON_DATAFIFOEN);
+    for(uint32_t i=0; i<count; i++)
+    {
+        AD5940_WriteReg(REG_AFE_LPDACDAT0, (i * 37) & 0xfff);
+        AD5940_WriteReg(REG_AFE_AFECON, BITM_AFE_AFECON_ADCCONVEN);
+    }
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {1, 2, 3, 4, 5, 63, 64, 65, 66, 128, 129, 500, WORD_MAX};
+    AD5940_SPI_COUNTER counters[2];
+    int failed = 0;
+
+    printf("%6s %10s %10s %10s %10s  %s\n", "words", "calls", "calls", "frames", "frames", "");
+    printf("%6s %10s %10s %10s %10s  %s\n", "", "per-word", "burst", "per-word", "burst", "result");
+    for(size_t n=0; n<sizeof(counts)/sizeof(counts[0]); n++)
+    {
+        const uint32_t count = counts[n];
+        for(int path=0; path<2; path++)
+        {
+            _fill_fifo(count);
+            memset(_words[path], 0, sizeof(_words[path]));
+            AD5940_SPI_COUNTER_reset();
+            AD5940_SPI_COUNTER_record(_streams[path], STREAM_MAX, &_stream_lengths[path]);
+            if(path == 0) _fifo_read_word_by_word(_words[path], count);
+            else AD5940_FIFORd(_words[path], count);
+            AD5940_SPI_COUNTER_record(NULL, 0, NULL);
+            AD5940_SPI_COUNTER_get(&counters[path]);
+        }
+
+        const int same_words = memcmp(_words[0], _words[1], count * sizeof(uint32_t)) == 0;
+        const int same_stream = _stream_lengths[0] == _stream_lengths[1]
+            && memcmp(_streams[0], _streams[1], _stream_lengths[0] * sizeof(uint16_t)) == 0;
+        /* The data changes with the LPDAC code, identical zeros would hide a broken read. */
+        const int has_data = _words[1][count - 1] != 0;
+        const int ok = same_words && same_stream && has_data;
+        failed |= !ok;
+
+        printf("%6u %10u %10u %10u %10u  %s%s%s%s\n",
+            count,
+            counters[0].transfers, counters[1].transfers,
+            counters[0].frames, counters[1].frames,
+            ok ? "ok" : "FAILED",
+            same_words ? "" : " (words differ)",
+            same_stream ? "" : " (bus bytes differ)",
+            has_data ? "" : " (no data)");
+    }
+    return failed;
+}
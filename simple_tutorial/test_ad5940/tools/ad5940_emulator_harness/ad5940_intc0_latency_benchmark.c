@@ -0,0 +1,159 @@
+/**
+ * Measures the latency from the AD5940 interrupt edge on GPIO7 to the data
+ * read, with the GPIO ISR and with the debounce of the INTC0 port.
+ *
+ * `ad5940_port_intc0_impl_zephyr.c` is built twice, without and with
+ * CONFIG_AD5940_INTC0_DEBOUNCE, and runs on the host GPIO of zephyr_host.c
+ * with `utils/gpio` and the INTC0 lock of the application:
+ * - The emulator runs a one-command sequence from the wakeup timer every
+ *   50 ms, each conversion crosses the FIFO threshold of 1.
+ * - Its INTC0 flag pulls GPIO7 low, the ADC thread pends on the lock,
+ *   drains the FIFO and clears the flag, which releases the line.
+ * - The latency is taken by the lock statistics, from the edge stamped in
+ *   the GPIO ISR to `ad5940_intc0_lock_served()`.
+ *
+ * Each mode runs in a child process, so the GPIO callbacks of one don't stay
+ * on the pin of the other.
+ *
+ * Returns non-zero if an interrupt or a sample is lost.
+ */
+
+#include "ad5940.h"
+#include "ad5940_intc0_lock.h"
+#include "ad5940_intc0_lock_impl_zephyr.h"
+
+#include "zephyr_host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define INTERRUPT_NUMBER 40
+#define PERIOD_CLOCKS 1600  /* 50 ms of the 32 kHz LFOSC, longer than the debounce */
+
+/* The INTC0 port built in both modes, and the emulator hook it replaces */
+int AD5940_intc0_impl_zephyr_init_edge(void (*callback)(void), void (*edge_callback)(void));
+int AD5940_intc0_impl_zephyr_init_debounce(void (*callback)(void), void (*edge_callback)(void));
+int AD5940_emulator_intc0_impl_zephyr_init(void (*callback)(void), void (*edge_callback)(void));
+
+typedef enum
+{
+    _MODE_EDGE,
+    _MODE_DEBOUNCE,
+}
+_MODE;
+
+static const uint32_t _sequence[] = {
+    SEQ_WR(REG_AFE_AFECON, BITM_AFE_AFECON_ADCCONVEN),
+};
+
+// The AD5940 pulls GPIO7 low while an enabled INTC0 flag is set.
+static void _intc0_raised(void)
+{
+    zephyr_host_gpio_drive(ZEPHYR_HOST_PIN_ad5940_gpio7_gpios, 0);
+}
+
+/*
+ * The AD5940 releases GPIO7 when the flag is cleared. In Zephyr the ADC thread woken by the
+ * debounce runs after the cooperative workqueue handler re-enabled the edges, the host threads
+ * are preemptive, so the line is released from the workqueue to keep that order.
+ */
+static void _intc0_cleared_handler(struct k_work *work)
+{
+    zephyr_host_gpio_drive(ZEPHYR_HOST_PIN_ad5940_gpio7_gpios, 1);
+}
+
+static K_WORK_DELAYABLE_DEFINE(_intc0_cleared_work, _intc0_cleared_handler);
+
+static void _start(void)
+{
+    SEQInfo_Type seq_info = {
+        .SeqId = SEQID_0,
+        .SeqRamAddr = 0,
+        .SeqLen = sizeof(_sequence) / sizeof(_sequence[0]),
+        .WriteSRAM = bTRUE,
+        .pSeqCmd = _sequence,
+    };
+    WUPTCfg_Type wupt_cfg = {
+        .WuptEndSeq = WUPTENDSEQ_A,
+        .WuptOrder = {SEQID_0},
+        .SeqxSleepTime = {PERIOD_CLOCKS - 2 - 1},
+        .SeqxWakeupTime = {1},
+        .WuptEn = bTRUE,
+    };
+
+    AD5940_WriteReg(REG_AFE_FIFOCON, BITM_AFE_FIFOCON_DATAFIFOEN);
+    AD5940_FIFOThrshSet(1);
+    AD5940_INTCCfg(AFEINTC_0, AFEINTSRC_DATAFIFOTHRESH, bTRUE);
+    AD5940_INTCClrFlag(AFEINTSRC_ALLINT);
+    AD5940_SEQInfoCfg(&seq_info);
+    AD5940_SEQCtrlS(bTRUE);
+    AD5940_WUPTCfg(&wupt_cfg);
+}
+
+static int _run(const _MODE mode)
+{
+    static uint32_t words[16];
+    AD5940_INTC0_LOCK_STATISTICS statistics;
+    uint32_t word_count = 0;
+
+    ad5940_intc0_lock_init_impl_zephyr();
+    if(mode == _MODE_EDGE) AD5940_intc0_impl_zephyr_init_edge(ad5940_intc0_lock_boardcast_impl_zephyr, ad5940_intc0_lock_edge_impl_zephyr);
+    else AD5940_intc0_impl_zephyr_init_debounce(ad5940_intc0_lock_boardcast_impl_zephyr, ad5940_intc0_lock_edge_impl_zephyr);
+    AD5940_emulator_intc0_impl_zephyr_init(_intc0_raised, NULL);
+
+    AD5940_HWReset();
+    AD5940_Initialize();
+    if(mode == _MODE_DEBOUNCE)
+    {
+        // GPIO7 rises when the AD5940 configures it as interrupt output, the debounce enables both edges after this one.
+        zephyr_host_gpio_drive(ZEPHYR_HOST_PIN_ad5940_gpio7_gpios, 0);
+        zephyr_host_gpio_drive(ZEPHYR_HOST_PIN_ad5940_gpio7_gpios, 1);
+        k_sleep(K_MSEC(2 * CONFIG_AD5940_INTC0_DEBOUNCE_MS));
+    }
+
+    _start();
+    for(int i=0; i<INTERRUPT_NUMBER; i++)
+    {
+        ad5940_intc0_lock_wait();
+        uint32_t count = AD5940_FIFOGetCnt();
+        if(count > sizeof(words) / sizeof(words[0])) count = sizeof(words) / sizeof(words[0]);
+        AD5940_FIFORd(words, count);
+        word_count += count;
+        AD5940_INTCClrFlag(AFEINTSRC_ALLINT);
+        k_work_schedule(&_intc0_cleared_work, K_NO_WAIT);
+        ad5940_intc0_lock_served();
+    }
+    AD5940_WUPTCtrl(bFALSE);
+
+    ad5940_intc0_lock_get_statistics(&statistics);
+    const bool ok = statistics.latency_count == INTERRUPT_NUMBER && word_count == INTERRUPT_NUMBER;
+    printf("%-9s %8u %8u %10u %10u %10u  %s\n",
+        mode == _MODE_EDGE ? "isr" : "debounce",
+        statistics.raised, word_count,
+        statistics.latency_min_us,
+        statistics.latency_count > 0 ? (uint32_t) (statistics.latency_total_us / statistics.latency_count) : 0,
+        statistics.latency_max_us,
+        ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    printf("%u interrupts every %u ms, debounce of %u ms\n",
+        INTERRUPT_NUMBER, PERIOD_CLOCKS * 1000 / 32000, CONFIG_AD5940_INTC0_DEBOUNCE_MS);
+    printf("%-9s %8s %8s %10s %10s %10s  %s\n", "mode", "edges", "words", "min us", "avg us", "max us", "result");
+    fflush(stdout);
+    for(int mode=_MODE_EDGE; mode<=_MODE_DEBOUNCE; mode++)
+    {
+        int status;
+        const pid_t pid = fork();
+        if(pid == 0) exit(_run(mode));
+        waitpid(pid, &status, 0);
+        failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    return failed;
+}
@@ -0,0 +1,99 @@
+/**
+ * Checks the sequencer command upload of `AD5940_SEQCmdWrite()` against the
+ * SRAM of the emulator.
+ *
+ * Blocks of 100, 500 and 2000 commands are written once with the loop the
+ * library used before (`AD5940_WriteReg()` of CMDFIFOWADDR and CMDFIFOWRITE
+ * for every command) and once with `AD5940_SEQCmdWrite()`, which streams them
+ * to CMDFIFOWRITE with SEQ_CMDWRITE_BURST. Both must leave the commands at
+ * their addresses and the SRAM around them untouched. The port calls, CS
+ * frames and bytes of both are printed.
+ *
+ * SEQ_CMDWRITE_BURST is defined by build.sh. The emulator increments the SRAM
+ * address after every write to CMDFIFOWRITE, which is an assumption about the
+ * chip, so this only checks the library against that assumption. It doesn't
+ * tell whether the burst upload works on a real AD5940.
+ *
+ * Returns non-zero if any SRAM content differs.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_spi_counter.h"
+
+/* Built in, so the SRAM of the emulator can be inspected */
+#include "ad5940_port_emulator_impl_zephyr.c"
+
+#include <stdio.h>
+#include <string.h>
+
+#define START_ADDRESS 16
+
+static uint32_t _commands[EMULATOR_SRAM_SIZE];
+static uint32_t _sram[2][EMULATOR_SRAM_SIZE];
+
+static void _cmd_write_word_by_word(uint32_t address, const uint32_t *command, uint32_t count)
+{
+    while(count--)
+    {
+        AD5940_WriteReg(REG_AFE_CMDFIFOWADDR, address++);
+        AD5940_WriteReg(REG_AFE_CMDFIFOWRITE, *command++);
+    }
+}
+
+static bool _sram_ok(const uint32_t *const sram, const uint32_t count)
+{
+    for(uint32_t i=0; i<EMULATOR_SRAM_SIZE; i++)
+    {
+        const bool in_block = i >= START_ADDRESS && i < START_ADDRESS + count;
+        if(sram[i] != (in_block ? _commands[i - START_ADDRESS] : 0)) return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {1, 2, 100, 500, 2000};
+    AD5940_SPI_COUNTER counters[2];
+    int failed = 0;
+
+    /* Sequencer commands of changing bits, none of them zero like the erased SRAM */
+    uint32_t seed = 0x12345678;
+    for(uint32_t i=0; i<EMULATOR_SRAM_SIZE; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        _commands[i] = (seed >> 2) | 1;
+    }
+
+    printf("%6s %10s %10s %10s %10s %10s %10s  %s\n", "words", "calls", "calls", "frames", "frames", "bytes", "bytes", "");
+    printf("%6s %10s %10s %10s %10s %10s %10s  %s\n", "", "per-word", "burst", "per-word", "burst", "per-word", "burst", "result");
+    for(size_t n=0; n<sizeof(counts)/sizeof(counts[0]); n++)
+    {
+        const uint32_t count = counts[n];
+        for(int path=0; path<2; path++)
+        {
+            /* The reset erases the SRAM and forgets the blocks resident in it */
+            AD5940_HWReset();
+            AD5940_Initialize();
+            AD5940_SPI_COUNTER_reset();
+            if(path == 0) _cmd_write_word_by_word(START_ADDRESS, _commands, count);
+            else AD5940_SEQCmdWrite(START_ADDRESS, _commands, count);
+            AD5940_SPI_COUNTER_get(&counters[path]);
+            memcpy(_sram[path], _emulator.sram, sizeof(_sram[path]));
+        }
+
+        const bool per_word_ok = _sram_ok(_sram[0], count);
+        const bool burst_ok = _sram_ok(_sram[1], count);
+        failed |= !(per_word_ok && burst_ok);
+
+        printf("%6u %10u %10u %10u %10u %10u %10u  %s%s%s\n",
+            count,
+            counters[0].transfers, counters[1].transfers,
+            counters[0].frames, counters[1].frames,
+            counters[0].bytes, counters[1].bytes,
+            per_word_ok && burst_ok ? "ok" : "FAILED",
+            per_word_ok ? "" : " (per-word SRAM differs)",
+            burst_ok ? "" : " (burst SRAM differs)");
+    }
+    return failed;
+}
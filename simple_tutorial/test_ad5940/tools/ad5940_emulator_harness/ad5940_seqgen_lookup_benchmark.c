@@ -0,0 +1,145 @@
+/**
+ * Checks and times the register record lookup of the sequencer generator.
+ *
+ * A sequence of 2000 read-modify-writes over 64 registers is generated, the
+ * register defaults come from the emulator. Afterwards:
+ * - `AD5940_SEQGenSearchReg()` must find the same record for every 8-bit
+ *   address as the linear scan over the records the library used before
+ *   (bounded by RegCount here, the old loop was bounded by SeqLen).
+ * - Both lookups are timed over the same database.
+ * - After `AD5940_Initialize()` no address may still have a record, and a
+ *   read in a new sequence must get the register value from the AD5940.
+ *
+ * Returns non-zero if any check fails.
+ */
+
+/* Built in, so the static lookup and the database can be reached */
+#include "ad5940.c"
+
+#include "zephyr_host.h"
+
+#include <stdio.h>
+
+#define COMMAND_NUMBER 2000
+#define REGISTER_NUMBER 64
+#define LOOKUP_ROUNDS 200
+#define RUNS 20
+
+static uint32_t _buffer[COMMAND_NUMBER + REGISTER_NUMBER + 16];
+
+static volatile uint32_t _sink;
+
+/* AD5940_SEQGenSearchReg() of the library before the slot table */
+static AD5940Err _search_reg_linear(uint32_t RegAddr, uint32_t *pIndex)
+{
+    RegAddr = (RegAddr >> 2) & 0xff;
+    for(uint32_t i=0; i<SeqGenDB.RegCount; i++)
+    {
+        if(RegAddr == SeqGenDB.pRegInfo[i].RegAddr)
+        {
+            *pIndex = i;
+            return AD5940ERR_OK;
+        }
+    }
+    return AD5940ERR_SEQREG;
+}
+
+static uint16_t _register(const uint32_t i)
+{
+    return REG_AFE_AFECON + 4 * ((i * 7) % REGISTER_NUMBER);
+}
+
+static void _generate(void)
+{
+    AD5940_SEQGenInit(_buffer, sizeof(_buffer) / sizeof(_buffer[0]));
+    AD5940_SEQGenCtrl(bTRUE);
+    for(uint32_t i=0; i<COMMAND_NUMBER; i++)
+    {
+        const uint16_t address = _register(i);
+        AD5940_WriteReg(address, (AD5940_ReadReg(address) + i) & 0xffffff);
+    }
+    AD5940_SEQGenCtrl(bFALSE);
+}
+
+static uint64_t _time_lookups(AD5940Err (*search)(uint32_t, uint32_t *))
+{
+    uint64_t best = UINT64_MAX;
+    for(int run=0; run<RUNS; run++)
+    {
+        uint32_t index, sum = 0;
+        const uint64_t start = k_cycle_get_64();
+        for(int round=0; round<LOOKUP_ROUNDS; round++)
+        {
+            for(uint32_t address=0; address<256; address++)
+            {
+                if(search(REG_AFE_AFECON + 4 * address, &index) == AD5940ERR_OK) sum += index;
+            }
+        }
+        const uint64_t elapsed = k_cycle_get_64() - start;
+        _sink = sum;
+        if(elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    AD5940_HWReset();
+    AD5940_Initialize();
+
+    uint64_t generate_best = UINT64_MAX;
+    for(int run=0; run<RUNS; run++)
+    {
+        const uint64_t start = k_cycle_get_64();
+        _generate();
+        const uint64_t elapsed = k_cycle_get_64() - start;
+        if(elapsed < generate_best) generate_best = elapsed;
+    }
+
+    const uint32_t *commands;
+    uint32_t length;
+    if(AD5940_SEQGenFetchSeq(&commands, &length) != AD5940ERR_OK || length != COMMAND_NUMBER || SeqGenDB.RegCount != REGISTER_NUMBER)
+    {
+        printf("FAILED: generated %u commands with %u records\n", length, SeqGenDB.RegCount);
+        failed = 1;
+    }
+
+    uint32_t mismatches = 0;
+    for(uint32_t address=0; address<256; address++)
+    {
+        uint32_t index_slot = UINT32_MAX, index_linear = UINT32_MAX;
+        const AD5940Err result_slot = AD5940_SEQGenSearchReg(REG_AFE_AFECON + 4 * address, &index_slot);
+        const AD5940Err result_linear = _search_reg_linear(REG_AFE_AFECON + 4 * address, &index_linear);
+        if(result_slot != result_linear || (result_slot == AD5940ERR_OK && index_slot != index_linear)) mismatches++;
+    }
+    printf("lookup of 256 addresses: %s\n", mismatches == 0 ? "ok" : "FAILED");
+    failed |= mismatches != 0;
+
+    const uint64_t linear_ns = _time_lookups(_search_reg_linear);
+    const uint64_t slot_ns = _time_lookups(AD5940_SEQGenSearchReg);
+    printf("%u records, ns per lookup: linear %.1f, slot table %.1f (best of %u)\n",
+        SeqGenDB.RegCount,
+        (double) linear_ns / (LOOKUP_ROUNDS * 256), (double) slot_ns / (LOOKUP_ROUNDS * 256), RUNS);
+    printf("generation of %u commands: %llu us (best of %u)\n",
+        COMMAND_NUMBER, (unsigned long long) (generate_best / 1000), RUNS);
+
+    /* A reset drops the records, the next read must go to the AD5940 */
+    AD5940_Initialize();
+    uint32_t stale = 0;
+    for(uint32_t address=0; address<256; address++)
+    {
+        uint32_t index;
+        if(AD5940_SEQGenSearchReg(REG_AFE_AFECON + 4 * address, &index) == AD5940ERR_OK) stale++;
+    }
+    AD5940_WriteReg(_register(1), 0xabc);
+    AD5940_SEQGenCtrl(bTRUE);
+    const uint32_t read = AD5940_ReadReg(_register(1));
+    AD5940_SEQGenCtrl(bFALSE);
+    const bool reset_ok = stale == 0 && read == 0xabc && SeqGenDB.RegCount == 1;
+    printf("records after AD5940_Initialize: %s\n", reset_ok ? "ok" : "FAILED");
+    failed |= !reset_ok;
+
+    return failed;
+}
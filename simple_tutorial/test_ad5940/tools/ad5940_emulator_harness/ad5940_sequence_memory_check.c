@@ -0,0 +1,99 @@
+/**
+ * Checks the named slots of `AD5940_UTILITY_sequence_memory_allocate()` and
+ * `AD5940_UTILITY_sequence_memory_allocate_remaining()`.
+ *
+ * One sequence of allocations as the applications make them: a fixed slot at
+ * the top of SRAM, the remaining region below it, the slot reused while it's
+ * large enough, moved when it grows, the remaining region shrinking below new
+ * slots and out-of-memory. A slot that can't grow keeps its address and its words.
+ *
+ * Returns non-zero if any step gives another error or address than expected.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_utility_sequence_memory.h"
+
+#include <stdio.h>
+
+#define SIZE AD5940_UTILITY_SEQUENCE_MEMORY_SIZE
+
+static int _failed = 0;
+
+static void _check(
+    const char *const step,
+    const AD5940Err error,
+    const AD5940Err expected_error,
+    const uint32_t address,
+    const uint32_t expected_address
+)
+{
+    const int ok = (error == expected_error) && (error != AD5940ERR_OK || address == expected_address);
+    printf("%-44s: error %3d address %3u %s\n", step, error, (error == AD5940ERR_OK) ? address : 0, ok ? "ok" : "FAILED");
+    if(!ok) _failed++;
+}
+
+static void _allocate(
+    const char *const step,
+    const char *const name,
+    const uint32_t length,
+    const AD5940Err expected_error,
+    const uint32_t expected_address
+)
+{
+    uint32_t address = 0;
+    const AD5940Err error = AD5940_UTILITY_sequence_memory_allocate(name, length, &address);
+    _check(step, error, expected_error, address, expected_address);
+}
+
+static void _allocate_remaining(
+    const char *const step,
+    const char *const name,
+    const AD5940Err expected_error,
+    const uint32_t expected_address,
+    const uint32_t expected_length
+)
+{
+    uint32_t address = 0, length = 0;
+    const AD5940Err error = AD5940_UTILITY_sequence_memory_allocate_remaining(name, &address, &length);
+    _check(step, error, expected_error, address, expected_address);
+    if(error == AD5940ERR_OK && length != expected_length)
+    {
+        printf("%-44s: length %3u, expected %3u FAILED\n", step, length, expected_length);
+        _failed++;
+    }
+}
+
+int main(void)
+{
+    _allocate("empty length", "temperature", 0, AD5940ERR_PARA, 0);
+    _allocate("longer than the SRAM", "temperature", SIZE + 1, AD5940ERR_BUFF, 0);
+
+    _allocate("first slot at the top", "temperature", 100, AD5940ERR_OK, SIZE - 100);
+    _allocate_remaining("remaining below it", "electrochemical", AD5940ERR_OK, 0, SIZE - 100);
+    _allocate("same length, same address", "temperature", 100, AD5940ERR_OK, SIZE - 100);
+    _allocate("shorter, same address", "temperature", 80, AD5940ERR_OK, SIZE - 100);
+    _allocate_remaining("remaining unchanged", "electrochemical", AD5940ERR_OK, 0, SIZE - 100);
+
+    _allocate("longer, moved into the top", "temperature", 150, AD5940ERR_OK, SIZE - 150);
+    _allocate("second slot below the first", "dac", 100, AD5940ERR_OK, SIZE - 250);
+    _allocate_remaining("remaining shrunk below both", "electrochemical", AD5940ERR_OK, 0, SIZE - 250);
+
+    _allocate("out of memory", "other", SIZE - 200, AD5940ERR_BUFF, 0);
+    _allocate("can't grow", "temperature", SIZE - 100, AD5940ERR_BUFF, 0);
+    _allocate("its words not given to another slot", "other", 150, AD5940ERR_OK, SIZE - 400);
+    AD5940_UTILITY_sequence_memory_free("other");
+    _allocate("kept after it can't grow", "temperature", 150, AD5940ERR_OK, SIZE - 150);
+    _allocate("second slot kept", "dac", 100, AD5940ERR_OK, SIZE - 250);
+
+    AD5940_UTILITY_sequence_memory_free("dac");
+    _allocate_remaining("remaining grows after a free", "electrochemical", AD5940ERR_OK, 0, SIZE - 150);
+    _allocate("fixed slot takes the remaining words", "dac", SIZE - 150, AD5940ERR_OK, 0);
+    _allocate_remaining("nothing remaining", "electrochemical", AD5940ERR_BUFF, 0, 0);
+
+    AD5940_UTILITY_sequence_memory_free("dac");
+    AD5940_UTILITY_sequence_memory_free("temperature");
+    _allocate_remaining("whole SRAM after freeing all", "electrochemical", AD5940ERR_OK, 0, SIZE);
+
+    return _failed;
+}
@@ -0,0 +1,102 @@
+/**
+ * Checks the FIFO fill predicted by `AD5940_UTILITY_sequence_timing_simulate()`
+ * and the threshold of `AD5940_UTILITY_sequence_timing_recommend_FIFO_thresh()`.
+ *
+ * One sequence converts for 10 ms at 200 kSPS (Sinc3 OSR 4 at 16 MHz) in a
+ * 1 s wakeup timer round, about 2000 words per burst into the 1024-word FIFO,
+ * read 2 ms after the threshold interrupt:
+ * - The full FIFO as the threshold overflows.
+ * - The recommended threshold doesn't overflow, one word more does.
+ * - A wakeup slot shorter than the sequence is flagged as an overrun.
+ *
+ * Returns non-zero if any prediction differs.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_utility_sequence_timing.h"
+
+#include <stdio.h>
+
+#define SYSCLK_FREQUENCY 16e6f
+#define LFOSC_FREQUENCY 32000.0f
+#define BURST_CYCLES 160000     /* 10 ms */
+#define DURATION 5.0f
+#define INTERRUPT_RATE 0.5f
+
+static const uint32_t _burst[] = {
+    SEQ_WR(REG_AFE_AFECON, BITM_AFE_AFECON_ADCCONVEN),
+    SEQ_WAIT(BURST_CYCLES),
+    SEQ_WR(REG_AFE_AFECON, 0),
+};
+
+static int _failed = 0;
+
+static void _print(
+    const char *const step,
+    const uint32_t FIFO_thresh,
+    const AD5940_UTILITY_SEQUENCE_TIMING_RESULT *const result,
+    const int ok
+)
+{
+    printf("%-32s: threshold %4u, %4u words per run, FIFO max %4u, %6u lost, %u interrupts, overrun %d %s\n",
+        step, FIFO_thresh, result->samples[0], result->FIFO_max, result->FIFO_overflow,
+        result->interrupts, result->overrun, ok ? "ok" : "FAILED");
+    if(!ok) _failed++;
+}
+
+int main(void)
+{
+    AD5940_UTILITY_SEQUENCE_TIMING_CONFIG config = {
+        .sequences = {{.commands = _burst, .commands_length = sizeof(_burst) / sizeof(_burst[0])}},
+        .wupt = {
+            .WuptEndSeq = WUPTENDSEQ_A,
+            .WuptOrder = {SEQID_0},
+            .SeqxSleepTime = {1},
+            .SeqxWakeupTime = {(uint32_t) LFOSC_FREQUENCY - 1},
+        },
+        .clks_cal = {
+            .DataType = DATATYPE_SINC3,
+            .ADCSinc3Osr = ADCSINC3OSR_4,
+            .RatioSys2AdcClk = 1,
+        },
+        .LFOSC_frequency = LFOSC_FREQUENCY,
+        .SysClk_frequency = SYSCLK_FREQUENCY,
+        .FIFO_size = 1024,
+        .MCU_latency = 0.002f,
+    };
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT result;
+
+    uint32_t first_cycles, period_cycles;
+    if(AD5940_UTILITY_get_ADC_output_cycles(&config.clks_cal, &first_cycles, &period_cycles) != AD5940ERR_OK)
+    {
+        printf("ADC output cycles FAILED\n");
+        return 1;
+    }
+    const int rate_ok = (period_cycles == 80);
+    printf("%-32s: first %u cycles, period %u cycles %s\n", "200 kSPS", first_cycles, period_cycles, rate_ok ? "ok" : "FAILED");
+    if(!rate_ok) _failed++;
+
+    if(AD5940_UTILITY_sequence_timing_simulate(&config, config.FIFO_size, DURATION, &result) != AD5940ERR_OK) return 1;
+    _print("full FIFO threshold", config.FIFO_size, &result,
+        result.FIFO_overflow > 0 && result.FIFO_max == config.FIFO_size && !result.overrun);
+
+    uint32_t FIFO_thresh;
+    if(AD5940_UTILITY_sequence_timing_recommend_FIFO_thresh(&config, INTERRUPT_RATE, DURATION, &FIFO_thresh) != AD5940ERR_OK)
+    {
+        printf("no recommended threshold FAILED\n");
+        return 1;
+    }
+    if(AD5940_UTILITY_sequence_timing_simulate(&config, FIFO_thresh, DURATION, &result) != AD5940ERR_OK) return 1;
+    _print("recommended threshold", FIFO_thresh, &result,
+        result.FIFO_overflow == 0 && result.interrupt_rate >= INTERRUPT_RATE);
+    if(AD5940_UTILITY_sequence_timing_simulate(&config, FIFO_thresh + 1, DURATION, &result) != AD5940ERR_OK) return 1;
+    _print("one word more", FIFO_thresh + 1, &result, result.FIFO_overflow > 0);
+
+    /* About 3 ms awake, the burst takes 10 ms */
+    config.wupt.SeqxWakeupTime[0] = 100;
+    if(AD5940_UTILITY_sequence_timing_simulate(&config, FIFO_thresh, 1, &result) != AD5940ERR_OK) return 1;
+    _print("wakeup slot shorter than the run", FIFO_thresh, &result, result.overrun);
+
+    return _failed;
+}
@@ -0,0 +1,68 @@
+#include "ad5940_spi_counter.h"
+
+#include "ad5940.h"
+
+#include <string.h>
+
+#define FRAME_MARKER 0x100
+
+void __real_AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length);
+void __real_AD5940_CsClr(void);
+void __real_AD5940_CsSet(void);
+
+static AD5940_SPI_COUNTER _counter;
+
+static uint16_t *_stream;
+static size_t _stream_max;
+static size_t *_stream_length;
+
+static void _record(const uint16_t value)
+{
+    if(_stream == NULL) return;
+    if(*_stream_length < _stream_max) _stream[*_stream_length] = value;
+    (*_stream_length)++;
+}
+
+void AD5940_SPI_COUNTER_reset(void)
+{
+    memset(&_counter, 0, sizeof(_counter));
+    return;
+}
+
+void AD5940_SPI_COUNTER_get(AD5940_SPI_COUNTER *const counter)
+{
+    *counter = _counter;
+    return;
+}
+
+void AD5940_SPI_COUNTER_record(uint16_t *const stream, const size_t max, size_t *const length)
+{
+    _stream = stream;
+    _stream_max = max;
+    _stream_length = length;
+    if(length != NULL) *length = 0;
+    return;
+}
+
+void __wrap_AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length)
+{
+    _counter.transfers++;
+    _counter.bytes += length;
+    for(unsigned long i=0; i<length; i++) _record(pSendBuffer[i]);
+    __real_AD5940_ReadWriteNBytes(pSendBuffer, pRecvBuff, length);
+    return;
+}
+
+void __wrap_AD5940_CsClr(void)
+{
+    _counter.frames++;
+    _record(FRAME_MARKER);
+    __real_AD5940_CsClr();
+    return;
+}
+
+void __wrap_AD5940_CsSet(void)
+{
+    __real_AD5940_CsSet();
+    return;
+}
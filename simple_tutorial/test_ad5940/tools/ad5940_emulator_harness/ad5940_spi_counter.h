@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Counts the SPI port calls of the library, linked with
+ * `-Wl,--wrap=AD5940_ReadWriteNBytes,--wrap=AD5940_CsClr,--wrap=AD5940_CsSet`
+ * by build.sh, so the calls still reach the port (the emulator).
+ */
+
+typedef struct
+{
+    uint32_t transfers;     /**< AD5940_ReadWriteNBytes calls */
+    uint32_t bytes;         /**< Bytes clocked by them */
+    uint32_t frames;        /**< CS windows */
+}
+AD5940_SPI_COUNTER;
+
+void AD5940_SPI_COUNTER_reset(void);
+
+void AD5940_SPI_COUNTER_get(AD5940_SPI_COUNTER *const counter);
+
+/**
+ * @brief Records the bytes sent from now on, NULL stops it.
+ *
+ * A CS window starts with a 0x100 marker, so streams with different frame boundaries differ.
+ *
+ * @param length Number of entries recorded, saturated at `max`.
+ */
+void AD5940_SPI_COUNTER_record(uint16_t *const stream, const size_t max, size_t *const length);
+
+#ifdef __cplusplus
+}
+#endif
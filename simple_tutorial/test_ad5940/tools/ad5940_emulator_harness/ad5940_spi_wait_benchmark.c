@@ -0,0 +1,165 @@
+/**
+ * Measures the CPU time the AD5940 SPI port hands back to other threads while
+ * a 1000-word FIFO is drained.
+ *
+ * `ad5940_port_spi_impl_zephyr.c` and `utils/spi` run unchanged on the host
+ * SPI controller of zephyr_host.c, which clocks the bytes into the emulator
+ * at the SPI frequency like a DMA. The drain is timed with both waits:
+ * - sleep: `z_impl_spi_transfer_wait()`, the caller pends on `k_poll`.
+ * - spin: the loop on `k_poll_signal_check()` used before, reproduced by
+ *   wrapping `z_impl_spi_transfer_wait()`.
+ *
+ * A thread of the same priority counts loop iterations meanwhile, like the
+ * BLE thread it stands for. Both the burst `AD5940_FIFORd()` and a drain by
+ * one register read per word are measured.
+ *
+ * Returns non-zero if the data read differs between the waits.
+ */
+
+#include "ad5940.h"
+#include "ad5940_port_spi_impl_zephyr.h"
+
+#include "zephyr_host.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define WORD_COUNT 1000
+
+/* The emulator is built with its port functions renamed, it sits behind the host SPI controller. */
+void AD5940_emulator_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length);
+void AD5940_emulator_CsSet(void);
+void AD5940_emulator_CsClr(void);
+int AD5940_emulator_spi_impl_zephyr_init(void);
+
+int __real_z_impl_spi_transfer_wait(struct k_poll_signal *const spi_done_sig, const k_timeout_t timeout);
+
+typedef enum
+{
+    _WAIT_SLEEP,
+    _WAIT_SPIN,
+}
+_WAIT;
+
+typedef enum
+{
+    _DRAIN_BURST,
+    _DRAIN_REGISTER,
+}
+_DRAIN;
+
+static _WAIT _wait;
+
+static volatile bool _background_run;
+static volatile uint64_t _background_count;
+
+int __wrap_z_impl_spi_transfer_wait(struct k_poll_signal *const spi_done_sig, const k_timeout_t timeout)
+{
+    if(_wait == _WAIT_SLEEP) return __real_z_impl_spi_transfer_wait(spi_done_sig, timeout);
+
+    unsigned int spi_signaled;
+    int spi_result;
+    do
+    {
+        k_poll_signal_check(spi_done_sig, &spi_signaled, &spi_result);
+    }
+    while(spi_signaled == 0);
+    return spi_result;
+}
+
+static void _emulator_transfer(const uint8_t *tx, uint8_t *rx, size_t length)
+{
+    AD5940_emulator_ReadWriteNBytes((unsigned char *) tx, rx, length);
+}
+
+static void _cs_hook(gpio_pin_t pin, int level)
+{
+    if(pin != ZEPHYR_HOST_PIN_ad5940_cs_gpios) return;
+    if(level) AD5940_emulator_CsSet();
+    else AD5940_emulator_CsClr();
+}
+
+static void *_background_thread(void *arg)
+{
+    (void) arg;
+    while(_background_run) _background_count++;
+    return NULL;
+}
+
+static void _fill_fifo(void)
+{
+    AD5940_HWReset();
+    AD5940_Initialize();
+    AD5940_WriteReg(REG_AFE_FIFOCON, BITM_AFE_FIFOCON_DATAFIFOEN);
+    for(uint32_t i=0; i<WORD_COUNT; i++)
+    {
+        AD5940_WriteReg(REG_AFE_LPDACDAT0, (i * 37) & 0xfff);
+        AD5940_WriteReg(REG_AFE_AFECON, BITM_AFE_AFECON_ADCCONVEN);
+    }
+}
+
+static void _drain(uint32_t *const buffer, const _DRAIN drain)
+{
+    if(drain == _DRAIN_BURST)
+    {
+        AD5940_FIFORd(buffer, WORD_COUNT);
+        return;
+    }
+    for(uint32_t i=0; i<WORD_COUNT; i++) buffer[i] = AD5940_ReadReg(REG_AFE_DATAFIFORD);
+}
+
+int main(void)
+{
+    static const char *const wait_names[] = {"sleep", "spin"};
+    static const char *const drain_names[] = {"burst FIFORd", "register reads"};
+    static uint32_t words[2][WORD_COUNT];
+    int failed = 0;
+
+    zephyr_host_spi_set_target(_emulator_transfer);
+    zephyr_host_gpio_set_output_hook(_cs_hook);
+    AD5940_emulator_spi_impl_zephyr_init();
+    AD5940_spi_impl_zephyr_init();
+
+    /* The default frequency of the port, AD5940_spi_impl_zephyr_select_frequency() isn't run. */
+    printf("%u words at %u Hz, a thread of the same priority runs meanwhile\n", WORD_COUNT, AD5940_spi_impl_zephyr_get_frequency());
+    printf("%-15s %-6s %10s %10s %8s %14s\n", "drain", "wait", "wall us", "cpu us", "idle", "background/ms");
+    for(int drain=_DRAIN_BURST; drain<=_DRAIN_REGISTER; drain++)
+    {
+        for(int wait=_WAIT_SLEEP; wait<=_WAIT_SPIN; wait++)
+        {
+            pthread_t background;
+
+            _wait = _WAIT_SLEEP;
+            _fill_fifo();
+
+            _wait = wait;
+            _background_count = 0;
+            _background_run = true;
+            pthread_create(&background, NULL, _background_thread, NULL);
+            k_sleep(K_MSEC(1));
+
+            const uint64_t count_start = _background_count;
+            const uint64_t wall_start = k_cycle_get_64();
+            const uint64_t cpu_start = zephyr_host_thread_cpu_ns();
+            _drain(words[wait], drain);
+            const uint64_t cpu_ns = zephyr_host_thread_cpu_ns() - cpu_start;
+            const uint64_t wall_ns = k_cycle_get_64() - wall_start;
+            const uint64_t count = _background_count - count_start;
+
+            _background_run = false;
+            pthread_join(background, NULL);
+
+            printf("%-15s %-6s %10llu %10llu %7.1f%% %14.0f\n",
+                drain_names[drain], wait_names[wait],
+                (unsigned long long) (wall_ns / 1000), (unsigned long long) (cpu_ns / 1000),
+                wall_ns > cpu_ns ? 100.0 * (double) (wall_ns - cpu_ns) / (double) wall_ns : 0.0,
+                (double) count * 1e6 / (double) wall_ns);
+        }
+        if(memcmp(words[_WAIT_SLEEP], words[_WAIT_SPIN], sizeof(words[0])) != 0 || words[_WAIT_SLEEP][WORD_COUNT - 1] == 0)
+        {
+            printf("FAILED: %s data differs between the waits\n", drain_names[drain]);
+            failed = 1;
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,242 @@
+/**
+ * Checks the temperature conversions interleaved into electrochemical scans by
+ * utility/ad5940_electrochemical_utility_temperature on the emulator.
+ *
+ * - The wakeup timer cycles of CV-like scans (2 ADC data in 4 slots) and CA
+ *   (1 slot) are expanded for the interval, intervals that don't fit are rejected.
+ * - The temperature sequence is written by the library, its ADCCON writes are
+ *   patched to the temperature sensor and back to the ADC input of the scan.
+ * - The expanded cycles are played on the emulator, the FIFO is read in chunks
+ *   that end between the two data of the temperature sequence, and split.
+ *   The counts must match `AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count()`
+ *   and every temperature data must be the 25 degree Celsius of the emulator.
+ * - A disabled interval writes nothing, the statistics block and a short SRAM
+ *   region are rejected, and a full temperature buffer leaves the data as they are.
+ *
+ * Returns non-zero if any step differs.
+ */
+
+#include "ad5940.h"
+
+#include "ad5940_electrochemical_utility_temperature.h"
+
+/* Built in, so the SRAM of the emulator can be inspected */
+#include "ad5940_port_emulator_impl_zephyr.c"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ADC_SEQUENCE_ADDRESS 0
+#define TEMPERATURE_SEQUENCE_ADDRESS 16
+#define SEQUENCE_MEMORY_END 512
+#define ROUNDS 4
+#define READ_CHUNK 3
+/* Input of the scan, kept by the temperature sequence */
+#define SCAN_ADCCON (ADCPGA_1P5 << BITP_AFE_ADCCON_GNPGA | ADCMUXN_LPTIA0_N << BITP_AFE_ADCCON_MUXSELN | ADCMUXP_LPTIA0_P)
+/* 25 degree Celsius of the emulator with PGA 1.5, within its noise */
+#define TEMPERATURE_CODE (0x8000 + (int32_t) ((25.0f + 273.15f) * 8.13f * 1.5f))
+#define NOISE 8
+
+static uint32_t _sequence_generator_buffer[256];
+static int _failed = 0;
+
+static void _result(const char *const step, const int ok)
+{
+    printf("%-52s %s\n", step, ok ? "ok" : "FAILED");
+    if(!ok) _failed++;
+}
+
+/* The ADC sequence of the sop utility */
+static SEQInfo_Type _ADC_seq_info = {
+    .SeqId = SEQID_0,
+};
+
+void AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_seq_info(
+    SEQInfo_Type **ADC_seq_info
+)
+{
+    *ADC_seq_info = &_ADC_seq_info;
+}
+
+static const ADCFilterCfg_Type _adc_filter = {
+    .ADCSinc3Osr = ADCSINC3OSR_4,
+    .ADCSinc2Osr = ADCSINC2OSR_22,
+    .ADCAvgNum = ADCAVGNUM_16,
+    .BpSinc3 = bFALSE,
+    .BpNotch = bTRUE,
+    .Sinc2NotchEnable = bTRUE,
+};
+static const DFTCfg_Type _dft = {0};
+static const AD5940_UTILITY_ClockConfig _clock = {.RatioSys2AdcClk = 1};
+
+static AD5940Err _write(const uint8_t interval, const BoolFlag StatEnable, const uint32_t end_address, uint32_t *const length)
+{
+    const StatCfg_Type stat = {.StatEnable = StatEnable};
+    AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(interval);
+    return AD5940_ELECTROCHEMICAL_UTILITY_temperature_write_sequence_commands(
+        TEMPERATURE_SEQUENCE_ADDRESS, end_address, length, &_adc_filter, &_dft, &stat, &_clock, DATATYPE_SINC3);
+}
+
+static void _check_parameters(void)
+{
+    uint32_t length = 1;
+    _result("interval 0 writes nothing", _write(0, bFALSE, SEQUENCE_MEMORY_END, &length) == AD5940ERR_OK && length == 0);
+    _result("interval 0 adds no FIFO data", AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(100) == 100);
+    WUPTCfg_Type wupt = {.WuptEndSeq = WUPTENDSEQ_A, .WuptOrder = {SEQID_0}};
+    _result("interval 0 keeps the wakeup timer",
+        AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&wupt) == AD5940ERR_OK && wupt.WuptEndSeq == WUPTENDSEQ_A);
+
+    _result("statistics block rejected", _write(4, bTRUE, SEQUENCE_MEMORY_END, &length) == AD5940ERR_PARA);
+    _result("short SRAM region rejected", _write(4, bFALSE, TEMPERATURE_SEQUENCE_ADDRESS + 4, &length) == AD5940ERR_BUFF);
+    _result("interval 4 adds a FIFO data every 4", AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(100) == 125);
+
+    /* CV-like: DAC, ADC, DAC, ADC */
+    static const uint32_t cv_order[] = {SEQID_1, SEQID_0, SEQID_2, SEQID_0};
+    for(uint8_t interval=1; interval<=8; interval++)
+    {
+        WUPTCfg_Type cv = {.WuptEndSeq = WUPTENDSEQ_D};
+        memcpy(cv.WuptOrder, cv_order, sizeof(cv_order));
+        AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(interval);
+        const AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&cv);
+        const int fits = (interval == 2 || interval == 4);
+        char step[64];
+        snprintf(step, sizeof(step), "CV-like cycle, interval %u %s", interval, fits ? "expanded" : "rejected");
+        _result(step, fits ? (error == AD5940ERR_OK && cv.WuptEndSeq == 4 * interval / 2 - 1) : (error == AD5940ERR_PARA));
+    }
+
+    /* CA: ADC only */
+    for(uint8_t interval=1; interval<=9; interval++)
+    {
+        WUPTCfg_Type ca = {.WuptEndSeq = WUPTENDSEQ_A, .WuptOrder = {SEQID_0}};
+        AD5940_ELECTROCHEMICAL_UTILITY_temperature_set_interval(interval);
+        const AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&ca);
+        const int fits = (interval <= 8);
+        int ok = fits ? (error == AD5940ERR_OK && ca.WuptEndSeq == interval - 1u) : (error == AD5940ERR_PARA);
+        for(uint8_t i=0; ok && fits && i<interval; i++)
+        {
+            ok = ca.WuptOrder[i] == ((i == interval - 1) ? AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID : SEQID_0);
+        }
+        char step[64];
+        snprintf(step, sizeof(step), "CA cycle, interval %u %s", interval, fits ? "expanded" : "rejected");
+        _result(step, ok);
+    }
+}
+
+static void _check_scan(void)
+{
+    static const uint32_t adc_sequence[] = {
+        SEQ_WR(REG_AFE_AFECON, BITM_AFE_AFECON_ADCCONVEN),
+        SEQ_WR(REG_AFE_AFECON, 0),
+    };
+    static const uint32_t cv_order[] = {SEQID_1, SEQID_0, SEQID_2, SEQID_0};
+    const uint8_t interval = 4;
+
+    AD5940_HWReset();
+    AD5940_Initialize();
+    AD5940_WriteReg(REG_AFE_ADCCON, SCAN_ADCCON);
+    AD5940_WriteReg(REG_AFE_FIFOCON, BITM_AFE_FIFOCON_DATAFIFOEN);
+    AD5940_SEQCmdWrite(ADC_SEQUENCE_ADDRESS, adc_sequence, 2);
+    AD5940_WriteReg(REG_AFE_SEQ0INFO, (ADC_SEQUENCE_ADDRESS << BITP_AFE_SEQ0INFO_ADDR) | (2 << BITP_AFE_SEQ0INFO_LEN));
+    AD5940_SEQCtrlS(bTRUE);
+
+    uint32_t length;
+    if(_write(interval, bFALSE, SEQUENCE_MEMORY_END, &length) != AD5940ERR_OK || length == 0)
+    {
+        _result("temperature sequence written", 0);
+        return;
+    }
+    WUPTCfg_Type wupt = {.WuptEndSeq = WUPTENDSEQ_D};
+    memcpy(wupt.WuptOrder, cv_order, sizeof(cv_order));
+    if(AD5940_ELECTROCHEMICAL_UTILITY_temperature_WUPT_config(&wupt) != AD5940ERR_OK)
+    {
+        _result("wakeup timer expanded", 0);
+        return;
+    }
+
+    /* The first ADCCON write switches to the sensor, the last one back to the scan */
+    uint32_t adccon_writes[4], adccon_count = 0;
+    for(uint32_t i=0; i<length; i++)
+    {
+        const uint32_t command = _emulator.sram[TEMPERATURE_SEQUENCE_ADDRESS + i];
+        if((command & 0xFF000000) != (SEQ_WR(REG_AFE_ADCCON, 0) & 0xFF000000)) continue;
+        if(adccon_count < 4) adccon_writes[adccon_count] = command & 0xFFFFFF;
+        adccon_count++;
+    }
+    const uint32_t temperature_adccon = (SCAN_ADCCON & ~(BITM_AFE_ADCCON_MUXSELP | BITM_AFE_ADCCON_MUXSELN))
+        | (ADCMUXP_TEMPP << BITP_AFE_ADCCON_MUXSELP) | (ADCMUXN_TEMPN << BITP_AFE_ADCCON_MUXSELN);
+    _result("ADCCON patched to the sensor and back",
+        adccon_count == 2 && adccon_writes[0] == temperature_adccon && adccon_writes[1] == SCAN_ADCCON);
+
+    /* The wakeup timer, one sequence per slot; the DAC sequences have no commands here */
+    for(uint32_t round=0; round<ROUNDS; round++)
+    {
+        for(uint32_t slot=0; slot<=wupt.WuptEndSeq; slot++)
+        {
+            if(wupt.WuptOrder[slot] == SEQID_0 || wupt.WuptOrder[slot] == AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID)
+            {
+                AD5940_WriteReg(REG_AFECON_TRIGSEQ, 1L << wupt.WuptOrder[slot]);
+            }
+        }
+    }
+    _result("scan input restored after the temperature", AD5940_ReadReg(REG_AFE_ADCCON) == SCAN_ADCCON);
+
+    const uint32_t adc_data_count = ROUNDS * interval;
+    const uint32_t fifo_count = AD5940_FIFOGetCnt();
+    _result("FIFO count predicted", fifo_count == AD5940_ELECTROCHEMICAL_UTILITY_temperature_get_fifo_count(adc_data_count));
+
+    /* Rewritten to restart the split, like every start of a scan */
+    _write(interval, bFALSE, SEQUENCE_MEMORY_END, &length);
+    uint32_t adc_total = 0, temperature_total = 0;
+    uint32_t full_count = 0;
+    int temperatures_ok = 1, adc_ok = 1, full_ok = 1;
+    while(AD5940_FIFOGetCnt() > 0)
+    {
+        uint32_t data[READ_CHUNK], temperatures[READ_CHUNK];
+        uint16_t data_length = (AD5940_FIFOGetCnt() < READ_CHUNK) ? AD5940_FIFOGetCnt() : READ_CHUNK;
+        uint16_t temperature_length = 0;
+        AD5940_FIFORd(data, data_length);
+
+        uint32_t before[READ_CHUNK];
+        const uint16_t length_before = data_length;
+        memcpy(before, data, sizeof(before));
+        /* No room for temperature data first, the read is split as usual if it has none */
+        AD5940Err error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_split(data, &data_length, temperatures, &temperature_length, 0);
+        if(error == AD5940ERR_BUFF)
+        {
+            full_count++;
+            full_ok = full_ok && data_length == length_before && memcmp(before, data, sizeof(before)) == 0;
+            error = AD5940_ELECTROCHEMICAL_UTILITY_temperature_split(data, &data_length, temperatures, &temperature_length, READ_CHUNK);
+        }
+        if(error != AD5940ERR_OK)
+        {
+            adc_ok = 0;
+            break;
+        }
+        for(uint16_t i=0; i<data_length; i++)
+        {
+            const uint32_t SeqId = FIFO_SEQID(data[i]);
+            if(SeqId != SEQID_0 && SeqId != AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID) adc_ok = 0;
+        }
+        for(uint16_t i=0; i<temperature_length; i++)
+        {
+            const int32_t code = temperatures[i] & 0xFFFF;
+            if(FIFO_SEQID(temperatures[i]) != AD5940_ELECTROCHEMICAL_UTILITY_TEMPERATURE_SEQID) temperatures_ok = 0;
+            if(code < TEMPERATURE_CODE - NOISE || code > TEMPERATURE_CODE + NOISE) temperatures_ok = 0;
+        }
+        adc_total += data_length;
+        temperature_total += temperature_length;
+    }
+    char step[64];
+    snprintf(step, sizeof(step), "split in reads of %u: %u ADC, %u temperature data", READ_CHUNK, adc_total, temperature_total);
+    _result(step, adc_ok && adc_total == adc_data_count && temperature_total == ROUNDS);
+    _result("temperature data at 25 degree Celsius", temperatures_ok && temperature_total > 0);
+    _result("full temperature buffer leaves the data", full_ok && full_count > 0);
+}
+
+int main(void)
+{
+    AD5940_SEQGenInit(_sequence_generator_buffer, sizeof(_sequence_generator_buffer) / sizeof(_sequence_generator_buffer[0]));
+    _check_parameters();
+    _check_scan();
+    return _failed;
+}
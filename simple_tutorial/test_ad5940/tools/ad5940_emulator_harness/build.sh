@@ -0,0 +1,144 @@
+#!/bin/sh
+# Builds one host harness of the AD5940 library and port against the emulator
+# of electrochemical_tester_with_bluetooth, with the Zephyr stand-in of
+# zephyr_host.c.
+#
+#     ./build.sh HARNESS OUTPUT
+#
+# HARNESS is the name of a harness source without .c, e.g.
+# ad5940_fifo_read_check. Use run.sh to build and run all of them.
+#
+# Needs a host C compiler (CC, default cc) with pthreads.
+
+set -e
+
+TOOL_DIR=$(cd "$(dirname "$0")" && pwd)
+AD5940_DIR=$TOOL_DIR/../../src/ad5940
+APP_DIR=$TOOL_DIR/../../../../electrochemical_tester_with_bluetooth
+PORT_DIR=$APP_DIR/src/port/sdk/ad5940
+UTILS_DIR=$TOOL_DIR/../../../../utils
+HARNESS=$1
+OUTPUT=$2
+CC=${CC:-cc}
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+CFLAGS="-std=gnu11 -O2 -w -D_GNU_SOURCE -DCHIPSEL_594X -I$TOOL_DIR -I$AD5940_DIR/library -I$PORT_DIR"
+LDFLAGS="-lpthread -lm"
+
+# The library calls of the SPI port are counted by ad5940_spi_counter.c
+SPI_COUNTER_LDFLAGS="-Wl,--wrap=AD5940_ReadWriteNBytes,--wrap=AD5940_CsClr,--wrap=AD5940_CsSet"
+
+# The emulator behind the host SPI controller, so the SPI port itself can run
+EMULATOR_BEHIND_SPI_CFLAGS="-DAD5940_ReadWriteNBytes=AD5940_emulator_ReadWriteNBytes \
+    -DAD5940_CsSet=AD5940_emulator_CsSet -DAD5940_CsClr=AD5940_emulator_CsClr \
+    -DAD5940_spi_impl_zephyr_init=AD5940_emulator_spi_impl_zephyr_init \
+    -DAD5940_spi_impl_zephyr_select_frequency=AD5940_emulator_spi_impl_zephyr_select_frequency \
+    -DAD5940_spi_impl_zephyr_get_frequency=AD5940_emulator_spi_impl_zephyr_get_frequency"
+SPI_PORT_CFLAGS="-I$APP_DIR/src/driver -I$UTILS_DIR/spi/zephyr -DCONFIG_AD5940_SPI_MAX_FREQUENCY=16000000"
+
+OBJECTS=""
+
+# compile SOURCE [CFLAGS...]
+compile() {
+    compile_as "$(basename "$1" .c)" "$@"
+}
+
+# compile_as NAME SOURCE [CFLAGS...], for a source built more than once
+compile_as() {
+    object=$BUILD_DIR/$1.o
+    shift
+    # shellcheck disable=SC2086
+    "$CC" $CFLAGS "$@" -c -o "$object"
+    OBJECTS="$OBJECTS $object"
+}
+
+compile "$TOOL_DIR/zephyr_host.c"
+# Harnesses that reach into the library build it in themselves
+case "$HARNESS" in
+ad5940_seqgen_lookup_benchmark) ;;
+ad5940_seq_cmd_write_check)
+    # The burst upload is off until verified on a real AD5940, checked here against the emulator
+    compile "$AD5940_DIR/library/ad5940.c" -DSEQ_CMDWRITE_BURST
+    ;;
+*) compile "$AD5940_DIR/library/ad5940.c" ;;
+esac
+compile "$PORT_DIR/ad5940_port_delay_impl_zephyr.c"
+compile "$PORT_DIR/ad5940_port_useless.c"
+
+case "$HARNESS" in
+ad5940_fifo_read_check)
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    compile "$TOOL_DIR/ad5940_spi_counter.c"
+    LDFLAGS="$LDFLAGS $SPI_COUNTER_LDFLAGS"
+    ;;
+ad5940_seq_cmd_write_check)
+    # The harness includes the emulator to inspect its SRAM
+    compile "$TOOL_DIR/ad5940_spi_counter.c"
+    LDFLAGS="$LDFLAGS $SPI_COUNTER_LDFLAGS"
+    ;;
+ad5940_intc0_latency_benchmark)
+    CFLAGS="$CFLAGS -I$APP_DIR/src/application -I$APP_DIR/src/port/application -I$APP_DIR/src/driver \
+        -I$UTILS_DIR/gpio/debounce/zephyr -I$UTILS_DIR/gpio/edge/zephyr -DCONFIG_AD5940_INTC0_DEBOUNCE_MS=20"
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c" \
+        -DAD5940_intc0_impl_zephyr_init=AD5940_emulator_intc0_impl_zephyr_init
+    compile_as ad5940_port_intc0_impl_zephyr_edge "$PORT_DIR/ad5940_port_intc0_impl_zephyr.c" \
+        -DAD5940_intc0_impl_zephyr_init=AD5940_intc0_impl_zephyr_init_edge
+    compile_as ad5940_port_intc0_impl_zephyr_debounce "$PORT_DIR/ad5940_port_intc0_impl_zephyr.c" \
+        -DAD5940_intc0_impl_zephyr_init=AD5940_intc0_impl_zephyr_init_debounce -DCONFIG_AD5940_INTC0_DEBOUNCE
+    compile "$PORT_DIR/ad5940_port_gpio_impl_zephyr.c"
+    compile "$APP_DIR/src/port/application/ad5940_intc0_lock_impl_zephyr.c"
+    compile "$UTILS_DIR/gpio/debounce/zephyr/gpio_debounce.c"
+    compile "$UTILS_DIR/gpio/edge/zephyr/gpio_edge.c"
+    ;;
+ad5940_seqgen_lookup_benchmark)
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    ;;
+ad5940_adc_fixed_check)
+    # The emulator only satisfies the port of the library, the conversion doesn't touch it
+    CFLAGS="$CFLAGS -I$AD5940_DIR/utility"
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    compile "$AD5940_DIR/utility/ad5940_utility_adc.c"
+    ;;
+ad5940_sequence_memory_check)
+    # The emulator only satisfies the port of the library, the allocator doesn't touch it
+    CFLAGS="$CFLAGS -I$AD5940_DIR/utility"
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    compile "$AD5940_DIR/utility/ad5940_utility_sequence_memory.c"
+    ;;
+ad5940_sequence_timing_check)
+    # The emulator only satisfies the port of the library, the simulation doesn't touch it
+    CFLAGS="$CFLAGS -I$AD5940_DIR/utility"
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    compile "$AD5940_DIR/utility/ad5940_utility_sequence_timing.c"
+    ;;
+ad5940_dac_stream_check)
+    # Only the stream utility, the harness stands in for the electrochemical region of the sop utility
+    CFLAGS="$CFLAGS -I$AD5940_DIR/utility -I$AD5940_DIR/application/electrochemical/utility"
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c"
+    compile "$AD5940_DIR/application/electrochemical/utility/ad5940_electrochemical_utility_dac_stream.c"
+    ;;
+ad5940_temperature_interleave_check)
+    # The harness includes the emulator to inspect its SRAM and stands in for the ADC sequence of the sop utility
+    CFLAGS="$CFLAGS -I$AD5940_DIR/utility -I$AD5940_DIR/application/electrochemical/utility"
+    compile "$AD5940_DIR/application/electrochemical/utility/ad5940_electrochemical_utility_temperature.c"
+    ;;
+ad5940_spi_wait_benchmark)
+    # shellcheck disable=SC2086
+    compile "$PORT_DIR/ad5940_port_emulator_impl_zephyr.c" $EMULATOR_BEHIND_SPI_CFLAGS
+    # shellcheck disable=SC2086
+    compile "$PORT_DIR/ad5940_port_spi_impl_zephyr.c" $SPI_PORT_CFLAGS
+    compile "$UTILS_DIR/spi/zephyr/spi.c"
+    LDFLAGS="$LDFLAGS -Wl,--wrap=z_impl_spi_transfer_wait"
+    ;;
+*)
+    echo "Unknown harness $HARNESS" >&2
+    exit 1
+    ;;
+esac
+
+compile "$TOOL_DIR/$HARNESS.c"
+
+# shellcheck disable=SC2086
+"$CC" $OBJECTS $LDFLAGS -o "$OUTPUT"
@@ -0,0 +1,33 @@
+#!/bin/sh
+# Builds and runs the host harnesses against the AD5940 emulator, stops at
+# the first failing one.
+#
+#     ./run.sh [HARNESS...]
+#
+# Without arguments every harness runs.
+
+set -e
+
+TOOL_DIR=$(cd "$(dirname "$0")" && pwd)
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+HARNESSES=${*:-"
+    ad5940_fifo_read_check
+    ad5940_spi_wait_benchmark
+    ad5940_seq_cmd_write_check
+    ad5940_seqgen_lookup_benchmark
+    ad5940_intc0_latency_benchmark
+    ad5940_adc_fixed_check
+    ad5940_sequence_memory_check
+    ad5940_sequence_timing_check
+    ad5940_dac_stream_check
+    ad5940_temperature_interleave_check
+"}
+
+for harness in $HARNESSES; do
+    echo "== $harness"
+    "$TOOL_DIR/build.sh" "$harness" "$BUILD_DIR/$harness"
+    "$BUILD_DIR/$harness"
+done
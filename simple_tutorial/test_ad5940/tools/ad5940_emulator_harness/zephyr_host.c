@@ -0,0 +1,508 @@
+#include "zephyr_host.h"
+
+#include <string.h>
+#include <sys/prctl.h>
+#include <time.h>
+
+#define GPIO_PIN_NUMBER 32
+
+const struct device zephyr_host_device = { .name = "host" };
+
+static pthread_mutex_t _irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static uint64_t _now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static struct timespec _to_timespec(const uint64_t ns)
+{
+    struct timespec t = {
+        .tv_sec = ns / 1000000000ULL,
+        .tv_nsec = ns % 1000000000ULL,
+    };
+    return t;
+}
+
+/* Waits on a condition until the absolute deadline, 0 or ETIMEDOUT. */
+static int _cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex, const k_timeout_t timeout, const uint64_t start)
+{
+    if(timeout.ns < 0) return pthread_cond_wait(cond, mutex);
+    const struct timespec deadline = _to_timespec(start + (uint64_t) timeout.ns);
+    return pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+uint32_t k_cycle_get_32(void)
+{
+    return (uint32_t) _now_ns();
+}
+
+uint64_t k_cycle_get_64(void)
+{
+    return _now_ns();
+}
+
+int32_t k_sleep(k_timeout_t timeout)
+{
+    if(timeout.ns <= 0) return 0;
+    const struct timespec deadline = _to_timespec(_now_ns() + (uint64_t) timeout.ns);
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR);
+    return 0;
+}
+
+unsigned int irq_lock(void)
+{
+    pthread_mutex_lock(&_irq_lock);
+    return 0;
+}
+
+void irq_unlock(unsigned int key)
+{
+    (void) key;
+    pthread_mutex_unlock(&_irq_lock);
+}
+
+uint64_t zephyr_host_thread_cpu_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/* Mutex */
+
+int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+    (void) timeout;
+    return pthread_mutex_lock(&mutex->mutex) == 0 ? 0 : -EAGAIN;
+}
+
+int k_mutex_unlock(struct k_mutex *mutex)
+{
+    return pthread_mutex_unlock(&mutex->mutex) == 0 ? 0 : -EPERM;
+}
+
+/* Semaphore */
+
+int k_sem_init(struct k_sem *sem, unsigned int initial_count, unsigned int limit)
+{
+    pthread_mutex_lock(&sem->mutex);
+    sem->count = initial_count;
+    sem->limit = limit;
+    pthread_mutex_unlock(&sem->mutex);
+    return 0;
+}
+
+void k_sem_give(struct k_sem *sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    if(sem->count < sem->limit) sem->count++;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+{
+    const uint64_t start = _now_ns();
+    int ret = 0;
+    pthread_mutex_lock(&sem->mutex);
+    while(sem->count == 0)
+    {
+        if(timeout.ns == 0 || _cond_wait(&sem->cond, &sem->mutex, timeout, start) == ETIMEDOUT)
+        {
+            ret = -EAGAIN;
+            break;
+        }
+    }
+    if(ret == 0) sem->count--;
+    pthread_mutex_unlock(&sem->mutex);
+    return ret;
+}
+
+/* System workqueue */
+
+static pthread_mutex_t _work_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _work_cond = PTHREAD_COND_INITIALIZER;
+static struct k_work_delayable *_work_list;
+static pthread_once_t _work_once = PTHREAD_ONCE_INIT;
+
+static void _work_remove(struct k_work_delayable *dwork)
+{
+    for(struct k_work_delayable **p = &_work_list; *p != NULL; p = &(*p)->next)
+    {
+        if(*p != dwork) continue;
+        *p = dwork->next;
+        break;
+    }
+    dwork->pending = false;
+}
+
+static void *_work_thread(void *arg)
+{
+    (void) arg;
+    prctl(PR_SET_TIMERSLACK, 1UL);
+    pthread_mutex_lock(&_work_mutex);
+    for(;;)
+    {
+        struct k_work_delayable *first = NULL;
+        for(struct k_work_delayable *w = _work_list; w != NULL; w = w->next)
+        {
+            if(first == NULL || w->deadline < first->deadline) first = w;
+        }
+        if(first == NULL)
+        {
+            pthread_cond_wait(&_work_cond, &_work_mutex);
+            continue;
+        }
+        if(first->deadline > _now_ns())
+        {
+            const struct timespec deadline = _to_timespec(first->deadline);
+            pthread_cond_timedwait(&_work_cond, &_work_mutex, &deadline);
+            continue;
+        }
+        _work_remove(first);
+        pthread_mutex_unlock(&_work_mutex);
+        first->work.handler(&first->work);
+        pthread_mutex_lock(&_work_mutex);
+    }
+    return NULL;
+}
+
+static void _work_start(void)
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, _work_thread, NULL);
+    pthread_detach(thread);
+}
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler)
+{
+    memset(dwork, 0, sizeof(*dwork));
+    dwork->work.handler = handler;
+}
+
+static int _work_submit(struct k_work_delayable *dwork, const k_timeout_t delay, const bool reschedule)
+{
+    pthread_once(&_work_once, _work_start);
+    pthread_mutex_lock(&_work_mutex);
+    if(dwork->pending && !reschedule)
+    {
+        pthread_mutex_unlock(&_work_mutex);
+        return 0;
+    }
+    if(dwork->pending) _work_remove(dwork);
+    dwork->deadline = _now_ns() + (uint64_t) (delay.ns > 0 ? delay.ns : 0);
+    dwork->pending = true;
+    dwork->next = _work_list;
+    _work_list = dwork;
+    pthread_cond_signal(&_work_cond);
+    pthread_mutex_unlock(&_work_mutex);
+    return 1;
+}
+
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay)
+{
+    return _work_submit(dwork, delay, false);
+}
+
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay)
+{
+    return _work_submit(dwork, delay, true);
+}
+
+int k_work_cancel_delayable(struct k_work_delayable *dwork)
+{
+    pthread_mutex_lock(&_work_mutex);
+    if(dwork->pending) _work_remove(dwork);
+    pthread_mutex_unlock(&_work_mutex);
+    return 0;
+}
+
+/* Poll signal */
+
+void k_poll_signal_reset(struct k_poll_signal *sig)
+{
+    pthread_mutex_lock(&sig->mutex);
+    sig->signaled = 0;
+    pthread_mutex_unlock(&sig->mutex);
+}
+
+void k_poll_signal_check(struct k_poll_signal *sig, unsigned int *signaled, int *result)
+{
+    pthread_mutex_lock(&sig->mutex);
+    *signaled = sig->signaled;
+    *result = sig->result;
+    pthread_mutex_unlock(&sig->mutex);
+}
+
+int k_poll_signal_raise(struct k_poll_signal *sig, int result)
+{
+    pthread_mutex_lock(&sig->mutex);
+    sig->signaled = 1;
+    sig->result = result;
+    pthread_cond_broadcast(&sig->cond);
+    pthread_mutex_unlock(&sig->mutex);
+    return 0;
+}
+
+int k_poll(struct k_poll_event *events, int num_events, k_timeout_t timeout)
+{
+    const uint64_t start = _now_ns();
+    struct k_poll_signal *sig = events[0].signal;
+    int ret = 0;
+    if(num_events != 1) return -EINVAL;
+    pthread_mutex_lock(&sig->mutex);
+    while(!sig->signaled)
+    {
+        if(timeout.ns == 0 || _cond_wait(&sig->cond, &sig->mutex, timeout, start) == ETIMEDOUT)
+        {
+            ret = -EAGAIN;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&sig->mutex);
+    return ret;
+}
+
+/* Device */
+
+bool device_is_ready(const struct device *dev)
+{
+    return dev != NULL;
+}
+
+/* GPIO */
+
+static struct
+{
+    int level;                  /* Physical */
+    gpio_flags_t flags;
+    gpio_flags_t interrupt;
+}
+_pins[GPIO_PIN_NUMBER];
+
+static struct gpio_callback *_gpio_callbacks;
+static void (*_gpio_output_hook)(gpio_pin_t pin, int level);
+
+void gpio_init_callback(struct gpio_callback *callback, gpio_callback_handler_t handler, gpio_port_pins_t pin_mask)
+{
+    callback->next = NULL;
+    callback->handler = handler;
+    callback->pin_mask = pin_mask;
+}
+
+int gpio_add_callback(const struct device *port, struct gpio_callback *callback)
+{
+    (void) port;
+    irq_lock();
+    callback->next = _gpio_callbacks;
+    _gpio_callbacks = callback;
+    irq_unlock(0);
+    return 0;
+}
+
+int gpio_pin_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t extra_flags)
+{
+    irq_lock();
+    _pins[spec->pin].flags = spec->dt_flags | extra_flags;
+    /* Inputs are pulled up, like the idle AD5940 interrupt line */
+    if(extra_flags & GPIO_INPUT) _pins[spec->pin].level = 1;
+    irq_unlock(0);
+    return 0;
+}
+
+int gpio_pin_interrupt_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t flags)
+{
+    const bool active_low = (spec->dt_flags & GPIO_ACTIVE_LOW) != 0;
+    gpio_flags_t interrupt = flags & (GPIO_INT_DISABLE | GPIO_INT_EDGE_BOTH);
+    if(flags & GPIO_INT_EDGE_TO_ACTIVE) interrupt |= active_low ? GPIO_INT_EDGE_FALLING : GPIO_INT_EDGE_RISING;
+    if(flags & GPIO_INT_EDGE_TO_INACTIVE) interrupt |= active_low ? GPIO_INT_EDGE_RISING : GPIO_INT_EDGE_FALLING;
+    irq_lock();
+    _pins[spec->pin].interrupt = interrupt;
+    irq_unlock(0);
+    return 0;
+}
+
+int gpio_pin_get_dt(const struct gpio_dt_spec *spec)
+{
+    const bool active_low = (spec->dt_flags & GPIO_ACTIVE_LOW) != 0;
+    irq_lock();
+    const int level = _pins[spec->pin].level;
+    irq_unlock(0);
+    return active_low ? !level : level;
+}
+
+int gpio_pin_set_dt(const struct gpio_dt_spec *spec, int value)
+{
+    const bool active_low = ((spec->dt_flags | _pins[spec->pin].flags) & GPIO_ACTIVE_LOW) != 0;
+    const int level = active_low ? !value : (value != 0);
+    irq_lock();
+    _pins[spec->pin].level = level;
+    irq_unlock(0);
+    if(_gpio_output_hook != NULL) _gpio_output_hook(spec->pin, level);
+    return 0;
+}
+
+void zephyr_host_gpio_set_output_hook(void (*hook)(gpio_pin_t pin, int level))
+{
+    _gpio_output_hook = hook;
+}
+
+void zephyr_host_gpio_drive(gpio_pin_t pin, int level)
+{
+    irq_lock();
+    const int old = _pins[pin].level;
+    _pins[pin].level = (level != 0);
+    const gpio_flags_t edge = (old == _pins[pin].level) ? 0
+        : (_pins[pin].level ? GPIO_INT_EDGE_RISING : GPIO_INT_EDGE_FALLING);
+    if(edge & _pins[pin].interrupt)
+    {
+        /* The "ISR" runs with interrupts locked, a callback may remove itself. */
+        for(struct gpio_callback *cb = _gpio_callbacks; cb != NULL; cb = cb->next)
+        {
+            if(cb->pin_mask & BIT(pin)) cb->handler(&zephyr_host_device, cb, BIT(pin));
+        }
+    }
+    irq_unlock(0);
+}
+
+/* SPI */
+
+static struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool busy;
+    uint32_t frequency;
+    const struct spi_buf_set *tx;
+    const struct spi_buf_set *rx;
+    struct k_poll_signal *sig;
+}
+_spi = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+static pthread_once_t _spi_once = PTHREAD_ONCE_INIT;
+static void (*_spi_target)(const uint8_t *tx, uint8_t *rx, size_t length);
+
+void zephyr_host_spi_set_target(void (*transfer)(const uint8_t *tx, uint8_t *rx, size_t length))
+{
+    _spi_target = transfer;
+}
+
+/* Moves the bytes of both buffer sets through the target, one contiguous run at a time. */
+static void _spi_move(const struct spi_buf_set *tx, const struct spi_buf_set *rx)
+{
+    static uint8_t tx_bytes[65536], rx_bytes[65536];
+    size_t length = 0;
+    for(size_t i=0; tx != NULL && i<tx->count; i++)
+    {
+        memcpy(&tx_bytes[length], tx->buffers[i].buf, tx->buffers[i].len);
+        length += tx->buffers[i].len;
+    }
+    size_t rx_length = 0;
+    for(size_t i=0; rx != NULL && i<rx->count; i++) rx_length += rx->buffers[i].len;
+    if(rx_length > length)
+    {
+        memset(&tx_bytes[length], 0, rx_length - length);
+        length = rx_length;
+    }
+    if(_spi_target != NULL) _spi_target(tx_bytes, rx_bytes, length);
+    size_t offset = 0;
+    for(size_t i=0; rx != NULL && i<rx->count; i++)
+    {
+        if(rx->buffers[i].buf != NULL) memcpy(rx->buffers[i].buf, &rx_bytes[offset], rx->buffers[i].len);
+        offset += rx->buffers[i].len;
+    }
+}
+
+static size_t _spi_length(const struct spi_buf_set *tx, const struct spi_buf_set *rx)
+{
+    size_t tx_length = 0, rx_length = 0;
+    for(size_t i=0; tx != NULL && i<tx->count; i++) tx_length += tx->buffers[i].len;
+    for(size_t i=0; rx != NULL && i<rx->count; i++) rx_length += rx->buffers[i].len;
+    return tx_length > rx_length ? tx_length : rx_length;
+}
+
+/* The controller clocks the bytes by itself, like a DMA, the submitting thread is free meanwhile. */
+static void *_spi_thread(void *arg)
+{
+    (void) arg;
+    prctl(PR_SET_TIMERSLACK, 1UL);
+    pthread_mutex_lock(&_spi.mutex);
+    for(;;)
+    {
+        while(!_spi.busy) pthread_cond_wait(&_spi.cond, &_spi.mutex);
+        const uint64_t start = _now_ns();
+        const uint64_t wire_ns = (uint64_t) _spi_length(_spi.tx, _spi.rx) * 8 * 1000000000ULL / _spi.frequency;
+        pthread_mutex_unlock(&_spi.mutex);
+
+        const struct timespec deadline = _to_timespec(start + wire_ns);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR);
+
+        pthread_mutex_lock(&_spi.mutex);
+        _spi_move(_spi.tx, _spi.rx);
+        _spi.busy = false;
+        struct k_poll_signal *sig = _spi.sig;
+        pthread_mutex_unlock(&_spi.mutex);
+        k_poll_signal_raise(sig, 0);
+        pthread_mutex_lock(&_spi.mutex);
+    }
+    return NULL;
+}
+
+static void _spi_start(void)
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, _spi_thread, NULL);
+    pthread_detach(thread);
+}
+
+int spi_transceive_signal(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs, struct k_poll_signal *sig)
+{
+    (void) dev;
+    pthread_once(&_spi_once, _spi_start);
+    pthread_mutex_lock(&_spi.mutex);
+    if(_spi.busy)
+    {
+        pthread_mutex_unlock(&_spi.mutex);
+        return -EBUSY;
+    }
+    _spi.frequency = config->frequency;
+    _spi.tx = tx_bufs;
+    _spi.rx = rx_bufs;
+    _spi.sig = sig;
+    _spi.busy = true;
+    pthread_cond_signal(&_spi.cond);
+    pthread_mutex_unlock(&_spi.mutex);
+    return 0;
+}
+
+int spi_transceive(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+    static struct k_poll_signal sig = K_POLL_SIGNAL_INITIALIZER(sig);
+    struct k_poll_event event = K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &sig);
+    k_poll_signal_reset(&sig);
+    const int error = spi_transceive_signal(dev, config, tx_bufs, rx_bufs, &sig);
+    if(error != 0) return error;
+    return k_poll(&event, 1, K_FOREVER);
+}
+
+int spi_read(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *rx_bufs)
+{
+    return spi_transceive(dev, config, NULL, rx_bufs);
+}
+
+int spi_write(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs)
+{
+    return spi_transceive(dev, config, tx_bufs, NULL);
+}
+
+int spi_release(const struct device *dev, const struct spi_config *config)
+{
+    (void) dev;
+    (void) config;
+    return 0;
+}
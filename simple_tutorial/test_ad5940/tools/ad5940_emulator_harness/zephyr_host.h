@@ -0,0 +1,286 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Host stand-in of the Zephyr kernel, GPIO and SPI API used by the AD5940
+ * port files, so the emulator and the port run unchanged on Linux.
+ *
+ * @note
+ * - Threads are pthreads, the system workqueue is one thread running the
+ *   delayable works at their deadline.
+ * - A cycle is one nanosecond of CLOCK_MONOTONIC.
+ * - "ISRs" (GPIO callbacks) run in the thread that drives the pin.
+ * - The SPI controller is a thread: `spi_transceive_signal()` hands it the
+ *   transfer, it waits the wire time at the configured frequency, passes the
+ *   bytes to the target set by `zephyr_host_spi_set_target()` and raises the signal.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Devicetree of boards/app.overlay */
+#define ZEPHYR_HOST_PIN_ad5940_cs_gpios 4
+#define ZEPHYR_HOST_PIN_ad5940_gpio7_gpios 14
+#define ZEPHYR_HOST_PIN_ad5940_reset_gpios 18
+
+#define DT_PATH(node) node
+#define DT_NODELABEL(label) label
+#define DEVICE_DT_GET(node) (&zephyr_host_device)
+#define GPIO_DT_SPEC_GET(node, prop) { .port = &zephyr_host_device, .pin = ZEPHYR_HOST_PIN_##prop, .dt_flags = 0 }
+
+#define BIT(n) (1UL << (n))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define IS_ENABLED(option) 0
+
+#define printk printf
+
+/* Logging */
+#define LOG_MODULE_REGISTER(...)
+#define LOG_ERR(fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define LOG_WRN(fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define LOG_INF(fmt, ...) do { } while (0)
+#define LOG_DBG(fmt, ...) do { } while (0)
+
+/* Time */
+typedef struct
+{
+    int64_t ns;     /* < 0 forever */
+}
+k_timeout_t;
+
+#define K_FOREVER ((k_timeout_t) { .ns = -1 })
+#define K_NO_WAIT ((k_timeout_t) { .ns = 0 })
+#define K_NSEC(t) ((k_timeout_t) { .ns = (int64_t) (t) })
+#define K_USEC(t) K_NSEC((int64_t) (t) * 1000)
+#define K_MSEC(t) K_NSEC((int64_t) (t) * 1000000)
+
+uint32_t k_cycle_get_32(void);
+uint64_t k_cycle_get_64(void);
+#define k_cyc_to_us_floor32(cycles) ((uint32_t) ((cycles) / 1000U))
+
+int32_t k_sleep(k_timeout_t timeout);
+
+unsigned int irq_lock(void);
+void irq_unlock(unsigned int key);
+
+/* Atomic */
+typedef long atomic_t;
+typedef long atomic_val_t;
+
+#define atomic_get(target) __atomic_load_n((target), __ATOMIC_SEQ_CST)
+#define atomic_set(target, value) __atomic_exchange_n((target), (value), __ATOMIC_SEQ_CST)
+#define atomic_clear(target) atomic_set((target), 0)
+#define atomic_add(target, value) __atomic_fetch_add((target), (value), __ATOMIC_SEQ_CST)
+#define atomic_inc(target) atomic_add((target), 1)
+
+/* Mutex, recursive like k_mutex */
+struct k_mutex
+{
+    pthread_mutex_t mutex;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name = { .mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP }
+
+int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
+int k_mutex_unlock(struct k_mutex *mutex);
+
+/* Semaphore */
+struct k_sem
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned int count;
+    unsigned int limit;
+};
+
+#define K_SEM_DEFINE(name, initial_count, count_limit) struct k_sem name = { \
+    .mutex = PTHREAD_MUTEX_INITIALIZER, \
+    .cond = PTHREAD_COND_INITIALIZER, \
+    .count = (initial_count), \
+    .limit = (count_limit), \
+}
+
+int k_sem_init(struct k_sem *sem, unsigned int initial_count, unsigned int limit);
+void k_sem_give(struct k_sem *sem);
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+
+/* System workqueue */
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work
+{
+    k_work_handler_t handler;
+};
+
+struct k_work_delayable
+{
+    struct k_work work;
+    bool pending;
+    uint64_t deadline;
+    struct k_work_delayable *next;
+};
+
+#define K_WORK_DELAYABLE_DEFINE(name, work_handler) struct k_work_delayable name = { .work = { .handler = (work_handler) } }
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler);
+/** Does nothing if the work is already pending, like Zephyr. */
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_cancel_delayable(struct k_work_delayable *dwork);
+
+/* Poll signal */
+struct k_poll_signal
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned int signaled;
+    int result;
+};
+
+#define K_POLL_SIGNAL_INITIALIZER(obj) { \
+    .mutex = PTHREAD_MUTEX_INITIALIZER, \
+    .cond = PTHREAD_COND_INITIALIZER, \
+}
+
+#define K_POLL_TYPE_SIGNAL 1
+#define K_POLL_MODE_NOTIFY_ONLY 0
+
+struct k_poll_event
+{
+    struct k_poll_signal *signal;
+};
+
+#define K_POLL_EVENT_INITIALIZER(_event_type, _event_mode, _event_obj) { .signal = (_event_obj) }
+
+void k_poll_signal_reset(struct k_poll_signal *sig);
+void k_poll_signal_check(struct k_poll_signal *sig, unsigned int *signaled, int *result);
+int k_poll_signal_raise(struct k_poll_signal *sig, int result);
+/** Only one signal event is supported. */
+int k_poll(struct k_poll_event *events, int num_events, k_timeout_t timeout);
+
+/* Device */
+struct device
+{
+    const char *name;
+};
+
+extern const struct device zephyr_host_device;
+
+bool device_is_ready(const struct device *dev);
+
+/* GPIO */
+typedef uint32_t gpio_flags_t;
+typedef uint8_t gpio_pin_t;
+typedef uint16_t gpio_dt_flags_t;
+typedef uint32_t gpio_port_pins_t;
+
+#define GPIO_ACTIVE_LOW (1U << 0)
+#define GPIO_PULL_UP (1U << 4)
+#define GPIO_INPUT (1U << 16)
+#define GPIO_OUTPUT (1U << 17)
+
+#define GPIO_INT_DISABLE (1U << 21)
+#define GPIO_INT_EDGE_RISING (1U << 22)
+#define GPIO_INT_EDGE_FALLING (1U << 23)
+#define GPIO_INT_EDGE_BOTH (GPIO_INT_EDGE_RISING | GPIO_INT_EDGE_FALLING)
+/* Logical levels, active is the rising edge unless the pin is GPIO_ACTIVE_LOW. */
+#define GPIO_INT_EDGE_TO_ACTIVE (1U << 24)
+#define GPIO_INT_EDGE_TO_INACTIVE (1U << 25)
+
+struct gpio_dt_spec
+{
+    const struct device *port;
+    gpio_pin_t pin;
+    gpio_dt_flags_t dt_flags;
+};
+
+struct gpio_callback;
+typedef void (*gpio_callback_handler_t)(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins);
+
+struct gpio_callback
+{
+    struct gpio_callback *next;
+    gpio_callback_handler_t handler;
+    gpio_port_pins_t pin_mask;
+};
+
+void gpio_init_callback(struct gpio_callback *callback, gpio_callback_handler_t handler, gpio_port_pins_t pin_mask);
+int gpio_add_callback(const struct device *port, struct gpio_callback *callback);
+int gpio_pin_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t extra_flags);
+int gpio_pin_interrupt_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t flags);
+int gpio_pin_get_dt(const struct gpio_dt_spec *spec);
+int gpio_pin_set_dt(const struct gpio_dt_spec *spec, int value);
+
+/* SPI */
+#define SPI_OP_MODE_MASTER 0U
+#define SPI_TRANSFER_MSB 0U
+#define SPI_WORD_SET(word_size) ((uint32_t) (word_size) << 5)
+#define SPI_HOLD_ON_CS (1U << 12)
+#define SPI_LOCK_ON (1U << 13)
+
+struct spi_cs_control
+{
+    struct gpio_dt_spec gpio;
+    uint32_t delay;
+};
+
+struct spi_config
+{
+    uint32_t frequency;
+    uint32_t operation;
+    uint16_t slave;
+    struct spi_cs_control cs;
+};
+
+struct spi_buf
+{
+    void *buf;
+    size_t len;
+};
+
+struct spi_buf_set
+{
+    const struct spi_buf *buffers;
+    size_t count;
+};
+
+int spi_transceive_signal(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs, struct k_poll_signal *sig);
+int spi_transceive(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs);
+int spi_read(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *rx_bufs);
+int spi_write(const struct device *dev, const struct spi_config *config, const struct spi_buf_set *tx_bufs);
+int spi_release(const struct device *dev, const struct spi_config *config);
+
+/* Host side */
+
+/**
+ * @brief Sets the device behind the SPI controller, it gets the bytes of every transfer.
+ */
+void zephyr_host_spi_set_target(void (*transfer)(const uint8_t *tx, uint8_t *rx, size_t length));
+
+/**
+ * @brief Sets the function called when a GPIO output changes, e.g. a chip select.
+ */
+void zephyr_host_gpio_set_output_hook(void (*hook)(gpio_pin_t pin, int level));
+
+/**
+ * @brief Drives a GPIO input to a physical level, the callbacks of its enabled edge run in this thread.
+ */
+void zephyr_host_gpio_drive(gpio_pin_t pin, int level);
+
+/**
+ * @brief Thread CPU time in nanoseconds.
+ */
+uint64_t zephyr_host_thread_cpu_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
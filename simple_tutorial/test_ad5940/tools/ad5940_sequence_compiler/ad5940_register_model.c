@@ -0,0 +1,192 @@
+#include "ad5940_register_model.h"
+
+#include "ad5940.h"
+
+#include <string.h>
+
+typedef struct
+{
+    uint16_t RegAddr;
+    uint32_t RegData;
+}
+_REGISTER;
+
+/* Generated by generate.sh from the REG_xxx_RESET values of ad5940.h */
+static const _REGISTER _reset_values[] = {
+#include "ad5940_register_model_reset.inc"
+};
+
+#define REGISTER_MAX 256
+
+#define MODEL_CHIPID 0x5502 /* Silicon revision the library is tested with */
+
+static _REGISTER _registers[REGISTER_MAX];
+static uint32_t _registers_length;
+
+static uint32_t _SRAM[AD5940_REGISTER_MODEL_SRAM_SIZE];
+static uint32_t _SRAM_address;
+
+/* SPI frame state, one frame per CS window */
+static uint16_t _address;
+static BoolFlag _reset;
+
+static _REGISTER *_find(const uint16_t RegAddr)
+{
+    for(uint32_t i=0; i<_registers_length; i++)
+    {
+        if(_registers[i].RegAddr == RegAddr) return &_registers[i];
+    }
+    return NULL;
+}
+
+static uint32_t _get_reset_value(const uint16_t RegAddr)
+{
+    /* Identification registers read by AD5940_WakeUp() and AD5940_Initialize() */
+    if(RegAddr == REG_AFECON_ADIID) return AD5940_ADIID;
+    if(RegAddr == REG_AFECON_CHIPID) return MODEL_CHIPID;
+    for(uint32_t i=0; i<sizeof(_reset_values)/sizeof(_reset_values[0]); i++)
+    {
+        if(_reset_values[i].RegAddr == RegAddr) return _reset_values[i].RegData;
+    }
+    return 0;
+}
+
+void AD5940_REGISTER_MODEL_reset(void)
+{
+    _registers_length = 0;
+    memset(_SRAM, 0, sizeof(_SRAM));
+    _SRAM_address = 0;
+    return;
+}
+
+uint32_t AD5940_REGISTER_MODEL_read(const uint16_t RegAddr)
+{
+    const _REGISTER *reg = _find(RegAddr);
+    uint32_t RegData = (reg == NULL) ? _get_reset_value(RegAddr) : reg->RegData;
+
+    /* Status bits polled by the library are always ready */
+    switch (RegAddr)
+    {
+    case REG_ALLON_OSCCON:
+        RegData |= BITM_ALLON_OSCCON_HFXTALOK | BITM_ALLON_OSCCON_HFOSCOK | BITM_ALLON_OSCCON_LFOSCOK;
+        break;
+    default:
+        break;
+    }
+    return RegData;
+}
+
+void AD5940_REGISTER_MODEL_write(const uint16_t RegAddr, const uint32_t RegData)
+{
+    switch (RegAddr)
+    {
+    case REG_AFE_CMDFIFOWADDR:
+        _SRAM_address = RegData % AD5940_REGISTER_MODEL_SRAM_SIZE;
+        break;
+    case REG_AFE_CMDFIFOWRITE:
+        _SRAM[_SRAM_address] = RegData;
+        _SRAM_address = (_SRAM_address + 1) % AD5940_REGISTER_MODEL_SRAM_SIZE;
+        break;
+    default:
+        break;
+    }
+
+    _REGISTER *reg = _find(RegAddr);
+    if(reg == NULL)
+    {
+        if(_registers_length == REGISTER_MAX) return;
+        reg = &_registers[_registers_length++];
+        reg->RegAddr = RegAddr;
+    }
+    reg->RegData = RegData;
+    return;
+}
+
+const uint32_t *AD5940_REGISTER_MODEL_get_SRAM(void)
+{
+    return _SRAM;
+}
+
+// ==================================================
+// Port functions of the AD5940 library
+
+static BoolFlag _is_32bit_register(const uint16_t RegAddr)
+{
+    return ((RegAddr >= 0x1000) && (RegAddr <= 0x3014)) ? bTRUE : bFALSE;
+}
+
+void AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length)
+{
+    memset(pRecvBuff, 0, length);
+    if(length == 0) return;
+
+    const uint32_t size = _is_32bit_register(_address) ? 4 : 2;
+    uint32_t data = 0;
+    switch (pSendBuffer[0])
+    {
+    case SPICMD_SETADDR:
+        if(length >= 3) _address = ((uint16_t) pSendBuffer[1] << 8) | pSendBuffer[2];
+        break;
+    case SPICMD_WRITEREG:
+        if(length < 1 + size) break;
+        for(uint32_t i=0; i<size; i++) data = (data << 8) | pSendBuffer[1 + i];
+        AD5940_REGISTER_MODEL_write(_address, data);
+        break;
+    case SPICMD_READREG:
+        /* Command byte and one dummy byte before the data */
+        if(length < 2 + size) break;
+        data = AD5940_REGISTER_MODEL_read(_address);
+        for(uint32_t i=0; i<size; i++) pRecvBuff[2 + i] = data >> (8 * (size - 1 - i));
+        break;
+    default:
+        /* SPICMD_READFIFO returns an empty FIFO */
+        break;
+    }
+    return;
+}
+
+void AD5940_CsClr(void)
+{
+    return;
+}
+
+void AD5940_CsSet(void)
+{
+    return;
+}
+
+void AD5940_RstClr(void)
+{
+    _reset = bTRUE;
+    return;
+}
+
+void AD5940_RstSet(void)
+{
+    if(_reset == bTRUE) AD5940_REGISTER_MODEL_reset();
+    _reset = bFALSE;
+    return;
+}
+
+void AD5940_Delay10us(uint32_t time)
+{
+    (void) time;
+    return;
+}
+
+uint32_t AD5940_GetMCUIntFlag(void)
+{
+    /* Interrupts are not modeled, waiting for them would never end. */
+    return 1;
+}
+
+uint32_t AD5940_ClrMCUIntFlag(void)
+{
+    return 1;
+}
+
+uint32_t AD5940_MCUResourceInit(void *pCfg)
+{
+    (void) pCfg;
+    return 0;
+}
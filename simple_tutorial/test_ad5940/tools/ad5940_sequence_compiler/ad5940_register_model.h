@@ -0,0 +1,38 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/**
+ * Host model of the AD5940 register file behind the SPI port functions
+ * (`AD5940_ReadWriteNBytes()` and friends), so the library runs unchanged.
+ * 
+ * @note
+ * Registers start with the `REG_xxx_RESET` values of `ad5940.h`. Status bits
+ * are not modeled, every register returns the last value written, except the
+ * ready bits the library polls for.
+ */
+
+#define AD5940_REGISTER_MODEL_SRAM_SIZE 6144    /**< Words of the sequencer SRAM and data FIFO. */
+
+/**
+ * @brief Restores the reset values, called by `AD5940_RstSet()` after `AD5940_RstClr()`.
+ */
+void AD5940_REGISTER_MODEL_reset(void);
+
+uint32_t AD5940_REGISTER_MODEL_read(const uint16_t RegAddr);
+
+void AD5940_REGISTER_MODEL_write(const uint16_t RegAddr, const uint32_t RegData);
+
+/**
+ * @brief Returns the sequencer SRAM written by `CMDFIFOWADDR` and `CMDFIFOWRITE`.
+ */
+const uint32_t *AD5940_REGISTER_MODEL_get_SRAM(void);
+
+#ifdef __cplusplus
+}
+#endif
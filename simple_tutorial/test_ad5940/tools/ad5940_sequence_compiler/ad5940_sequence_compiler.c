@@ -0,0 +1,672 @@
+/**
+ * Offline compiler of the AD5940 ADC sequences.
+ *
+ * Runs the start functions of the temperature and electrochemical applications
+ * on the host against `ad5940_register_model.c`, with the fixed `UTL_AD5940_*`
+ * parameter sets, and prints the generated sequences as the C source of
+ * `src/ad5940/application/ad5940_compiled_sequences.c`.
+ *
+ * Every protocol is started after a reset and after every other protocol,
+ * because the generated commands depend on the register state left behind.
+ * Use generate.sh to build and run it.
+ *
+ * With `--timing`, every protocol is started once and its sequences, wakeup
+ * timer and FIFO configuration are read back from the register model and
+ * simulated by `ad5940_utility_sequence_timing.h`. Use timing.sh to run it.
+ */
+
+#include "ad5940.h"
+#include "ad5940_main.h"
+#include "ad5940_utility.h"
+#include "ad5940_external_components.h"
+#include "ad5940_compiled_sequences.h"
+
+#include "ad5940_temperature.h"
+#include "ad5940_electrochemical_CA.h"
+#include "ad5940_electrochemical_CV.h"
+#include "ad5940_electrochemical_DPV.h"
+#include "ad5940_electrochemical_SWV.h"
+#include "ad5940_electrochemical_LSV.h"
+
+#include "utl_ad5940_electrochemical_parameters.h"
+#include "utl_ad5940_temperature_parameters.h"
+
+#include "ad5940_register_model.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQUENCE_GENERATOR_BUFFER_SIZE 1000
+#define LFOSC_FREQUENCY 32000.0F    /* Nominal, only the wakeup timer depends on it. */
+#define COMPILED_MAX 32
+#define REGISTERS_MAX 8
+#define TIMING_DURATION 60.0F       /* Seconds simulated for every protocol. */
+
+/* No compiled sequence while compiling, the applications always generate them. */
+const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_temperature[1];
+const uint16_t AD5940_COMPILED_SEQUENCES_temperature_length = 0;
+const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_electrochemical_ADC[1];
+const uint16_t AD5940_COMPILED_SEQUENCES_electrochemical_ADC_length = 0;
+
+float AD5940_EXTERNAL_COMPONENTS_get_fRcal(void)
+{
+    return 10000.0F;
+}
+
+uint32_t AD5940_EXTERNAL_COMPONENTS_get_HSRTIA(void)
+{
+    return 0;
+}
+
+typedef struct
+{
+    uint32_t WaitClks;
+    AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER registers[REGISTERS_MAX];
+    uint16_t registers_length;
+    uint32_t commands[AD5940_UTILITY_SEQUENCE_MEMORY_SIZE];
+    uint16_t commands_length;
+}
+_COMPILED;
+
+typedef struct
+{
+    const char *name;
+    _COMPILED compiled[COMPILED_MAX];
+    uint16_t compiled_length;
+}
+_TABLE;
+
+static _TABLE _temperature = {.name = "temperature"};
+static _TABLE _electrochemical_ADC = {.name = "electrochemical_ADC"};
+
+static uint32_t _sequence_generator_buffer[SEQUENCE_GENERATOR_BUFFER_SIZE];
+static AD5940_UTILITY_ClockConfig _clock;
+
+// ==================================================
+// Parameter sets
+
+static const AGPIOCfg_Type _agpio_cfg = {0};
+
+static const AD5940_TEMPERATURE_ANALOG_CONFIG _temperature_analog = {
+    .ADCSinc2Osr = UTL_AD5940_TEMPERATURE_PARAMETERS_ADCSinc2Osr,
+    .ADCSinc3Osr = UTL_AD5940_TEMPERATURE_PARAMETERS_ADCSinc3Osr,
+    .ADCAvgNum = UTL_AD5940_TEMPERATURE_PARAMETERS_ADCAvgNum,
+    .ADCPga = UTL_AD5940_TEMPERATURE_PARAMETERS_ADCPga,
+    .DataType = UTL_AD5940_TEMPERATURE_PARAMETERS_DataType,
+    .FifoSrc = UTL_AD5940_TEMPERATURE_PARAMETERS_FifoSrc,
+    .BpNotch = UTL_AD5940_TEMPERATURE_PARAMETERS_BpNotch,
+    .BpSinc3 = UTL_AD5940_TEMPERATURE_PARAMETERS_BpSinc3,
+    .Sinc2NotchEnable = UTL_AD5940_TEMPERATURE_PARAMETERS_Sinc2NotchEnable,
+};
+
+static const AD5940_ELECTROCHEMICAL_UTILITY_AFERefCfg_Type _utility_AFERefCfg_Type;
+
+static const AD5940_ELECTROCHEMICAL_UTILITY_LPPACfg_Type _utility_LPPACfg_Type = {
+    .LpAmpPwrMod = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpAmpPwrMod,
+};
+
+static const AD5940_ELECTROCHEMICAL_UTILITY_LPTIACfg_Type _utility_LPTIACfg_Type = {
+    .LpTiaRtia = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpTiaRtia,
+    .LpTiaRf = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpTiaRf,
+    .LpTiaRload = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_LpTiaRload,
+};
+
+static const AD5940_ELECTROCHEMICAL_UTILITY_HSTIACfg_Type _utility_HSTIACfg_Type = {
+    .HstiaRtiaSel = HSTIARTIA_10K,
+    .ExtRtia = 0,
+    .HstiaCtia = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_HstiaCtia,
+    .DiodeClose = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DiodeClose,
+    .HstiaDeRtia = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_HstiaDeRtia,
+    .HstiaDeRload = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_HstiaDeRload,
+};
+
+static AD5940_ELECTROCHEMICAL_UTILITY_DSPCfg_Type _utility_DSPCfg_Type = {
+    .ADCPga = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCPga,
+    .ADCFilterCfg = {
+        .ADCSinc3Osr = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCSinc3Osr,
+        .ADCSinc2Osr = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCSinc2Osr,
+        .ADCAvgNum = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_ADCAvgNum,
+        .BpNotch = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_BpNotch,
+        .BpSinc3 = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_BpSinc3,
+        .Sinc2NotchEnable = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_Sinc2NotchEnable,
+    },
+    .DftCfg = {
+        .DftNum = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DftNum,
+        .DftSrc = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DftSrc,
+        .HanWinEn = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_HanWinEn,
+    },
+};
+
+/* Potentials and timings don't change the ADC sequence. Keep the potentials within the LPDAC range and the
+   step interval above the sample delay of the wakeup timer, --timing simulates them. */
+static const AD5940_ELECTROCHEMICAL_CA_PARAMETERS _CA_parameters = {
+    .E_dc = 0,
+    .t_interval = 100,
+    .t_run = 1000,
+};
+
+static const AD5940_ELECTROCHEMICAL_CV_PARAMETERS _CV_parameters = {
+    .E_begin = 0,
+    .E_vertex1 = 1,
+    .E_vertex2 = -1,
+    .E_step = 1,
+    .scan_rate = 10,
+};
+
+static const AD5940_ELECTROCHEMICAL_DPV_PARAMETERS _DPV_parameters = {
+    .E_begin = 0,
+    .E_end = 1,
+    .E_step = 1,
+    .E_pulse = 1,
+    .t_pulse = 50,
+    .scan_rate = 10,
+    .inversion_option = AD5940_ELECTROCHEMICAL_DPV_INVERSION_OPTION_INVERT_NONE,
+};
+
+static const AD5940_ELECTROCHEMICAL_SWV_PARAMETERS _SWV_parameters = {
+    .E_begin = 0,
+    .E_end = 1,
+    .E_step = 1,
+    .E_amplitude = 0,
+    .frequency = 10,
+};
+
+static const AD5940_ELECTROCHEMICAL_LSV_PARAMETERS _LSV_parameters = {
+    .E_begin = 0,
+    .E_end = 1,
+    .E_step = 1,
+    .scan_rate = 10,
+};
+
+// ==================================================
+// Protocols
+
+/* Keep the ClksCalInfo_Type in sync with _write_temperature_sequence_commands() */
+static uint32_t _get_temperature_WaitClks(void)
+{
+    ClksCalInfo_Type clks_cal;
+    uint32_t WaitClks;
+    memset(&clks_cal, 0, sizeof(clks_cal));
+    clks_cal.DataType = _temperature_analog.DataType;
+    clks_cal.DataCount = 1;
+    clks_cal.ADCSinc2Osr = _temperature_analog.ADCSinc2Osr;
+    clks_cal.ADCSinc3Osr = _temperature_analog.ADCSinc3Osr;
+    clks_cal.ADCAvgNum = _temperature_analog.ADCAvgNum;
+    clks_cal.RatioSys2AdcClk = _clock.RatioSys2AdcClk;
+    AD5940_ClksCalculate(&clks_cal, &WaitClks);
+    return WaitClks;
+}
+
+/* Keep the ClksCalInfo_Type in sync with _get_ClksCalInfo_Type() in ad5940_electrochemical_utility_sop.c */
+static uint32_t _get_electrochemical_WaitClks(void)
+{
+    ClksCalInfo_Type clks_cal;
+    uint32_t WaitClks;
+    memset(&clks_cal, 0, sizeof(clks_cal));
+    clks_cal.ADCAvgNum = _utility_DSPCfg_Type.ADCFilterCfg.ADCAvgNum;
+    clks_cal.ADCSinc2Osr = _utility_DSPCfg_Type.ADCFilterCfg.ADCSinc2Osr;
+    clks_cal.ADCSinc3Osr = _utility_DSPCfg_Type.ADCFilterCfg.ADCSinc3Osr;
+    clks_cal.DataType = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DataType;
+    clks_cal.DataCount = AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count(&_utility_DSPCfg_Type.StatCfg);
+    clks_cal.DftSrc = _utility_DSPCfg_Type.DftCfg.DftSrc;
+    clks_cal.RatioSys2AdcClk = _clock.RatioSys2AdcClk;
+    AD5940_ClksCalculate(&clks_cal, &WaitClks);
+    return WaitClks;
+}
+
+static AD5940Err _start_temperature(void)
+{
+    const AD5940_TEMPERATURE_START_CONFIG config = {
+        .FIFO_thresh = UTL_AD5940_TEMPERATURE_PARAMETERS_FIFO_thresh,
+        .ADC_sample_interval = UTL_AD5940_TEMPERATURE_PARAMETERS_ADC_sample_interval,
+        .LFOSC_frequency = LFOSC_FREQUENCY,
+        .clock = &_clock,
+        .agpio_cfg = &_agpio_cfg,
+        .analog = &_temperature_analog,
+        .TEMPSENS = UTL_AD5940_TEMPERATURE_PARAMETERS_TEMPSENS,
+    };
+    return AD5940_TEMPERATURE_start(&config);
+}
+
+#define ELECTROCHEMICAL_CONFIG_COMMON \
+    .LFOSC_frequency = LFOSC_FREQUENCY, \
+    .clock = &_clock, \
+    .agpio_cfg = &_agpio_cfg, \
+    .utility_AFERefCfg_Type = &_utility_AFERefCfg_Type, \
+    .utility_LPPACfg_Type = &_utility_LPPACfg_Type, \
+    .utility_DSPCfg_Type = &_utility_DSPCfg_Type, \
+    .DataType = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_DataType, \
+    .FifoSrc = UTL_AD5940_ELECTROCHEMICAL_PARAMETERS_FifoSrc
+
+static AD5940Err _start_CA(void)
+{
+    const AD5940_ELECTROCHEMICAL_CA_CONFIG config = {
+        .working_electrode = AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        .parameters = &_CA_parameters,
+        .utility_HSTIACfg_Type = &_utility_HSTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_CA_start(&config);
+}
+
+static AD5940Err _start_CA_with_LPTIA(void)
+{
+    const AD5940_ELECTROCHEMICAL_CA_LPTIA_CONFIG config = {
+        .parameters = &_CA_parameters,
+        .utility_LPTIACfg_Type = &_utility_LPTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_CA_start_with_LPTIA(&config);
+}
+
+static AD5940Err _start_CV(void)
+{
+    const AD5940_ELECTROCHEMICAL_CV_CONFIG config = {
+        .working_electrode = AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        .parameters = &_CV_parameters,
+        .utility_HSTIACfg_Type = &_utility_HSTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_CV_start(&config);
+}
+
+static AD5940Err _start_CV_with_LPTIA(void)
+{
+    const AD5940_ELECTROCHEMICAL_CV_LPTIA_CONFIG config = {
+        .parameters = &_CV_parameters,
+        .utility_LPTIACfg_Type = &_utility_LPTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_CV_start_with_LPTIA(&config);
+}
+
+static AD5940Err _start_DPV(void)
+{
+    const AD5940_ELECTROCHEMICAL_DPV_CONFIG config = {
+        .working_electrode = AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        .parameters = &_DPV_parameters,
+        .utility_HSTIACfg_Type = &_utility_HSTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_DPV_start(&config);
+}
+
+static AD5940Err _start_DPV_with_LPTIA(void)
+{
+    const AD5940_ELECTROCHEMICAL_DPV_LPTIA_CONFIG config = {
+        .parameters = &_DPV_parameters,
+        .utility_LPTIACfg_Type = &_utility_LPTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_DPV_start_with_LPTIA(&config);
+}
+
+static AD5940Err _start_SWV(void)
+{
+    const AD5940_ELECTROCHEMICAL_SWV_CONFIG config = {
+        .working_electrode = AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        .parameters = &_SWV_parameters,
+        .utility_HSTIACfg_Type = &_utility_HSTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_SWV_start(&config);
+}
+
+static AD5940Err _start_SWV_with_LPTIA(void)
+{
+    const AD5940_ELECTROCHEMICAL_SWV_LPTIA_CONFIG config = {
+        .parameters = &_SWV_parameters,
+        .utility_LPTIACfg_Type = &_utility_LPTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_SWV_start_with_LPTIA(&config);
+}
+
+static AD5940Err _start_LSV(void)
+{
+    const AD5940_ELECTROCHEMICAL_LSV_CONFIG config = {
+        .working_electrode = AD5940_ELECTROCHEMICAL_WORKING_ELECTRODE_SE0,
+        .parameters = &_LSV_parameters,
+        .utility_HSTIACfg_Type = &_utility_HSTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_LSV_start(&config);
+}
+
+static AD5940Err _start_LSV_with_LPTIA(void)
+{
+    const AD5940_ELECTROCHEMICAL_LSV_LPTIA_CONFIG config = {
+        .parameters = &_LSV_parameters,
+        .utility_LPTIACfg_Type = &_utility_LPTIACfg_Type,
+        ELECTROCHEMICAL_CONFIG_COMMON,
+    };
+    return AD5940_ELECTROCHEMICAL_LSV_start_with_LPTIA(&config);
+}
+
+typedef struct
+{
+    const char *name;
+    AD5940Err (*start)(void);
+    uint32_t (*get_WaitClks)(void);
+    _TABLE *table;
+}
+_PROTOCOL;
+
+static const _PROTOCOL _protocols[] = {
+    {"temperature", _start_temperature, _get_temperature_WaitClks, &_temperature},
+    {"CA", _start_CA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"CA_with_LPTIA", _start_CA_with_LPTIA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"CV", _start_CV, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"CV_with_LPTIA", _start_CV_with_LPTIA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"DPV", _start_DPV, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"DPV_with_LPTIA", _start_DPV_with_LPTIA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"SWV", _start_SWV, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"SWV_with_LPTIA", _start_SWV_with_LPTIA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"LSV", _start_LSV, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+    {"LSV_with_LPTIA", _start_LSV_with_LPTIA, _get_electrochemical_WaitClks, &_electrochemical_ADC},
+};
+#define PROTOCOL_NUMBER (sizeof(_protocols) / sizeof(_protocols[0]))
+
+// ==================================================
+// Compile
+
+static _COMPILED _current;
+
+static void _record_default(uint16_t RegAddr, uint32_t RegData)
+{
+    for(uint16_t i=0; i<_current.registers_length; i++)
+    {
+        if(_current.registers[i].RegAddr == RegAddr) return;
+    }
+    if(_current.registers_length == REGISTERS_MAX)
+    {
+        fprintf(stderr, "too many register defaults, raise REGISTERS_MAX\n");
+        exit(EXIT_FAILURE);
+    }
+    _current.registers[_current.registers_length].RegAddr = RegAddr;
+    _current.registers[_current.registers_length].RegData = RegData;
+    _current.registers_length++;
+    return;
+}
+
+static void _reset(void)
+{
+    AD5940Err error = AD5940_MAIN_reset();
+    if(error == AD5940ERR_OK) error = AD5940_UTILITY_set_active_power(AFEPWR_LP, 0x00, &_clock);
+    if(error != AD5940ERR_OK)
+    {
+        fprintf(stderr, "reset failed: %d\n", error);
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+static void _run(const _PROTOCOL *const protocol)
+{
+    AD5940Err error = protocol->start();
+    if(error == AD5940ERR_OK) error = AD5940_UTILITY_shutdown();
+    if(error != AD5940ERR_OK)
+    {
+        fprintf(stderr, "%s failed: %d\n", protocol->name, error);
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+static void _compile(const _PROTOCOL *const protocol)
+{
+    memset(&_current, 0, sizeof(_current));
+    AD5940_SEQGenDefaultHook(_record_default);
+    _run(protocol);
+    AD5940_SEQGenDefaultHook(NULL);
+
+    /* Both applications run the ADC sequence with SEQID_0. */
+    const uint32_t seq_info = AD5940_REGISTER_MODEL_read(REG_AFE_SEQ0INFO);
+    const uint32_t address = (seq_info & BITM_AFE_SEQ0INFO_ADDR) >> BITP_AFE_SEQ0INFO_ADDR;
+    const uint32_t length = (seq_info & BITM_AFE_SEQ0INFO_LEN) >> BITP_AFE_SEQ0INFO_LEN;
+    if(length == 0 || address + length > AD5940_UTILITY_SEQUENCE_MEMORY_SIZE)
+    {
+        fprintf(stderr, "%s: no sequence in SEQ0INFO (0x%08x)\n", protocol->name, seq_info);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(_current.commands, AD5940_REGISTER_MODEL_get_SRAM() + address, length * sizeof(uint32_t));
+    _current.commands_length = length;
+    _current.WaitClks = protocol->get_WaitClks();
+
+    _TABLE *const table = protocol->table;
+    for(uint16_t i=0; i<table->compiled_length; i++)
+    {
+        if(memcmp(&table->compiled[i], &_current, sizeof(_current)) == 0) return;
+    }
+    if(table->compiled_length == COMPILED_MAX)
+    {
+        fprintf(stderr, "too many %s sequences, raise COMPILED_MAX\n", table->name);
+        exit(EXIT_FAILURE);
+    }
+    table->compiled[table->compiled_length++] = _current;
+    return;
+}
+
+static void _print_table(const _TABLE *const table)
+{
+    if(table->compiled_length == 0)
+    {
+        fprintf(stderr, "no %s sequence compiled\n", table->name);
+        exit(EXIT_FAILURE);
+    }
+
+    for(uint16_t i=0; i<table->compiled_length; i++)
+    {
+        const _COMPILED *const compiled = &table->compiled[i];
+        printf("static const AD5940_UTILITY_COMPILED_SEQUENCE_REGISTER _%s_%u_registers[] = {\n", table->name, i);
+        for(uint16_t j=0; j<compiled->registers_length; j++)
+        {
+            printf("    {0x%04X, 0x%08X},\n", compiled->registers[j].RegAddr, compiled->registers[j].RegData);
+        }
+        printf("};\n\n");
+        printf("static const uint32_t _%s_%u_commands[] = {\n", table->name, i);
+        for(uint16_t j=0; j<compiled->commands_length; j++)
+        {
+            printf("    0x%08X,\n", compiled->commands[j]);
+        }
+        printf("};\n\n");
+    }
+
+    printf("const AD5940_UTILITY_COMPILED_SEQUENCE AD5940_COMPILED_SEQUENCES_%s[] = {\n", table->name);
+    for(uint16_t i=0; i<table->compiled_length; i++)
+    {
+        printf("    {\n");
+        printf("        .WaitClks = %u,\n", table->compiled[i].WaitClks);
+        printf("        .registers = _%s_%u_registers,\n", table->name, i);
+        printf("        .registers_length = sizeof(_%s_%u_registers) / sizeof(_%s_%u_registers[0]),\n", table->name, i, table->name, i);
+        printf("        .commands = _%s_%u_commands,\n", table->name, i);
+        printf("        .commands_length = sizeof(_%s_%u_commands) / sizeof(_%s_%u_commands[0]),\n", table->name, i, table->name, i);
+        printf("    },\n");
+    }
+    printf("};\n");
+    printf("const uint16_t AD5940_COMPILED_SEQUENCES_%s_length = sizeof(AD5940_COMPILED_SEQUENCES_%s) / sizeof(AD5940_COMPILED_SEQUENCES_%s[0]);\n\n",
+        table->name, table->name, table->name);
+    return;
+}
+
+// ==================================================
+// Timing
+
+static uint32_t _read_WUPT_time(const uint16_t RegAddrL, const uint16_t RegAddrH)
+{
+    return (AD5940_REGISTER_MODEL_read(RegAddrL) & 0xFFFF) | ((AD5940_REGISTER_MODEL_read(RegAddrH) & 0xF) << 16);
+}
+
+/**
+ * @brief Reads the configuration written by the start function back from the register model.
+ */
+static void _get_timing_config(AD5940_UTILITY_SEQUENCE_TIMING_CONFIG *const config, const float MCU_latency)
+{
+    static const uint16_t seq_info[4] = {REG_AFE_SEQ0INFO, REG_AFE_SEQ1INFO, REG_AFE_SEQ2INFO, REG_AFE_SEQ3INFO};
+    static const uint16_t wakeup[4][2] = {
+        {REG_WUPTMR_SEQ0WUPL, REG_WUPTMR_SEQ0WUPH},
+        {REG_WUPTMR_SEQ1WUPL, REG_WUPTMR_SEQ1WUPH},
+        {REG_WUPTMR_SEQ2WUPL, REG_WUPTMR_SEQ2WUPH},
+        {REG_WUPTMR_SEQ3WUPL, REG_WUPTMR_SEQ3WUPH},
+    };
+    static const uint16_t sleep[4][2] = {
+        {REG_WUPTMR_SEQ0SLEEPL, REG_WUPTMR_SEQ0SLEEPH},
+        {REG_WUPTMR_SEQ1SLEEPL, REG_WUPTMR_SEQ1SLEEPH},
+        {REG_WUPTMR_SEQ2SLEEPL, REG_WUPTMR_SEQ2SLEEPH},
+        {REG_WUPTMR_SEQ3SLEEPL, REG_WUPTMR_SEQ3SLEEPH},
+    };
+    memset(config, 0, sizeof(AD5940_UTILITY_SEQUENCE_TIMING_CONFIG));
+
+    for(uint8_t i=0; i<4; i++)
+    {
+        /* Same bit positions in SEQ0INFO to SEQ3INFO */
+        const uint32_t info = AD5940_REGISTER_MODEL_read(seq_info[i]);
+        const uint32_t address = (info & BITM_AFE_SEQ0INFO_ADDR) >> BITP_AFE_SEQ0INFO_ADDR;
+        const uint32_t length = (info & BITM_AFE_SEQ0INFO_LEN) >> BITP_AFE_SEQ0INFO_LEN;
+        if(length != 0 && address + length <= AD5940_UTILITY_SEQUENCE_MEMORY_SIZE)
+        {
+            config->sequences[i].commands = AD5940_REGISTER_MODEL_get_SRAM() + address;
+            config->sequences[i].commands_length = length;
+        }
+        config->wupt.SeqxWakeupTime[i] = _read_WUPT_time(wakeup[i][0], wakeup[i][1]);
+        config->wupt.SeqxSleepTime[i] = _read_WUPT_time(sleep[i][0], sleep[i][1]);
+    }
+    const uint32_t order = AD5940_REGISTER_MODEL_read(REG_WUPTMR_SEQORDER);
+    for(uint8_t i=0; i<8; i++)
+    {
+        config->wupt.WuptOrder[i] = (order >> (BITP_WUPTMR_SEQORDER_SEQA + 2 * i)) & 0x03;
+    }
+    const uint32_t con = AD5940_REGISTER_MODEL_read(REG_WUPTMR_CON);
+    config->wupt.WuptEndSeq = (con & BITM_WUPTMR_CON_ENDSEQ) >> BITP_WUPTMR_CON_ENDSEQ;
+    config->wupt.WuptEn = (con & BITM_WUPTMR_CON_EN) ? bTRUE : bFALSE;
+
+    const uint32_t filter = AD5940_REGISTER_MODEL_read(REG_AFE_ADCFILTERCON);
+    config->clks_cal.ADCSinc3Osr = (filter & BITM_AFE_ADCFILTERCON_SINC3OSR) >> BITP_AFE_ADCFILTERCON_SINC3OSR;
+    config->clks_cal.ADCSinc2Osr = (filter & BITM_AFE_ADCFILTERCON_SINC2OSR) >> BITP_AFE_ADCFILTERCON_SINC2OSR;
+    config->clks_cal.ADCAvgNum = (filter & BITM_AFE_ADCFILTERCON_AVRGNUM) >> BITP_AFE_ADCFILTERCON_AVRGNUM;
+    config->clks_cal.ADCRate = (filter & BITM_AFE_ADCFILTERCON_ADCCLK) >> BITP_AFE_ADCFILTERCON_ADCCLK;
+    config->clks_cal.BpNotch = (filter & BITM_AFE_ADCFILTERCON_LPFBYPEN) ? bTRUE : bFALSE;
+    if(filter & BITM_AFE_ADCFILTERCON_AVRGEN) config->clks_cal.DftSrc = DFTSRC_AVG;
+    else config->clks_cal.DftSrc = (AD5940_REGISTER_MODEL_read(REG_AFE_DFTCON) & BITM_AFE_DFTCON_DFTINSEL) >> BITP_AFE_DFTCON_DFTINSEL;
+    config->clks_cal.RatioSys2AdcClk = _clock.RatioSys2AdcClk;
+
+    switch ((AD5940_REGISTER_MODEL_read(REG_AFE_FIFOCON) & BITM_AFE_FIFOCON_DATAFIFOSRCSEL) >> BITP_AFE_FIFOCON_DATAFIFOSRCSEL)
+    {
+    case FIFOSRC_DFT:
+        config->clks_cal.DataType = DATATYPE_DFT;
+        break;
+    case FIFOSRC_SINC2NOTCH:
+        config->clks_cal.DataType = config->clks_cal.BpNotch ? DATATYPE_SINC2 : DATATYPE_NOTCH;
+        break;
+    case FIFOSRC_MEAN:
+    case FIFOSRC_VAR:
+    {
+        /* The statistics block averages SINC2 (+Notch) data. */
+        const uint32_t statistics = AD5940_REGISTER_MODEL_read(REG_AFE_STATSCON);
+        const StatCfg_Type stat_cfg = {
+            .StatEnable = (statistics & BITM_AFE_STATSCON_STATSEN) ? bTRUE : bFALSE,
+            .StatSample = (statistics & BITM_AFE_STATSCON_SAMPLENUM) >> BITP_AFE_STATSCON_SAMPLENUM,
+        };
+        config->clks_cal.DataType = config->clks_cal.BpNotch ? DATATYPE_SINC2 : DATATYPE_NOTCH;
+        config->statistics_samples = AD5940_ELECTROCHEMICAL_UTILITY_get_ADC_data_count(&stat_cfg);
+        break;
+    }
+    default:
+        config->clks_cal.DataType = DATATYPE_SINC3;
+        break;
+    }
+
+    config->LFOSC_frequency = LFOSC_FREQUENCY;
+    config->SysClk_frequency = _clock.SysClkFreq;
+    config->FIFO_size = AD5940_ELECTROCHEMICAL_UTILITY_DATA_FIFO_SIZE;
+    config->MCU_latency = MCU_latency;
+    return;
+}
+
+static void _timing(const _PROTOCOL *const protocol, const float interrupt_rate, const float MCU_latency)
+{
+    AD5940_UTILITY_SEQUENCE_TIMING_CONFIG config;
+    AD5940_UTILITY_SEQUENCE_TIMING_RESULT result;
+    uint32_t recommended;
+
+    _reset();
+    AD5940Err error = protocol->start();
+    if(error != AD5940ERR_OK)
+    {
+        fprintf(stderr, "%s failed: %d\n", protocol->name, error);
+        exit(EXIT_FAILURE);
+    }
+    _get_timing_config(&config, MCU_latency);
+    const uint32_t FIFO_thresh = AD5940_REGISTER_MODEL_read(REG_AFE_DATAFIFOTHRES) >> BITP_AFE_DATAFIFOTHRES_HIGHTHRES;
+
+    error = AD5940_UTILITY_sequence_timing_simulate(&config, FIFO_thresh, TIMING_DURATION, &result);
+    if(error == AD5940ERR_OK) error = AD5940_UTILITY_sequence_timing_recommend_FIFO_thresh(&config, interrupt_rate, TIMING_DURATION, &recommended);
+    if(error != AD5940ERR_OK)
+    {
+        printf("%s: simulation failed: %d\n\n", protocol->name, error);
+        AD5940_UTILITY_shutdown();
+        return;
+    }
+
+    printf("%s\n", protocol->name);
+    for(uint8_t i=0; i<4; i++)
+    {
+        if(config.sequences[i].commands == NULL) continue;
+        printf("  SEQ%u: %3u commands, %8u cycles (%9.1f us), %u data per run\n",
+            i, config.sequences[i].commands_length, result.run_cycles[i],
+            result.run_cycles[i] * 1E6F / config.SysClk_frequency, result.samples[i]);
+    }
+    printf("  round %.1f ms, %.2f data/s%s\n",
+        result.round_time * 1E3F, result.sample_rate, result.overrun ? ", OVERRUN: a sequence is longer than its slot" : "");
+    printf("  FIFO threshold %u: %.3f interrupts/s, max %u words, %u lost\n",
+        FIFO_thresh, result.interrupt_rate, result.FIFO_max, result.FIFO_overflow);
+    printf("  recommended FIFO threshold for >= %.3f interrupts/s: %u\n\n", interrupt_rate, recommended);
+
+    AD5940_UTILITY_shutdown();
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    AD5940Err error = AD5940_MAIN_init(
+        _sequence_generator_buffer,
+        SEQUENCE_GENERATOR_BUFFER_SIZE
+    );
+    if(error != AD5940ERR_OK)
+    {
+        fprintf(stderr, "init failed: %d\n", error);
+        return EXIT_FAILURE;
+    }
+
+    if(argc > 1 && strcmp(argv[1], "--timing") == 0)
+    {
+        const float interrupt_rate = (argc > 2) ? strtof(argv[2], NULL) : 1.0F;
+        const float MCU_latency = (argc > 3) ? strtof(argv[3], NULL) * 1E-3F : 0.005F;
+        printf("%.0f s simulated, MCU reads the FIFO %.1f ms after the interrupt\n\n", TIMING_DURATION, MCU_latency * 1E3F);
+        for(size_t i=0; i<PROTOCOL_NUMBER; i++)
+        {
+            _timing(&_protocols[i], interrupt_rate, MCU_latency);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    /* Every protocol after reset, then after every other protocol. */
+    for(size_t i=0; i<PROTOCOL_NUMBER; i++)
+    {
+        _reset();
+        _compile(&_protocols[i]);
+        for(size_t j=0; j<PROTOCOL_NUMBER; j++)
+        {
+            _reset();
+            _run(&_protocols[j]);
+            _compile(&_protocols[i]);
+        }
+    }
+
+    printf("/* Generated by tools/ad5940_sequence_compiler/generate.sh, do not edit. */\n\n");
+    printf("#include \"ad5940_compiled_sequences.h\"\n\n");
+    _print_table(&_temperature);
+    _print_table(&_electrochemical_ADC);
+    return EXIT_SUCCESS;
+}
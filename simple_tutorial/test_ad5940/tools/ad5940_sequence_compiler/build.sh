@@ -0,0 +1,34 @@
+#!/bin/sh
+# Builds the host binary shared by generate.sh and timing.sh.
+#
+#     ./build.sh OUTPUT
+#
+# Needs a host C compiler (CC, default cc).
+
+set -e
+
+TOOL_DIR=$(cd "$(dirname "$0")" && pwd)
+AD5940_DIR=$TOOL_DIR/../../src/ad5940
+PARAMETERS_DIR=$TOOL_DIR/../../../../electrochemical_tester_with_bluetooth/src/application
+OUTPUT=$1
+CC=${CC:-cc}
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+# Reset values of the register model
+sed -n 's/^#define \(REG_[A-Z0-9_]*\)_RESET .*/    {\1, \1_RESET},/p' \
+    "$AD5940_DIR/library/ad5940.h" > "$BUILD_DIR/ad5940_register_model_reset.inc"
+
+INCLUDES=""
+for dir in $(find "$AD5940_DIR" -type d); do
+    INCLUDES="$INCLUDES -I$dir"
+done
+
+SOURCES=$(find "$AD5940_DIR" -name '*.c' ! -name 'ad5940_compiled_sequences.c')
+
+# shellcheck disable=SC2086
+"$CC" -std=gnu11 -O1 -Wall -Wextra -DCHIPSEL_594X \
+    -I"$BUILD_DIR" -I"$TOOL_DIR" -I"$PARAMETERS_DIR" $INCLUDES \
+    "$TOOL_DIR/ad5940_sequence_compiler.c" "$TOOL_DIR/ad5940_register_model.c" $SOURCES \
+    -lm -o "$OUTPUT"
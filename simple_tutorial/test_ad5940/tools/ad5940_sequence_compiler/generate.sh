@@ -0,0 +1,21 @@
+#!/bin/sh
+# Compiles the AD5940 ADC sequences of the UTL_AD5940_* parameter sets on the
+# host and regenerates src/ad5940/application/ad5940_compiled_sequences.c.
+#
+#     ./generate.sh
+#
+# Needs a host C compiler (CC, default cc). Run it after changing the
+# parameter sets or the sequence generators and commit the result.
+
+set -e
+
+TOOL_DIR=$(cd "$(dirname "$0")" && pwd)
+OUTPUT=$TOOL_DIR/../../src/ad5940/application/ad5940_compiled_sequences.c
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+"$TOOL_DIR/build.sh" "$BUILD_DIR/ad5940_sequence_compiler"
+"$BUILD_DIR/ad5940_sequence_compiler" > "$BUILD_DIR/ad5940_compiled_sequences.c"
+mv "$BUILD_DIR/ad5940_compiled_sequences.c" "$OUTPUT"
+echo "Generated $OUTPUT"
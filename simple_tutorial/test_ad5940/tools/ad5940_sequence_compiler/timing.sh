@@ -0,0 +1,19 @@
+#!/bin/sh
+# Simulates the sequencer timing and the data FIFO of every protocol with the
+# UTL_AD5940_* parameter sets, and recommends FIFO thresholds.
+#
+#     ./timing.sh [INTERRUPTS_PER_SECOND [MCU_LATENCY_MS]]
+#
+# INTERRUPTS_PER_SECOND is the lowest FIFO interrupt rate MCU accepts
+# (default 1), MCU_LATENCY_MS the time from the interrupt to the FIFO read
+# (default 5).
+
+set -e
+
+TOOL_DIR=$(cd "$(dirname "$0")" && pwd)
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+"$TOOL_DIR/build.sh" "$BUILD_DIR/ad5940_sequence_compiler"
+"$BUILD_DIR/ad5940_sequence_compiler" --timing "$@"
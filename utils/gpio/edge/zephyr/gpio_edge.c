@@ -0,0 +1,53 @@
+#include "gpio_edge.h"
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(zephyr_gpio_edge_interrupt, LOG_LEVEL_INF);
+
+static void _gpio_isr(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+    gpio_edge_ctx_t *ctx = CONTAINER_OF(cb, gpio_edge_ctx_t, gpio_cb);
+    ctx->edge_callback();
+}
+
+int z_impl_gpio_edge_init(gpio_edge_ctx_t *ctx,
+                       const struct gpio_dt_spec *gpio_dt,
+                       const gpio_flags_t gpio_flag,
+                       const gpio_flags_t interrupt_flag,
+                       void (*edge_callback)(void)
+                    )
+{
+    int ret;
+
+    if (!device_is_ready(gpio_dt->port)) {
+        LOG_ERR("GPIO device not ready");
+        return -ENODEV;
+    }
+
+    if (edge_callback == NULL) {
+        return -EINVAL;
+    }
+
+    ret = gpio_pin_configure_dt(gpio_dt, gpio_flag);
+    if (ret < 0) {
+        LOG_ERR("Failed to configure GPIO");
+        return ret;
+    }
+
+    ctx->gpio_dt = gpio_dt;
+    ctx->edge_callback = edge_callback;
+
+    gpio_init_callback(&ctx->gpio_cb, _gpio_isr, BIT(gpio_dt->pin));
+    ret = gpio_add_callback(gpio_dt->port, &ctx->gpio_cb);
+    if (ret < 0) {
+        LOG_ERR("Failed to add GPIO callback");
+        return ret;
+    }
+
+    LOG_INF("GPIO edge context initialized");
+
+    return gpio_pin_interrupt_configure_dt(gpio_dt, interrupt_flag);
+}
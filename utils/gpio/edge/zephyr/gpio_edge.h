@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Context structure for GPIO edge interrupt handling.
+ *
+ * **Users do not need to manually initialize or modify the members inside.**
+ * All necessary fields will be automatically configured by `z_impl_gpio_edge_init()`.
+ */
+typedef struct {
+    const struct gpio_dt_spec *gpio_dt;      /**< Pointer to GPIO device tree specification. */
+    struct gpio_callback gpio_cb;            /**< GPIO callback structure for interrupt handling. */
+    void (*edge_callback)(void);             /**< Callback function to execute in the ISR of the edge. */
+} gpio_edge_ctx_t;
+
+/**
+ * @brief Initialize GPIO edge detection without debounce.
+ *
+ * Unlike `z_impl_gpio_debounce_init()`, the callback is called straight from the
+ * GPIO ISR, so it must be ISR safe (e.g. give a semaphore). Use it for lines driven
+ * by another IC, like an interrupt output, which don't bounce.
+ *
+ * @param ctx               Pointer to an uninitialized edge context structure.
+ * @param gpio_dt           Pointer to GPIO device tree specification.
+ * @param gpio_flag         GPIO configuration flags (e.g., GPIO_INPUT).
+ * @param interrupt_flag    Edge to detect (e.g., GPIO_INT_EDGE_TO_INACTIVE).
+ * @param edge_callback     Function to call in the ISR of the edge.
+ *
+ * @return 0 if successful, or a negative error code on failure.
+ */
+int z_impl_gpio_edge_init(
+    gpio_edge_ctx_t *ctx,
+    const struct gpio_dt_spec *gpio_dt,
+    const gpio_flags_t gpio_flag,
+    const gpio_flags_t interrupt_flag,
+    void (*edge_callback)(void)
+);
+
+#ifdef __cplusplus
+}
+#endif
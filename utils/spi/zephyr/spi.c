@@ -6,6 +6,8 @@
 
 #include "spi.h"
 
+#include <string.h>
+
 int z_impl_spi_device_init(
 	const struct device *const spi
 )
@@ -79,6 +81,72 @@ int z_impl_spi_write(
     return 0;
 }
 
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+static struct z_impl_spi_transfer_stats _transfer_stats;
+#endif
+
+int z_impl_spi_transfer_submit(
+    const struct device *const spi, 
+    const struct spi_config *const spi_cfg, 
+    struct k_poll_signal *const spi_done_sig,
+    const struct spi_buf_set *const tx,
+    const struct spi_buf_set *const rx
+)
+{
+	// Reset signal
+	k_poll_signal_reset(spi_done_sig);
+
+	// Start transaction, the driver raises the signal from its completion callback
+	int error = spi_transceive_signal(spi, spi_cfg, tx, rx, spi_done_sig);
+	if(error != 0){
+		printk("SPI transceive error: %i\n", error);
+		return error;
+	}
+
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+	_transfer_stats.transfer_count++;
+	if(tx != NULL){
+		for(size_t i=0; i<tx->count; i++){
+			_transfer_stats.byte_count += tx->buffers[i].len;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+int z_impl_spi_transfer_wait(
+    struct k_poll_signal *const spi_done_sig,
+    const k_timeout_t timeout
+)
+{
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+	const uint32_t start = k_cycle_get_32();
+#endif
+
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL,
+		K_POLL_MODE_NOTIFY_ONLY,
+		spi_done_sig
+	);
+
+	// Sleep until the done signal is raised, other threads can run in the meantime
+	int error = k_poll(&event, 1, timeout);
+
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+	_transfer_stats.wait_cycles += k_cycle_get_32() - start;
+#endif
+
+	if(error != 0){
+		printk("SPI transceive timeout: %i\n", error);
+		return error;
+	}
+
+	int spi_signaled, spi_result;
+	k_poll_signal_check(spi_done_sig, &spi_signaled, &spi_result);
+	return spi_result;
+}
+
 int z_impl_spi_transfer(
     const struct device *const spi, 
     const struct spi_config *const spi_cfg, 
@@ -107,24 +175,28 @@ int z_impl_spi_transfer(
 		.count = 1
 	};
 
-	// Reset signal
-	k_poll_signal_reset(spi_done_sig);
-	
-	// Start transaction
-	int error = spi_transceive_signal(spi, spi_cfg, &tx, &rx, spi_done_sig);
+	int error = z_impl_spi_transfer_submit(spi, spi_cfg, spi_done_sig, &tx, &rx);
 	if(error != 0){
-		printk("SPI transceive error: %i\n", error);
 		return error;
 	}
 
-	// Wait for the done signal to be raised and log the rx buffer
-	int spi_signaled, spi_result;
-	do{
-		k_poll_signal_check(spi_done_sig, &spi_signaled, &spi_result);
-	} while(spi_signaled == 0);
+	return z_impl_spi_transfer_wait(spi_done_sig, K_FOREVER);
+}
 
-	return error;
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+void z_impl_spi_transfer_stats_get(
+    struct z_impl_spi_transfer_stats *const stats,
+    const bool reset
+)
+{
+	unsigned int key = irq_lock();
+	*stats = _transfer_stats;
+	if(reset){
+		memset(&_transfer_stats, 0, sizeof(_transfer_stats));
+	}
+	irq_unlock(key);
 }
+#endif
 
 int z_impl_spi_cs_select(
     const struct gpio_dt_spec *const cs, 
@@ -133,3 +205,16 @@ int z_impl_spi_cs_select(
 {
 	return gpio_pin_set_dt(cs, !value);
 }
+
+int z_impl_spi_release(
+    const struct device *const spi, 
+    const struct spi_config *const spi_cfg
+)
+{
+	int error = spi_release(spi, spi_cfg);
+	if(error != 0){
+		printk("SPI release error: %i\n", error);
+		return error;
+	}
+	return 0;
+}
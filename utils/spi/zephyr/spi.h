@@ -33,6 +33,40 @@ int z_impl_spi_write(
     const uint32_t buf_len
 );
 
+/**
+ * @brief Starts an asynchronous transaction and returns without waiting.
+ * 
+ * `spi_done_sig` is reset before the transaction starts and raised by the
+ * driver when it is completed. The buffers must stay valid until then.
+ * Use @ref z_impl_spi_transfer_wait or your own `k_poll` on the signal.
+ * 
+ * @return 0 if the transaction is started, negative errno otherwise.
+ */
+int z_impl_spi_transfer_submit(
+    const struct device *const spi, 
+    const struct spi_config *const spi_cfg, 
+    struct k_poll_signal *const spi_done_sig,
+    const struct spi_buf_set *const tx,
+    const struct spi_buf_set *const rx
+);
+
+/**
+ * @brief Sleeps on `k_poll` until the transaction started by
+ * @ref z_impl_spi_transfer_submit is completed.
+ * 
+ * The calling thread is pended instead of spinning, so threads with
+ * the same priority (BLE, command receiver) keep running.
+ * 
+ * @return The result reported by the driver, or -EAGAIN on timeout.
+ */
+int z_impl_spi_transfer_wait(
+    struct k_poll_signal *const spi_done_sig,
+    const k_timeout_t timeout
+);
+
+/**
+ * @brief Full duplex transfer of `buf_len` bytes, blocking until completed.
+ */
 int z_impl_spi_transfer(
     const struct device *const spi, 
     const struct spi_config *const spi_cfg, 
@@ -42,11 +76,43 @@ int z_impl_spi_transfer(
     const uint32_t buf_len
 );
 
+#ifdef CONFIG_UTILS_SPI_TRANSFER_STATS
+struct z_impl_spi_transfer_stats
+{
+    uint32_t transfer_count;    /**< Number of started transactions. */
+    uint32_t byte_count;        /**< Number of bytes clocked out. */
+    uint32_t wait_cycles;       /**< Hardware cycles spent sleeping in @ref z_impl_spi_transfer_wait, the CPU is free for other threads during it. */
+};
+
+/**
+ * @brief Copies the transfer statistics, optionally resetting them.
+ * 
+ * Wrap a workload (e.g. a full FIFO drain) with two calls and compare 
+ * `wait_cycles` with the elapsed cycles to get the CPU time given back.
+ */
+void z_impl_spi_transfer_stats_get(
+    struct z_impl_spi_transfer_stats *const stats,
+    const bool reset
+);
+#endif
+
 int z_impl_spi_cs_select(
     const struct gpio_dt_spec *const cs, 
     const bool value
 );
 
+/**
+ * @brief Ends a transaction opened with `SPI_HOLD_ON_CS`/`SPI_LOCK_ON`.
+ * 
+ * The controller deasserts the chip select kept by `SPI_HOLD_ON_CS` and
+ * the bus lock taken by `SPI_LOCK_ON` is dropped, so other SPI users can
+ * start their own transactions.
+ */
+int z_impl_spi_release(
+    const struct device *const spi, 
+    const struct spi_config *const spi_cfg
+);
+
 #ifdef __cplusplus
 }
 #endif
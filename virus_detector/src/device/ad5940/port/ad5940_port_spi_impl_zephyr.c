@@ -58,13 +58,31 @@ void AD5940_CsClr(void)
 
 void AD5940_ReadWriteNBytes(unsigned char *pSendBuffer, unsigned char *pRecvBuff, unsigned long length)
 {
-	z_impl_spi_transfer(
+	const struct spi_buf tx_spi_buf = {
+		.buf = pSendBuffer,
+		.len = length,
+	};
+	const struct spi_buf_set tx = {
+		.buffers = &tx_spi_buf,
+		.count = 1,
+	};
+	const struct spi_buf rx_spi_buf = {
+		.buf = pRecvBuff,
+		.len = length,
+	};
+	const struct spi_buf_set rx = {
+		.buffers = &rx_spi_buf,
+		.count = 1,
+	};
+
+	if(z_impl_spi_transfer_submit(
 		spi_1_device,
 		&spi_1_cfg, 
 		&spi_1_done_sig, 
-		pSendBuffer,
-		pRecvBuff,
-		length
-	);
+		&tx,
+		&rx
+	) != 0) return;
+	/* Sleep instead of spinning, BLE and command threads run while the bytes are clocked. */
+	z_impl_spi_transfer_wait(&spi_1_done_sig, K_FOREVER);
 	return;
 }